@@ -341,6 +341,8 @@ static void __syscall_return_slowpath(struct pt_regs *regs)
 
 	rseq_syscall(regs);
 
+	trace_error_syscall_exit(regs->ax, regs->orig_ax);
+
 	/*
 	 * First do one-time work.  If these work items are enabled, we
 	 * want to run them exactly once per syscall exit with IRQs on.
@@ -375,6 +377,7 @@ __visible noinstr void do_syscall_64(unsigned long nr, struct pt_regs *regs)
 	instrumentation_begin();
 
 	local_irq_enable();
+	trace_error_syscall_enter();
 	ti = current_thread_info();
 	if (READ_ONCE(ti->flags) & _TIF_WORK_SYSCALL_ENTRY)
 		nr = syscall_trace_enter(regs);
@@ -413,6 +416,8 @@ static void do_syscall_32_irqs_on(struct pt_regs *regs)
 	ti->status |= TS_COMPAT;
 #endif
 
+	trace_error_syscall_enter();
+
 	if (READ_ONCE(ti->flags) & _TIF_WORK_SYSCALL_ENTRY) {
 		/*
 		 * Subtlety here: if ptrace pokes something larger than
@@ -226,10 +226,10 @@ aoeblk_open(struct block_device *bdev, fmode_t mode)
 		pr_crit("aoe: invalid device pointer in %s\n",
 			__func__);
 		WARN_ON(1);
-		return -ENODEV;
+		return -ERR(ENODEV);
 	}
 	if (!(d->flags & DEVFL_UP) || d->flags & DEVFL_TKILL)
-		return -ENODEV;
+		return -ERR(ENODEV);
 
 	mutex_lock(&aoeblk_mutex);
 	spin_lock_irqsave(&d->lock, flags);
@@ -241,7 +241,7 @@ aoeblk_open(struct block_device *bdev, fmode_t mode)
 	}
 	spin_unlock_irqrestore(&d->lock, flags);
 	mutex_unlock(&aoeblk_mutex);
-	return -ENODEV;
+	return -ERR(ENODEV);
 }
 
 static void
@@ -288,7 +288,7 @@ aoeblk_getgeo(struct block_device *bdev, struct hd_geometry *geo)
 
 	if ((d->flags & DEVFL_UP) == 0) {
 		printk(KERN_ERR "aoe: disk not up\n");
-		return -ENODEV;
+		return -ERR(ENODEV);
 	}
 
 	geo->cylinders = d->geo.cylinders;
@@ -303,26 +303,26 @@ aoeblk_ioctl(struct block_device *bdev, fmode_t mode, uint cmd, ulong arg)
 	struct aoedev *d;
 
 	if (!arg)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	d = bdev->bd_disk->private_data;
 	if ((d->flags & DEVFL_UP) == 0) {
 		pr_err("aoe: disk not up\n");
-		return -ENODEV;
+		return -ERR(ENODEV);
 	}
 
 	if (cmd == HDIO_GET_IDENTITY) {
 		if (!copy_to_user((void __user *) arg, &d->ident,
 			sizeof(d->ident)))
 			return 0;
-		return -EFAULT;
+		return -ERR(EFAULT);
 	}
 
 	/* udev calls scsi_id, which uses SG_IO, resulting in noise */
 	if (cmd != SG_IO)
 		pr_info("aoe: unknown ioctl 0x%x\n", cmd);
 
-	return -ENOTTY;
+	return -ERR(ENOTTY);
 }
 
 static const struct block_device_operations aoe_bdops = {
@@ -462,7 +462,7 @@ aoeblk_init(void)
 					   sizeof(struct buf),
 					   0, 0, NULL);
 	if (buf_pool_cache == NULL)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	aoe_debugfs_dir = debugfs_create_dir("aoe", NULL);
 	return 0;
 }
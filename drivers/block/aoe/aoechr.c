@@ -71,7 +71,7 @@ interfaces(const char __user *str, size_t size)
 	if (set_aoe_iflist(str, size)) {
 		printk(KERN_ERR
 			"aoe: could not set interface list: too many interfaces\n");
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 	return 0;
 }
@@ -86,19 +86,19 @@ revalidate(const char __user *str, size_t size)
 	char buf[16];
 
 	if (size >= sizeof buf)
-		return -EINVAL;
+		return -ERR(EINVAL);
 	buf[sizeof buf - 1] = '\0';
 	if (copy_from_user(buf, str, size))
-		return -EFAULT;
+		return -ERR(EFAULT);
 
 	n = sscanf(buf, "e%d.%d", &major, &minor);
 	if (n != 2) {
 		pr_err("aoe: invalid device specification %s\n", buf);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 	d = aoedev_by_aoeaddr(major, minor, 0);
 	if (!d)
-		return -EINVAL;
+		return -ERR(EINVAL);
 	spin_lock_irqsave(&d->lock, flags);
 	aoecmd_cleanslate(d);
 	aoecmd_cfg(major, minor);
@@ -161,7 +161,7 @@ bail:		spin_unlock_irqrestore(&emsgs_lock, flags);
 static ssize_t
 aoechr_write(struct file *filp, const char __user *buf, size_t cnt, loff_t *offp)
 {
-	int ret = -EINVAL;
+	int ret = -ERR(EINVAL);
 
 	switch ((unsigned long) filp->private_data) {
 	default:
@@ -200,7 +200,7 @@ aoechr_open(struct inode *inode, struct file *filp)
 			return 0;
 		}
 	mutex_unlock(&aoechr_mutex);
-	return -EINVAL;
+	return -ERR(EINVAL);
 }
 
 static int
@@ -220,7 +220,7 @@ aoechr_read(struct file *filp, char __user *buf, size_t cnt, loff_t *off)
 
 	n = (unsigned long) filp->private_data;
 	if (n != MINOR_ERR)
-		return -EFAULT;
+		return -ERR(EFAULT);
 
 	spin_lock_irqsave(&emsgs_lock, flags);
 
@@ -230,7 +230,7 @@ aoechr_read(struct file *filp, char __user *buf, size_t cnt, loff_t *off)
 			break;
 		if (filp->f_flags & O_NDELAY) {
 			spin_unlock_irqrestore(&emsgs_lock, flags);
-			return -EAGAIN;
+			return -ERR(EAGAIN);
 		}
 		nblocked_emsgs_readers++;
 
@@ -244,12 +244,12 @@ aoechr_read(struct file *filp, char __user *buf, size_t cnt, loff_t *off)
 
 		if (n) {
 			spin_unlock_irqrestore(&emsgs_lock, flags);
-			return -ERESTARTSYS;
+			return -ERR(ERESTARTSYS);
 		}
 	}
 	if (em->len > cnt) {
 		spin_unlock_irqrestore(&emsgs_lock, flags);
-		return -EAGAIN;
+		return -ERR(EAGAIN);
 	}
 	mp = em->msg;
 	len = em->len;
@@ -263,7 +263,7 @@ aoechr_read(struct file *filp, char __user *buf, size_t cnt, loff_t *off)
 
 	n = copy_to_user(buf, mp, len);
 	kfree(mp);
-	return n == 0 ? len : -EFAULT;
+	return n == 0 ? len : -ERR(EFAULT);
 }
 
 static const struct file_operations aoe_fops = {
@@ -1267,7 +1267,7 @@ aoe_ktstart(struct ktstate *k)
 	init_completion(&k->rendez);
 	task = kthread_run(kthread, k, "%s", k->name);
 	if (task == NULL || IS_ERR(task))
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	k->task = task;
 	wait_for_completion(&k->rendez); /* allow kthread to start */
 	init_completion(&k->rendez);	/* for waiting for exit later */
@@ -1689,24 +1689,24 @@ aoecmd_init(void)
 	/* get_zeroed_page returns page with ref count 1 */
 	p = (void *) get_zeroed_page(GFP_KERNEL);
 	if (!p)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	empty_page = virt_to_page(p);
 
 	ncpus = num_online_cpus();
 
 	iocq = kcalloc(ncpus, sizeof(struct iocq_ktio), GFP_KERNEL);
 	if (!iocq)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	kts = kcalloc(ncpus, sizeof(struct ktstate), GFP_KERNEL);
 	if (!kts) {
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto kts_fail;
 	}
 
 	ktiowq = kcalloc(ncpus, sizeof(wait_queue_head_t), GFP_KERNEL);
 	if (!ktiowq) {
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto ktiowq_fail;
 	}
 
@@ -1725,7 +1725,7 @@ aoecmd_init(void)
 	}
 	kts[0].active = 1;
 	if (aoe_ktstart(&kts[0])) {
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto ktstart_fail;
 	}
 	return 0;
@@ -316,7 +316,7 @@ flush(const char __user *str, size_t cnt, int exiting)
 		if (cnt > sizeof buf)
 			cnt = sizeof buf;
 		if (copy_from_user(buf, str, cnt))
-			return -EFAULT;
+			return -ERR(EFAULT);
 		all = !strncmp(buf, "all", 3);
 		if (!all)
 			specified = 1;
@@ -99,11 +99,11 @@ int
 set_aoe_iflist(const char __user *user_str, size_t size)
 {
 	if (size >= IFLISTSZ)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	if (copy_from_user(aoe_iflist, user_str, size)) {
 		printk(KERN_INFO "aoe: copy from user failed\n");
-		return -EFAULT;
+		return -ERR(EFAULT);
 	}
 	aoe_iflist[size] = 0x00;
 	return 0;
@@ -208,7 +208,7 @@ aoenet_init(void)
 	kts.id = 0;
 	snprintf(kts.name, sizeof(kts.name), "aoe_tx%d", kts.id);
 	if (aoe_ktstart(&kts))
-		return -EAGAIN;
+		return -ERR(EAGAIN);
 	dev_add_pack(&aoe_pt);
 	return 0;
 }
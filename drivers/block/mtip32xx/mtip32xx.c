@@ -451,7 +451,7 @@ static int mtip_device_reset(struct driver_data *dd)
 		return 0;
 
 	if (mtip_hba_reset(dd) < 0)
-		rv = -EFAULT;
+		rv = -ERR(EFAULT);
 
 	mdelay(1);
 	mtip_init_port(dd->port);
@@ -923,10 +923,10 @@ static int mtip_quiesce_io(struct mtip_port *port, unsigned long timeout)
 	} while (time_before(jiffies, to));
 
 	blk_mq_unquiesce_queue(port->dd->queue);
-	return active ? -EBUSY : 0;
+	return active ? -ERR(EBUSY) : 0;
 err_fault:
 	blk_mq_unquiesce_queue(port->dd->queue);
-	return -EFAULT;
+	return -ERR(EFAULT);
 }
 
 struct mtip_int_cmd {
@@ -976,16 +976,16 @@ static int mtip_exec_internal_command(struct mtip_port *port,
 	/* Make sure the buffer is 8 byte aligned. This is asic specific. */
 	if (buffer & 0x00000007) {
 		dev_err(&dd->pdev->dev, "SG buffer is not 8 byte aligned\n");
-		return -EFAULT;
+		return -ERR(EFAULT);
 	}
 
 	if (mtip_check_surprise_removal(dd->pdev))
-		return -EFAULT;
+		return -ERR(EFAULT);
 
 	rq = blk_mq_alloc_request(dd->queue, REQ_OP_DRV_IN, BLK_MQ_REQ_RESERVED);
 	if (IS_ERR(rq)) {
 		dbg_printk(MTIP_DRV_NAME "Unable to allocate tag for PIO cmd\n");
-		return -EFAULT;
+		return -ERR(EFAULT);
 	}
 
 	set_bit(MTIP_PF_IC_ACTIVE_BIT, &port->flags);
@@ -1002,7 +1002,7 @@ static int mtip_exec_internal_command(struct mtip_port *port,
 			blk_mq_free_request(rq);
 			clear_bit(MTIP_PF_IC_ACTIVE_BIT, &port->flags);
 			wake_up_interruptible(&port->svc_wait);
-			return -EBUSY;
+			return -ERR(EBUSY);
 		}
 	}
 
@@ -1019,7 +1019,7 @@ static int mtip_exec_internal_command(struct mtip_port *port,
 	if (int_cmd->status) {
 		dev_err(&dd->pdev->dev, "Internal command [%02X] failed %d\n",
 				fis->command, int_cmd->status);
-		rv = -EIO;
+		rv = -ERR(EIO);
 
 		if (mtip_check_surprise_removal(dd->pdev) ||
 			test_bit(MTIP_DDF_REMOVE_PENDING_BIT,
@@ -1027,20 +1027,20 @@ static int mtip_exec_internal_command(struct mtip_port *port,
 			dev_err(&dd->pdev->dev,
 				"Internal command [%02X] wait returned due to SR\n",
 				fis->command);
-			rv = -ENXIO;
+			rv = -ERR(ENXIO);
 			goto exec_ic_exit;
 		}
 		mtip_device_reset(dd); /* recover from timeout issue */
-		rv = -EAGAIN;
+		rv = -ERR(EAGAIN);
 		goto exec_ic_exit;
 	}
 
 	if (readl(port->cmd_issue[MTIP_TAG_INDEX(MTIP_TAG_INTERNAL)])
 			& (1 << MTIP_TAG_BIT(MTIP_TAG_INTERNAL))) {
-		rv = -ENXIO;
+		rv = -ERR(ENXIO);
 		if (!test_bit(MTIP_DDF_REMOVE_PENDING_BIT, &dd->dd_flag)) {
 			mtip_device_reset(dd);
-			rv = -EAGAIN;
+			rv = -ERR(EAGAIN);
 		}
 	}
 exec_ic_exit:
@@ -1132,7 +1132,7 @@ static int mtip_get_identify(struct mtip_port *port, void __user *user_buffer)
 	struct host_to_dev_fis fis;
 
 	if (test_bit(MTIP_DDF_REMOVE_PENDING_BIT, &port->dd->dd_flag))
-		return -EFAULT;
+		return -ERR(EFAULT);
 
 	/* Build the FIS. */
 	memset(&fis, 0, sizeof(struct host_to_dev_fis));
@@ -1190,7 +1190,7 @@ static int mtip_get_identify(struct mtip_port *port, void __user *user_buffer)
 			user_buffer,
 			port->identify,
 			ATA_ID_WORDS * sizeof(u16))) {
-			rv = -EFAULT;
+			rv = -ERR(EFAULT);
 			goto out;
 		}
 	}
@@ -1330,19 +1330,19 @@ static int mtip_get_smart_attr(struct mtip_port *port, unsigned int id,
 	struct smart_attr *pattr;
 
 	if (!attrib)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	if (!port->identify_valid) {
 		dev_warn(&port->dd->pdev->dev, "IDENTIFY DATA not valid\n");
-		return -EPERM;
+		return -ERR(EPERM);
 	}
 	if (!(port->identify[82] & 0x1)) {
 		dev_warn(&port->dd->pdev->dev, "SMART not supported\n");
-		return -EPERM;
+		return -ERR(EPERM);
 	}
 	if (!(port->identify[85] & 0x1)) {
 		dev_warn(&port->dd->pdev->dev, "SMART not enabled\n");
-		return -EPERM;
+		return -ERR(EPERM);
 	}
 
 	memset(port->smart_buf, 0, ATA_SECT_SIZE);
@@ -1362,7 +1362,7 @@ static int mtip_get_smart_attr(struct mtip_port *port, unsigned int id,
 	if (i == 29) {
 		dev_warn(&port->dd->pdev->dev,
 			"Query for invalid SMART attribute ID\n");
-		rv = -EINVAL;
+		rv = -ERR(EINVAL);
 	}
 
 	return rv;
@@ -1565,7 +1565,7 @@ static int exec_drive_command(struct mtip_port *port, u8 *command,
 
 	if (xfer_sz) {
 		if (!user_buffer)
-			return -EFAULT;
+			return -ERR(EFAULT);
 
 		buf = dma_alloc_coherent(&port->dd->pdev->dev,
 				ATA_SECT_SIZE * xfer_sz,
@@ -1575,7 +1575,7 @@ static int exec_drive_command(struct mtip_port *port, u8 *command,
 			dev_err(&port->dd->pdev->dev,
 				"Memory allocation failed (%d bytes)\n",
 				ATA_SECT_SIZE * xfer_sz);
-			return -ENOMEM;
+			return -ERR(ENOMEM);
 		}
 	}
 
@@ -1617,7 +1617,7 @@ static int exec_drive_command(struct mtip_port *port, u8 *command,
 				 0,
 				 to)
 				 < 0) {
-		rv = -EFAULT;
+		rv = -ERR(EFAULT);
 		goto exit_drive_command;
 	}
 
@@ -1638,7 +1638,7 @@ static int exec_drive_command(struct mtip_port *port, u8 *command,
 		if (copy_to_user(user_buffer,
 				 buf,
 				 ATA_SECT_SIZE * command[3])) {
-			rv = -EFAULT;
+			rv = -ERR(EFAULT);
 			goto exit_drive_command;
 		}
 	}
@@ -1727,7 +1727,7 @@ static int exec_drive_taskfile(struct driver_data *dd,
 	taskin = req_task->in_size;
 	/* 130560 = 512 * 0xFF*/
 	if (taskin > 130560 || taskout > 130560)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	if (taskout) {
 		outbuf = memdup_user(buf + outtotal, taskout);
@@ -1737,7 +1737,7 @@ static int exec_drive_taskfile(struct driver_data *dd,
 		outbuf_dma = dma_map_single(&dd->pdev->dev, outbuf,
 					    taskout, DMA_TO_DEVICE);
 		if (dma_mapping_error(&dd->pdev->dev, outbuf_dma)) {
-			err = -ENOMEM;
+			err = -ERR(ENOMEM);
 			goto abort;
 		}
 		dma_buffer = outbuf_dma;
@@ -1753,7 +1753,7 @@ static int exec_drive_taskfile(struct driver_data *dd,
 		inbuf_dma = dma_map_single(&dd->pdev->dev, inbuf,
 					   taskin, DMA_FROM_DEVICE);
 		if (dma_mapping_error(&dd->pdev->dev, inbuf_dma)) {
-			err = -ENOMEM;
+			err = -ERR(ENOMEM);
 			goto abort;
 		}
 		dma_buffer = inbuf_dma;
@@ -1772,7 +1772,7 @@ static int exec_drive_taskfile(struct driver_data *dd,
 		reply = (dd->port->rxfis + RX_FIS_D2H_REG);
 		break;
 	default:
-		err = -EINVAL;
+		err = -ERR(EINVAL);
 		goto abort;
 	}
 
@@ -1814,7 +1814,7 @@ static int exec_drive_taskfile(struct driver_data *dd,
 				dev_warn(&dd->pdev->dev,
 					"data movement but "
 					"sect_count is 0\n");
-				err = -EINVAL;
+				err = -ERR(EINVAL);
 				goto abort;
 			}
 		}
@@ -1855,7 +1855,7 @@ static int exec_drive_taskfile(struct driver_data *dd,
 				 transfer_size,
 				 0,
 				 timeout) < 0) {
-		err = -EIO;
+		err = -ERR(EIO);
 		goto abort;
 	}
 
@@ -1910,13 +1910,13 @@ static int exec_drive_taskfile(struct driver_data *dd,
 
 	if (taskout) {
 		if (copy_to_user(buf + outtotal, outbuf, taskout)) {
-			err = -EFAULT;
+			err = -ERR(EFAULT);
 			goto abort;
 		}
 	}
 	if (taskin) {
 		if (copy_to_user(buf + intotal, inbuf, taskin)) {
-			err = -EFAULT;
+			err = -ERR(EFAULT);
 			goto abort;
 		}
 	}
@@ -1958,7 +1958,7 @@ static int mtip_hw_ioctl(struct driver_data *dd, unsigned int cmd,
 	{
 		if (copy_to_user((void __user *)arg, dd->port->identify,
 						sizeof(u16) * ATA_ID_WORDS))
-			return -EFAULT;
+			return -ERR(EFAULT);
 		break;
 	}
 	case HDIO_DRIVE_CMD:
@@ -1969,19 +1969,19 @@ static int mtip_hw_ioctl(struct driver_data *dd, unsigned int cmd,
 		if (copy_from_user(drive_command,
 					 (void __user *) arg,
 					 sizeof(drive_command)))
-			return -EFAULT;
+			return -ERR(EFAULT);
 
 		/* Execute the drive command. */
 		if (exec_drive_command(dd->port,
 					 drive_command,
 					 (void __user *) (arg+4)))
-			return -EIO;
+			return -ERR(EIO);
 
 		/* Copy the status back to the users buffer. */
 		if (copy_to_user((void __user *) arg,
 					 drive_command,
 					 sizeof(drive_command)))
-			return -EFAULT;
+			return -ERR(EFAULT);
 
 		break;
 	}
@@ -1993,17 +1993,17 @@ static int mtip_hw_ioctl(struct driver_data *dd, unsigned int cmd,
 		if (copy_from_user(drive_command,
 					 (void __user *) arg,
 					 sizeof(drive_command)))
-			return -EFAULT;
+			return -ERR(EFAULT);
 
 		/* Execute the drive command. */
 		if (exec_drive_task(dd->port, drive_command))
-			return -EIO;
+			return -ERR(EIO);
 
 		/* Copy the status back to the users buffer. */
 		if (copy_to_user((void __user *) arg,
 					 drive_command,
 					 sizeof(drive_command)))
-			return -EFAULT;
+			return -ERR(EFAULT);
 
 		break;
 	}
@@ -2013,7 +2013,7 @@ static int mtip_hw_ioctl(struct driver_data *dd, unsigned int cmd,
 
 		if (copy_from_user(&req_task, (void __user *) arg,
 					sizeof(req_task)))
-			return -EFAULT;
+			return -ERR(EFAULT);
 
 		outtotal = sizeof(req_task);
 
@@ -2022,13 +2022,13 @@ static int mtip_hw_ioctl(struct driver_data *dd, unsigned int cmd,
 
 		if (copy_to_user((void __user *) arg, &req_task,
 							sizeof(req_task)))
-			return -EFAULT;
+			return -ERR(EFAULT);
 
 		return ret;
 	}
 
 	default:
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 	return 0;
 }
@@ -2249,7 +2249,7 @@ static ssize_t mtip_hw_read_device_status(struct file *f, char __user *ubuf,
 	if (!buf) {
 		dev_err(&dd->pdev->dev,
 			"Memory allocation: status buffer\n");
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 
 	size += show_device_status(NULL, buf);
@@ -2257,7 +2257,7 @@ static ssize_t mtip_hw_read_device_status(struct file *f, char __user *ubuf,
 	*offset = size <= len ? size : len;
 	size = copy_to_user(ubuf, buf, *offset);
 	if (size)
-		rv = -EFAULT;
+		rv = -ERR(EFAULT);
 
 	kfree(buf);
 	return rv ? rv : *offset;
@@ -2279,7 +2279,7 @@ static ssize_t mtip_hw_read_registers(struct file *f, char __user *ubuf,
 	if (!buf) {
 		dev_err(&dd->pdev->dev,
 			"Memory allocation: register buffer\n");
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 
 	size += sprintf(&buf[size], "H/ S ACTive      : [ 0x");
@@ -2324,7 +2324,7 @@ static ssize_t mtip_hw_read_registers(struct file *f, char __user *ubuf,
 	*offset = size <= len ? size : len;
 	size = copy_to_user(ubuf, buf, *offset);
 	if (size)
-		rv = -EFAULT;
+		rv = -ERR(EFAULT);
 
 	kfree(buf);
 	return rv ? rv : *offset;
@@ -2345,7 +2345,7 @@ static ssize_t mtip_hw_read_flags(struct file *f, char __user *ubuf,
 	if (!buf) {
 		dev_err(&dd->pdev->dev,
 			"Memory allocation: flag buffer\n");
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 
 	size += sprintf(&buf[size], "Flag-port : [ %08lX ]\n",
@@ -2356,7 +2356,7 @@ static ssize_t mtip_hw_read_flags(struct file *f, char __user *ubuf,
 	*offset = size <= len ? size : len;
 	size = copy_to_user(ubuf, buf, *offset);
 	if (size)
-		rv = -EFAULT;
+		rv = -ERR(EFAULT);
 
 	kfree(buf);
 	return rv ? rv : *offset;
@@ -2396,7 +2396,7 @@ static const struct file_operations mtip_flags_fops = {
 static int mtip_hw_sysfs_init(struct driver_data *dd, struct kobject *kobj)
 {
 	if (!kobj || !dd)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	if (sysfs_create_file(kobj, &dev_attr_status.attr))
 		dev_warn(&dd->pdev->dev,
@@ -2417,7 +2417,7 @@ static int mtip_hw_sysfs_init(struct driver_data *dd, struct kobject *kobj)
 static int mtip_hw_sysfs_exit(struct driver_data *dd, struct kobject *kobj)
 {
 	if (!kobj || !dd)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	sysfs_remove_file(kobj, &dev_attr_status.attr);
 
@@ -2548,12 +2548,12 @@ static int mtip_ftl_rebuild_poll(struct driver_data *dd)
 	do {
 		if (unlikely(test_bit(MTIP_DDF_REMOVE_PENDING_BIT,
 				&dd->dd_flag)))
-			return -EFAULT;
+			return -ERR(EFAULT);
 		if (mtip_check_surprise_removal(dd->pdev))
-			return -EFAULT;
+			return -ERR(EFAULT);
 
 		if (mtip_get_identify(dd->port, NULL) < 0)
-			return -EFAULT;
+			return -ERR(EFAULT);
 
 		if (*(dd->port->identify + MTIP_FTL_REBUILD_OFFSET) ==
 			MTIP_FTL_REBUILD_MAGIC) {
@@ -2578,7 +2578,7 @@ static int mtip_ftl_rebuild_poll(struct driver_data *dd)
 	dev_err(&dd->pdev->dev,
 		"Timed out waiting for FTL rebuild to complete (%d secs).\n",
 		jiffies_to_msecs(jiffies - start) / 1000);
-	return -EFAULT;
+	return -ERR(EFAULT);
 }
 
 static void mtip_softirq_done_fn(struct request *rq)
@@ -2774,7 +2774,7 @@ static int mtip_dma_alloc(struct driver_data *dd)
 		dma_alloc_coherent(&dd->pdev->dev, BLOCK_DMA_ALLOC_SZ,
 					&port->block1_dma, GFP_KERNEL);
 	if (!port->block1)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	/* Allocate dma memory for command list */
 	port->command_list =
@@ -2785,7 +2785,7 @@ static int mtip_dma_alloc(struct driver_data *dd)
 					port->block1, port->block1_dma);
 		port->block1 = NULL;
 		port->block1_dma = 0;
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 
 	/* Setup all pointers into first DMA region */
@@ -2808,7 +2808,7 @@ static int mtip_hw_get_identify(struct driver_data *dd)
 	int rv;
 
 	if (mtip_get_identify(dd->port, NULL) < 0)
-		return -EFAULT;
+		return -ERR(EFAULT);
 
 	if (*(dd->port->identify + MTIP_FTL_REBUILD_OFFSET) ==
 		MTIP_FTL_REBUILD_MAGIC) {
@@ -2875,7 +2875,7 @@ static int mtip_hw_init(struct driver_data *dd)
 
 	mtip_detect_product(dd);
 	if (dd->product_type == MTIP_PRODUCT_UNKNOWN) {
-		rv = -EIO;
+		rv = -ERR(EIO);
 		goto out1;
 	}
 
@@ -2886,7 +2886,7 @@ static int mtip_hw_init(struct driver_data *dd)
 	if (!dd->port) {
 		dev_err(&dd->pdev->dev,
 			"Memory allocation: port structure\n");
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 
 	/* Continue workqueue setup */
@@ -2935,7 +2935,7 @@ static int mtip_hw_init(struct driver_data *dd)
 		dev_warn(&dd->pdev->dev,
 			"Surprise removal detected at %u ms\n",
 			jiffies_to_msecs(timetaken));
-		rv = -ENODEV;
+		rv = -ERR(ENODEV);
 		goto out2 ;
 	}
 	if (unlikely(test_bit(MTIP_DDF_REMOVE_PENDING_BIT, &dd->dd_flag))) {
@@ -2943,7 +2943,7 @@ static int mtip_hw_init(struct driver_data *dd)
 		dev_warn(&dd->pdev->dev,
 			"Removal detected at %u ms\n",
 			jiffies_to_msecs(timetaken));
-		rv = -EFAULT;
+		rv = -ERR(EFAULT);
 		goto out2;
 	}
 
@@ -2952,7 +2952,7 @@ static int mtip_hw_init(struct driver_data *dd)
 		if (mtip_hba_reset(dd) < 0) {
 			dev_err(&dd->pdev->dev,
 				"Card did not reset within timeout\n");
-			rv = -EIO;
+			rv = -ERR(EIO);
 			goto out2;
 		}
 	} else {
@@ -2981,7 +2981,7 @@ static int mtip_hw_init(struct driver_data *dd)
 	init_waitqueue_head(&dd->port->svc_wait);
 
 	if (test_bit(MTIP_DDF_REMOVE_PENDING_BIT, &dd->dd_flag)) {
-		rv = -EFAULT;
+		rv = -ERR(EFAULT);
 		goto out3;
 	}
 
@@ -3012,7 +3012,7 @@ static int mtip_standby_drive(struct driver_data *dd)
 	int rv = 0;
 
 	if (dd->sr || !dd->port)
-		return -ENODEV;
+		return -ERR(ENODEV);
 	/*
 	 * Send standby immediate (E0h) to the drive so that it
 	 * saves its state.
@@ -3105,7 +3105,7 @@ static int mtip_hw_suspend(struct driver_data *dd)
 	if (mtip_standby_drive(dd) != 0) {
 		dev_err(&dd->pdev->dev,
 			"Failed standby-immediate command\n");
-		return -EFAULT;
+		return -ERR(EFAULT);
 	}
 
 	/* Disable interrupts on the HBA.*/
@@ -3137,7 +3137,7 @@ static int mtip_hw_resume(struct driver_data *dd)
 	if (mtip_hba_reset(dd) != 0) {
 		dev_err(&dd->pdev->dev,
 			"Unable to reset the HBA\n");
-		return -EFAULT;
+		return -ERR(EFAULT);
 	}
 
 	/*
@@ -3174,7 +3174,7 @@ static int rssd_disk_name_format(char *prefix,
 	unit = base;
 	do {
 		if (p == begin)
-			return -EINVAL;
+			return -ERR(EINVAL);
 		*--p = 'a' + (index % unit);
 		index = (index / unit) - 1;
 	} while (index >= 0);
@@ -3206,17 +3206,17 @@ static int mtip_block_ioctl(struct block_device *dev,
 	struct driver_data *dd = dev->bd_disk->private_data;
 
 	if (!capable(CAP_SYS_ADMIN))
-		return -EACCES;
+		return -ERR(EACCES);
 
 	if (!dd)
-		return -ENOTTY;
+		return -ERR(ENOTTY);
 
 	if (unlikely(test_bit(MTIP_DDF_REMOVE_PENDING_BIT, &dd->dd_flag)))
-		return -ENOTTY;
+		return -ERR(ENOTTY);
 
 	switch (cmd) {
 	case BLKFLSBUF:
-		return -ENOTTY;
+		return -ERR(ENOTTY);
 	default:
 		return mtip_hw_ioctl(dd, cmd, arg);
 	}
@@ -3244,17 +3244,17 @@ static int mtip_block_compat_ioctl(struct block_device *dev,
 	struct driver_data *dd = dev->bd_disk->private_data;
 
 	if (!capable(CAP_SYS_ADMIN))
-		return -EACCES;
+		return -ERR(EACCES);
 
 	if (!dd)
-		return -ENOTTY;
+		return -ERR(ENOTTY);
 
 	if (unlikely(test_bit(MTIP_DDF_REMOVE_PENDING_BIT, &dd->dd_flag)))
-		return -ENOTTY;
+		return -ERR(ENOTTY);
 
 	switch (cmd) {
 	case BLKFLSBUF:
-		return -ENOTTY;
+		return -ERR(ENOTTY);
 	case HDIO_DRIVE_TASKFILE: {
 		struct mtip_compat_ide_task_request_s __user *compat_req_task;
 		ide_task_request_t req_task;
@@ -3268,13 +3268,13 @@ static int mtip_block_compat_ioctl(struct block_device *dev,
 
 		if (copy_from_user(&req_task, (void __user *) arg,
 			compat_tasksize - (2 * sizeof(compat_long_t))))
-			return -EFAULT;
+			return -ERR(EFAULT);
 
 		if (get_user(req_task.out_size, &compat_req_task->out_size))
-			return -EFAULT;
+			return -ERR(EFAULT);
 
 		if (get_user(req_task.in_size, &compat_req_task->in_size))
-			return -EFAULT;
+			return -ERR(EFAULT);
 
 		outtotal = sizeof(struct mtip_compat_ide_task_request_s);
 
@@ -3284,13 +3284,13 @@ static int mtip_block_compat_ioctl(struct block_device *dev,
 		if (copy_to_user((void __user *) arg, &req_task,
 				compat_tasksize -
 				(2 * sizeof(compat_long_t))))
-			return -EFAULT;
+			return -ERR(EFAULT);
 
 		if (put_user(req_task.out_size, &compat_req_task->out_size))
-			return -EFAULT;
+			return -ERR(EFAULT);
 
 		if (put_user(req_task.in_size, &compat_req_task->in_size))
-			return -EFAULT;
+			return -ERR(EFAULT);
 
 		return ret;
 	}
@@ -3325,12 +3325,12 @@ static int mtip_block_getgeo(struct block_device *dev,
 	sector_t capacity;
 
 	if (!dd)
-		return -ENOTTY;
+		return -ERR(ENOTTY);
 
 	if (!(mtip_hw_get_capacity(dd, &capacity))) {
 		dev_warn(&dd->pdev->dev,
 			"Could not get drive capacity.\n");
-		return -ENOTTY;
+		return -ERR(ENOTTY);
 	}
 
 	geo->heads = 224;
@@ -3350,12 +3350,12 @@ static int mtip_block_open(struct block_device *dev, fmode_t mode)
 		if (dd) {
 			if (test_bit(MTIP_DDF_REMOVAL_BIT,
 							&dd->dd_flag)) {
-				return -ENODEV;
+				return -ERR(ENODEV);
 			}
 			return 0;
 		}
 	}
-	return -ENODEV;
+	return -ERR(ENODEV);
 }
 
 static void mtip_block_release(struct gendisk *disk, fmode_t mode)
@@ -3524,7 +3524,7 @@ static int mtip_init_cmd(struct blk_mq_tag_set *set, struct request *rq,
 	cmd->command = dma_alloc_coherent(&dd->pdev->dev, CMD_DMA_ALLOC_SZ,
 			&cmd->command_dma, GFP_KERNEL);
 	if (!cmd->command)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	sg_init_table(cmd->sg, MTIP_MAX_SG);
 	return 0;
@@ -3584,7 +3584,7 @@ static int mtip_block_initialize(struct driver_data *dd)
 		goto skip_create_disk; /* hw init done, before rebuild */
 
 	if (mtip_hw_init(dd)) {
-		rv = -EINVAL;
+		rv = -ERR(EINVAL);
 		goto protocol_init_error;
 	}
 
@@ -3592,7 +3592,7 @@ static int mtip_block_initialize(struct driver_data *dd)
 	if (dd->disk  == NULL) {
 		dev_err(&dd->pdev->dev,
 			"Unable to allocate gendisk structure\n");
-		rv = -EINVAL;
+		rv = -ERR(EINVAL);
 		goto alloc_disk_error;
 	}
 
@@ -3640,7 +3640,7 @@ static int mtip_block_initialize(struct driver_data *dd)
 	if (IS_ERR(dd->queue)) {
 		dev_err(&dd->pdev->dev,
 			"Unable to allocate request queue\n");
-		rv = -ENOMEM;
+		rv = -ERR(ENOMEM);
 		goto block_queue_alloc_init_error;
 	}
 
@@ -3653,7 +3653,7 @@ static int mtip_block_initialize(struct driver_data *dd)
 	if (wait_for_rebuild < 0) {
 		dev_err(&dd->pdev->dev,
 			"Protocol layer initialization failed\n");
-		rv = -EINVAL;
+		rv = -ERR(EINVAL);
 		goto init_hw_cmds_error;
 	}
 
@@ -3678,7 +3678,7 @@ static int mtip_block_initialize(struct driver_data *dd)
 	if (!(mtip_hw_get_capacity(dd, &capacity))) {
 		dev_warn(&dd->pdev->dev,
 			"Could not read drive capacity\n");
-		rv = -EIO;
+		rv = -ERR(EIO);
 		goto read_capacity_error;
 	}
 	set_capacity(dd->disk, capacity);
@@ -3710,7 +3710,7 @@ static int mtip_block_initialize(struct driver_data *dd)
 	if (IS_ERR(dd->mtip_svc_handler)) {
 		dev_err(&dd->pdev->dev, "service thread failed to start\n");
 		dd->mtip_svc_handler = NULL;
-		rv = -EFAULT;
+		rv = -ERR(EFAULT);
 		goto kthread_run_error;
 	}
 	wake_up_process(dd->mtip_svc_handler);
@@ -4021,7 +4021,7 @@ static int mtip_pci_probe(struct pci_dev *pdev,
 	if (dd == NULL) {
 		dev_err(&pdev->dev,
 			"Unable to allocate memory for driver data\n");
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 
 	/* Attach the private data to this PCI device.  */
@@ -4061,7 +4061,7 @@ static int mtip_pci_probe(struct pci_dev *pdev,
 	dd->isr_workq = create_workqueue(dd->workq_name);
 	if (!dd->isr_workq) {
 		dev_warn(&pdev->dev, "Can't create wq %d\n", dd->instance);
-		rv = -ENOMEM;
+		rv = -ERR(ENOMEM);
 		goto setmask_err;
 	}
 
@@ -4254,7 +4254,7 @@ static int mtip_pci_suspend(struct pci_dev *pdev, pm_message_t mesg)
 	if (!dd) {
 		dev_err(&pdev->dev,
 			"Driver private datastructure is NULL\n");
-		return -EFAULT;
+		return -ERR(EFAULT);
 	}
 
 	set_bit(MTIP_DDF_RESUME_BIT, &dd->dd_flag);
@@ -4296,7 +4296,7 @@ static int mtip_pci_resume(struct pci_dev *pdev)
 	if (!dd) {
 		dev_err(&pdev->dev,
 			"Driver private datastructure is NULL\n");
-		return -EFAULT;
+		return -ERR(EFAULT);
 	}
 
 	/* Move the device to active State */
@@ -4392,7 +4392,7 @@ static int __init mtip_init(void)
 	if (error <= 0) {
 		pr_err("Unable to register block device (%d)\n",
 		error);
-		return -EBUSY;
+		return -ERR(EBUSY);
 	}
 	mtip_major = error;
 
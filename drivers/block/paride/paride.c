@@ -442,7 +442,7 @@ static int pi_probe(struct pardevice *par_dev)
 	int len = strlen(drv->name);
 
 	if (strncmp(par_dev->name, drv->name, len))
-		return -ENODEV;
+		return -ERR(ENODEV);
 
 	return 0;
 }
@@ -354,7 +354,7 @@ static int pcd_open(struct cdrom_device_info *cdi, int purpose)
 {
 	struct pcd_unit *cd = cdi->handle;
 	if (!cd->present)
-		return -ENODEV;
+		return -ERR(ENODEV);
 	return 0;
 }
 
@@ -944,7 +944,7 @@ static int pcd_audio_ioctl(struct cdrom_device_info *cdi, unsigned int cmd, void
 			tochdr->cdth_trk0 = buffer[2];
 			tochdr->cdth_trk1 = buffer[3];
 
-			return r ? -EIO : 0;
+			return r ? -ERR(EIO) : 0;
 		}
 
 	case CDROMREADTOCENTRY:
@@ -978,12 +978,12 @@ static int pcd_audio_ioctl(struct cdrom_device_info *cdi, unsigned int cmd, void
 				    (((((buffer[8] << 8) + buffer[9]) << 8)
 				      + buffer[10]) << 8) + buffer[11];
 
-			return r ? -EIO : 0;
+			return r ? -ERR(EIO) : 0;
 		}
 
 	default:
 
-		return -ENOSYS;
+		return -ERR(ENOSYS);
 	}
 }
 
@@ -994,7 +994,7 @@ static int pcd_get_mcn(struct cdrom_device_info *cdi, struct cdrom_mcn *mcn)
 	char buffer[32];
 
 	if (pcd_atapi(cdi->handle, cmd, 24, buffer, "get mcn"))
-		return -EIO;
+		return -ERR(EIO);
 
 	memcpy(mcn->medium_catalog_number, buffer + 9, 13);
 	mcn->medium_catalog_number[13] = 0;
@@ -1008,12 +1008,12 @@ static int __init pcd_init(void)
 	int unit;
 
 	if (disable)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	pcd_init_units();
 
 	if (pcd_detect())
-		return -ENODEV;
+		return -ERR(ENODEV);
 
 	/* get the atapi capabilities page */
 	pcd_probe_capabilities();
@@ -1027,7 +1027,7 @@ static int __init pcd_init(void)
 			blk_mq_free_tag_set(&cd->tag_set);
 			put_disk(cd->disk);
 		}
-		return -EBUSY;
+		return -ERR(EBUSY);
 	}
 
 	for (unit = 0, cd = pcd; unit < PCD_UNITS; unit++, cd++) {
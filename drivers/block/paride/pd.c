@@ -833,7 +833,7 @@ static int pd_ioctl(struct block_device *bdev, fmode_t mode,
 		mutex_unlock(&pd_mutex);
 		return 0;
 	default:
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 }
 
@@ -1017,7 +1017,7 @@ static int __init pd_init(void)
 out2:
 	unregister_blkdev(major, name);
 out1:
-	return -ENODEV;
+	return -ERR(ENODEV);
 }
 
 static void __exit pd_exit(void)
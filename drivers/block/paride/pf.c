@@ -334,11 +334,11 @@ static int pf_open(struct block_device *bdev, fmode_t mode)
 	mutex_lock(&pf_mutex);
 	pf_identify(pf);
 
-	ret = -ENODEV;
+	ret = -ERR(ENODEV);
 	if (pf->media_status == PF_NM)
 		goto out;
 
-	ret = -EROFS;
+	ret = -ERR(EROFS);
 	if ((pf->media_status == PF_RO) && (mode & FMODE_WRITE))
 		goto out;
 
@@ -374,10 +374,10 @@ static int pf_ioctl(struct block_device *bdev, fmode_t mode, unsigned int cmd, u
 	struct pf_unit *pf = bdev->bd_disk->private_data;
 
 	if (cmd != CDROMEJECT)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	if (pf->access != 1)
-		return -EBUSY;
+		return -ERR(EBUSY);
 	mutex_lock(&pf_mutex);
 	pf_eject(pf);
 	mutex_unlock(&pf_mutex);
@@ -1024,12 +1024,12 @@ static int __init pf_init(void)
 	int unit;
 
 	if (disable)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	pf_init_units();
 
 	if (pf_detect())
-		return -ENODEV;
+		return -ERR(ENODEV);
 	pf_busy = 0;
 
 	if (register_blkdev(major, name)) {
@@ -1040,7 +1040,7 @@ static int __init pf_init(void)
 			blk_mq_free_tag_set(&pf->tag_set);
 			put_disk(pf->disk);
 		}
-		return -EBUSY;
+		return -ERR(EBUSY);
 	}
 
 	for (pf = units, unit = 0; unit < PF_UNITS; pf++, unit++) {
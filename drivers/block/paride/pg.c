@@ -531,12 +531,12 @@ static int pg_open(struct inode *inode, struct file *file)
 
 	mutex_lock(&pg_mutex);
 	if ((unit >= PG_UNITS) || (!dev->present)) {
-		ret = -ENODEV;
+		ret = -ERR(ENODEV);
 		goto out;
 	}
 
 	if (test_and_set_bit(0, &dev->access)) {
-		ret = -EBUSY;
+		ret = -ERR(EBUSY);
 		goto out;
 	}
 
@@ -551,7 +551,7 @@ static int pg_open(struct inode *inode, struct file *file)
 	if (dev->bufptr == NULL) {
 		clear_bit(0, &dev->access);
 		printk("%s: buffer allocation failed\n", dev->name);
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto out;
 	}
 
@@ -580,44 +580,44 @@ static ssize_t pg_write(struct file *filp, const char __user *buf, size_t count,
 	int hs = sizeof (hdr);
 
 	if (dev->busy)
-		return -EBUSY;
+		return -ERR(EBUSY);
 	if (count < hs)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	if (copy_from_user(&hdr, buf, hs))
-		return -EFAULT;
+		return -ERR(EFAULT);
 
 	if (hdr.magic != PG_MAGIC)
-		return -EINVAL;
+		return -ERR(EINVAL);
 	if (hdr.dlen < 0 || hdr.dlen > PG_MAX_DATA)
-		return -EINVAL;
+		return -ERR(EINVAL);
 	if ((count - hs) > PG_MAX_DATA)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	if (hdr.func == PG_RESET) {
 		if (count != hs)
-			return -EINVAL;
+			return -ERR(EINVAL);
 		if (pg_reset(dev))
-			return -EIO;
+			return -ERR(EIO);
 		return count;
 	}
 
 	if (hdr.func != PG_COMMAND)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	dev->start = jiffies;
 	dev->timeout = hdr.timeout * HZ + HZ / 2 + jiffies;
 
 	if (pg_command(dev, hdr.packet, hdr.dlen, jiffies + PG_TMO)) {
 		if (dev->status & 0x10)
-			return -ETIME;
-		return -EIO;
+			return -ERR(ETIME);
+		return -ERR(EIO);
 	}
 
 	dev->busy = 1;
 
 	if (copy_from_user(dev->bufptr, buf + hs, count - hs))
-		return -EFAULT;
+		return -ERR(EFAULT);
 	return count;
 }
 
@@ -629,15 +629,15 @@ static ssize_t pg_read(struct file *filp, char __user *buf, size_t count, loff_t
 	int copy;
 
 	if (!dev->busy)
-		return -EINVAL;
+		return -ERR(EINVAL);
 	if (count < hs)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	dev->busy = 0;
 
 	if (pg_completion(dev, dev->bufptr, dev->timeout))
 		if (dev->status & 0x10)
-			return -ETIME;
+			return -ERR(ETIME);
 
 	memset(&hdr, 0, sizeof(hdr));
 	hdr.magic = PG_MAGIC;
@@ -655,10 +655,10 @@ static ssize_t pg_read(struct file *filp, char __user *buf, size_t count, loff_t
 	hdr.scsi = dev->status & 0x0f;
 
 	if (copy_to_user(buf, &hdr, hs))
-		return -EFAULT;
+		return -ERR(EFAULT);
 	if (copy > 0)
 		if (copy_to_user(buf + hs, dev->bufptr, copy))
-			return -EFAULT;
+			return -ERR(EFAULT);
 	return copy + hs;
 }
 
@@ -668,14 +668,14 @@ static int __init pg_init(void)
 	int err;
 
 	if (disable){
-		err = -EINVAL;
+		err = -ERR(EINVAL);
 		goto out;
 	}
 
 	pg_init_units();
 
 	if (pg_detect()) {
-		err = -ENODEV;
+		err = -ERR(ENODEV);
 		goto out;
 	}
 
@@ -665,27 +665,27 @@ static int pt_open(struct inode *inode, struct file *file)
 	mutex_lock(&pt_mutex);
 	if (unit >= PT_UNITS || (!tape->present)) {
 		mutex_unlock(&pt_mutex);
-		return -ENODEV;
+		return -ERR(ENODEV);
 	}
 
-	err = -EBUSY;
+	err = -ERR(EBUSY);
 	if (!atomic_dec_and_test(&tape->available))
 		goto out;
 
 	pt_identify(tape);
 
-	err = -ENODEV;
+	err = -ERR(ENODEV);
 	if (!(tape->flags & PT_MEDIA))
 		goto out;
 
-	err = -EROFS;
+	err = -ERR(EROFS);
 	if ((!(tape->flags & PT_WRITE_OK)) && (file->f_mode & FMODE_WRITE))
 		goto out;
 
 	if (!(iminor(inode) & 128))
 		tape->flags |= PT_REWIND;
 
-	err = -ENOMEM;
+	err = -ERR(ENOMEM);
 	tape->bufptr = kmalloc(PT_BUFSIZE, GFP_KERNEL);
 	if (tape->bufptr == NULL) {
 		printk("%s: buffer allocation failed\n", tape->name);
@@ -711,7 +711,7 @@ static long pt_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
 	switch (cmd) {
 	case MTIOCTOP:
 		if (copy_from_user(&mtop, p, sizeof(struct mtop)))
-			return -EFAULT;
+			return -ERR(EFAULT);
 
 		switch (mtop.mt_op) {
 
@@ -731,11 +731,11 @@ static long pt_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
 			/* FIXME: rate limit ?? */
 			printk(KERN_DEBUG "%s: Unimplemented mt_op %d\n", tape->name,
 			       mtop.mt_op);
-			return -EINVAL;
+			return -ERR(EINVAL);
 		}
 
 	default:
-		return -ENOTTY;
+		return -ERR(ENOTTY);
 	}
 }
 
@@ -745,7 +745,7 @@ pt_release(struct inode *inode, struct file *file)
 	struct pt_unit *tape = file->private_data;
 
 	if (atomic_read(&tape->available) > 1)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	if (tape->flags & PT_WRITING)
 		pt_write_fm(tape);
@@ -772,9 +772,9 @@ static ssize_t pt_read(struct file *filp, char __user *buf, size_t count, loff_t
 	if (!(tape->flags & (PT_READING | PT_WRITING))) {
 		tape->flags |= PT_READING;
 		if (pt_atapi(tape, rd_cmd, 0, NULL, "start read-ahead"))
-			return -EIO;
+			return -ERR(EIO);
 	} else if (tape->flags & PT_WRITING)
-		return -EIO;
+		return -ERR(EIO);
 
 	if (tape->flags & PT_EOF)
 		return 0;
@@ -784,7 +784,7 @@ static ssize_t pt_read(struct file *filp, char __user *buf, size_t count, loff_t
 	while (count > 0) {
 
 		if (!pt_poll_dsc(tape, HZ / 100, PT_TMO, "read"))
-			return -EIO;
+			return -ERR(EIO);
 
 		n = count;
 		if (n > 32768)
@@ -800,7 +800,7 @@ static ssize_t pt_read(struct file *filp, char __user *buf, size_t count, loff_t
 
 		if (r) {
 			pt_req_sense(tape, 0);
-			return -EIO;
+			return -ERR(EIO);
 		}
 
 		while (1) {
@@ -812,7 +812,7 @@ static ssize_t pt_read(struct file *filp, char __user *buf, size_t count, loff_t
 			if (r & STAT_SENSE) {
 				pi_disconnect(pi);
 				pt_req_sense(tape, 0);
-				return -EIO;
+				return -ERR(EIO);
 			}
 
 			if (r)
@@ -829,7 +829,7 @@ static ssize_t pt_read(struct file *filp, char __user *buf, size_t count, loff_t
 				pi_disconnect(pi);
 				printk("%s: Phase error on read: %d\n", tape->name,
 				       p);
-				return -EIO;
+				return -ERR(EIO);
 			}
 
 			while (n > 0) {
@@ -843,7 +843,7 @@ static ssize_t pt_read(struct file *filp, char __user *buf, size_t count, loff_t
 					b = count;
 				if (copy_to_user(buf + t, tape->bufptr, b)) {
 					pi_disconnect(pi);
-					return -EFAULT;
+					return -ERR(EFAULT);
 				}
 				t += b;
 				count -= b;
@@ -867,25 +867,25 @@ static ssize_t pt_write(struct file *filp, const char __user *buf, size_t count,
 	int k, n, r, p, s, t, b;
 
 	if (!(tape->flags & PT_WRITE_OK))
-		return -EROFS;
+		return -ERR(EROFS);
 
 	if (!(tape->flags & (PT_READING | PT_WRITING))) {
 		tape->flags |= PT_WRITING;
 		if (pt_atapi
 		    (tape, wr_cmd, 0, NULL, "start buffer-available mode"))
-			return -EIO;
+			return -ERR(EIO);
 	} else if (tape->flags & PT_READING)
-		return -EIO;
+		return -ERR(EIO);
 
 	if (tape->flags & PT_EOF)
-		return -ENOSPC;
+		return -ERR(ENOSPC);
 
 	t = 0;
 
 	while (count > 0) {
 
 		if (!pt_poll_dsc(tape, HZ / 100, PT_TMO, "write"))
-			return -EIO;
+			return -ERR(EIO);
 
 		n = count;
 		if (n > 32768)
@@ -901,7 +901,7 @@ static ssize_t pt_write(struct file *filp, const char __user *buf, size_t count,
 
 		if (r) {	/* error delivering command only */
 			pt_req_sense(tape, 0);
-			return -EIO;
+			return -ERR(EIO);
 		}
 
 		while (1) {
@@ -913,7 +913,7 @@ static ssize_t pt_write(struct file *filp, const char __user *buf, size_t count,
 			if (r & STAT_SENSE) {
 				pi_disconnect(pi);
 				pt_req_sense(tape, 0);
-				return -EIO;
+				return -ERR(EIO);
 			}
 
 			if (r)
@@ -930,7 +930,7 @@ static ssize_t pt_write(struct file *filp, const char __user *buf, size_t count,
 				pi_disconnect(pi);
 				printk("%s: Phase error on write: %d \n",
 				       tape->name, p);
-				return -EIO;
+				return -ERR(EIO);
 			}
 
 			while (n > 0) {
@@ -942,7 +942,7 @@ static ssize_t pt_write(struct file *filp, const char __user *buf, size_t count,
 					b = count;
 				if (copy_from_user(tape->bufptr, buf + t, b)) {
 					pi_disconnect(pi);
-					return -EFAULT;
+					return -ERR(EFAULT);
 				}
 				pi_write_block(pi, tape->bufptr, k);
 				t += b;
@@ -965,12 +965,12 @@ static int __init pt_init(void)
 	int err;
 
 	if (disable) {
-		err = -EINVAL;
+		err = -ERR(EINVAL);
 		goto out;
 	}
 
 	if (pt_detect()) {
-		err = -ENODEV;
+		err = -ERR(ENODEV);
 		goto out;
 	}
 
@@ -68,13 +68,13 @@ static int rnbd_clt_parse_map_options(const char *buf, size_t max_path_cnt,
 	substring_t args[MAX_OPT_ARGS];
 	int opt_mask = 0;
 	int token;
-	int ret = -EINVAL;
+	int ret = -ERR(EINVAL);
 	int i, dest_port;
 	int p_cnt = 0;
 
 	options = kstrdup(buf, GFP_KERNEL);
 	if (!options)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	sep_opt = strstrip(options);
 	while ((p = strsep(&sep_opt, " ")) != NULL) {
@@ -88,12 +88,12 @@ static int rnbd_clt_parse_map_options(const char *buf, size_t max_path_cnt,
 		case RNBD_OPT_SESSNAME:
 			p = match_strdup(args);
 			if (!p) {
-				ret = -ENOMEM;
+				ret = -ERR(ENOMEM);
 				goto out;
 			}
 			if (strlen(p) > NAME_MAX) {
 				pr_err("map_device: sessname too long\n");
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				kfree(p);
 				goto out;
 			}
@@ -105,12 +105,12 @@ static int rnbd_clt_parse_map_options(const char *buf, size_t max_path_cnt,
 			if (p_cnt >= max_path_cnt) {
 				pr_err("map_device: too many (> %zu) paths provided\n",
 				       max_path_cnt);
-				ret = -ENOMEM;
+				ret = -ERR(ENOMEM);
 				goto out;
 			}
 			p = match_strdup(args);
 			if (!p) {
-				ret = -ENOMEM;
+				ret = -ERR(ENOMEM);
 				goto out;
 			}
 
@@ -131,12 +131,12 @@ static int rnbd_clt_parse_map_options(const char *buf, size_t max_path_cnt,
 		case RNBD_OPT_DEV_PATH:
 			p = match_strdup(args);
 			if (!p) {
-				ret = -ENOMEM;
+				ret = -ERR(ENOMEM);
 				goto out;
 			}
 			if (strlen(p) > NAME_MAX) {
 				pr_err("map_device: Device path too long\n");
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				kfree(p);
 				goto out;
 			}
@@ -149,7 +149,7 @@ static int rnbd_clt_parse_map_options(const char *buf, size_t max_path_cnt,
 			    dest_port > 65535) {
 				pr_err("bad destination port number parameter '%d'\n",
 				       dest_port);
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out;
 			}
 			*opt->dest_port = dest_port;
@@ -158,7 +158,7 @@ static int rnbd_clt_parse_map_options(const char *buf, size_t max_path_cnt,
 		case RNBD_OPT_ACCESS_MODE:
 			p = match_strdup(args);
 			if (!p) {
-				ret = -ENOMEM;
+				ret = -ERR(ENOMEM);
 				goto out;
 			}
 
@@ -171,7 +171,7 @@ static int rnbd_clt_parse_map_options(const char *buf, size_t max_path_cnt,
 			} else {
 				pr_err("map_device: Invalid access_mode: '%s'\n",
 				       p);
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				kfree(p);
 				goto out;
 			}
@@ -182,7 +182,7 @@ static int rnbd_clt_parse_map_options(const char *buf, size_t max_path_cnt,
 		default:
 			pr_err("map_device: Unknown parameter or missing value '%s'\n",
 			       p);
-			ret = -EINVAL;
+			ret = -ERR(EINVAL);
 			goto out;
 		}
 	}
@@ -192,7 +192,7 @@ static int rnbd_clt_parse_map_options(const char *buf, size_t max_path_cnt,
 			ret = 0;
 		} else {
 			pr_err("map_device: Parameters missing\n");
-			ret = -EINVAL;
+			ret = -ERR(EINVAL);
 			break;
 		}
 	}
@@ -273,7 +273,7 @@ static ssize_t rnbd_clt_unmap_dev_store(struct kobject *kobj,
 
 	opt = kstrdup(buf, GFP_KERNEL);
 	if (!opt)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	options = strstrip(opt);
 	dev = container_of(kobj, struct rnbd_clt_dev, kobj);
@@ -285,7 +285,7 @@ static ssize_t rnbd_clt_unmap_dev_store(struct kobject *kobj,
 		rnbd_clt_err(dev,
 			      "unmap_device: Invalid value: %s\n",
 			      options);
-		err = -EINVAL;
+		err = -ERR(EINVAL);
 		goto out;
 	}
 
@@ -297,7 +297,7 @@ static ssize_t rnbd_clt_unmap_dev_store(struct kobject *kobj,
 	 * race with lockless rnbd_destroy_sessions().
 	 */
 	if (!try_module_get(THIS_MODULE)) {
-		err = -ENODEV;
+		err = -ERR(ENODEV);
 		goto out;
 	}
 	err = rnbd_clt_unmap_device(dev, force, &attr->attr);
@@ -376,7 +376,7 @@ static ssize_t rnbd_clt_remap_dev_store(struct kobject *kobj,
 
 	opt = kstrdup(buf, GFP_KERNEL);
 	if (!opt)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	options = strstrip(opt);
 	dev = container_of(kobj, struct rnbd_clt_dev, kobj);
@@ -384,7 +384,7 @@ static ssize_t rnbd_clt_remap_dev_store(struct kobject *kobj,
 		rnbd_clt_err(dev,
 			      "remap_device: Invalid value: %s\n",
 			      options);
-		err = -EINVAL;
+		err = -ERR(EINVAL);
 		goto out;
 	}
 	err = rnbd_clt_remap_device(dev);
@@ -479,7 +479,7 @@ static int rnbd_clt_get_path_name(struct rnbd_clt_dev *dev, char *buf,
 
 	ret = snprintf(buf, len, "%s", pathname);
 	if (ret >= len)
-		return -ENAMETOOLONG;
+		return -ERR(ENAMETOOLONG);
 
 	return 0;
 }
@@ -536,7 +536,7 @@ static ssize_t rnbd_clt_map_device_store(struct kobject *kobj,
 	opt.access_mode = &access_mode;
 	addrs = kcalloc(ARRAY_SIZE(paths) * 2, sizeof(*addrs), GFP_KERNEL);
 	if (!addrs)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	for (path_cnt = 0; path_cnt < ARRAY_SIZE(paths); path_cnt++) {
 		paths[path_cnt].src = &addrs[path_cnt * 2];
@@ -611,7 +611,7 @@ int rnbd_clt_create_sysfs_files(void)
 	}
 	rnbd_devs_kobj = kobject_create_and_add("devices", &rnbd_dev->kobj);
 	if (!rnbd_devs_kobj) {
-		err = -ENOMEM;
+		err = -ERR(ENOMEM);
 		goto dev_destroy;
 	}
 
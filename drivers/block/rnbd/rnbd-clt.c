@@ -75,7 +75,7 @@ static int rnbd_clt_set_dev_attr(struct rnbd_clt_dev *dev,
 	struct rnbd_clt_session *sess = dev->sess;
 
 	if (!rsp->logical_block_size)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	dev->device_id		    = le32_to_cpu(rsp->device_id);
 	dev->nsectors		    = le64_to_cpu(rsp->nsectors);
@@ -125,7 +125,7 @@ static int process_msg_open_rsp(struct rnbd_clt_dev *dev,
 	if (dev->dev_state == DEV_STATE_UNMAPPED) {
 		rnbd_clt_info(dev,
 			       "Ignoring Open-Response message from server for  unmapped device\n");
-		err = -ENOENT;
+		err = -ERR(ENOENT);
 		goto out;
 	}
 	if (dev->dev_state == DEV_STATE_MAPPED_DISCONNECTED) {
@@ -157,7 +157,7 @@ int rnbd_clt_resize_disk(struct rnbd_clt_dev *dev, size_t newsize)
 	mutex_lock(&dev->lock);
 	if (dev->dev_state != DEV_STATE_MAPPED) {
 		pr_err("Failed to set new size of the device, device is not opened\n");
-		ret = -ENOENT;
+		ret = -ERR(ENOENT);
 		goto out;
 	}
 	ret = rnbd_clt_change_capacity(dev, newsize);
@@ -481,7 +481,7 @@ static int send_msg_close(struct rnbd_clt_dev *dev, u32 device_id, bool wait)
 
 	iu = rnbd_get_iu(sess, RTRS_ADMIN_CON, RTRS_PERMIT_WAIT);
 	if (!iu)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	iu->buf = NULL;
 	iu->dev = dev;
@@ -562,12 +562,12 @@ static int send_msg_open(struct rnbd_clt_dev *dev, bool wait)
 
 	rsp = kzalloc(sizeof(*rsp), GFP_KERNEL);
 	if (!rsp)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	iu = rnbd_get_iu(sess, RTRS_ADMIN_CON, RTRS_PERMIT_WAIT);
 	if (!iu) {
 		kfree(rsp);
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 
 	iu->buf = rsp;
@@ -608,12 +608,12 @@ static int send_msg_sess_info(struct rnbd_clt_session *sess, bool wait)
 
 	rsp = kzalloc(sizeof(*rsp), GFP_KERNEL);
 	if (!rsp)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	iu = rnbd_get_iu(sess, RTRS_ADMIN_CON, RTRS_PERMIT_WAIT);
 	if (!iu) {
 		kfree(rsp);
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 
 	iu->buf = rsp;
@@ -631,7 +631,7 @@ static int send_msg_sess_info(struct rnbd_clt_session *sess, bool wait)
 		 * dead, last reference on session is put and caller is waiting
 		 * for RTRS to close everything.
 		 */
-		err = -ENODEV;
+		err = -ERR(ENODEV);
 		goto put_iu;
 	}
 	err = send_usr_msg(sess->rtrs, READ, iu,
@@ -796,7 +796,7 @@ static struct rnbd_clt_session *alloc_sess(const char *sessname)
 
 	sess = kzalloc_node(sizeof(*sess), GFP_KERNEL, NUMA_NO_NODE);
 	if (!sess)
-		return ERR_PTR(-ENOMEM);
+		return ERR_PTR(-ERR(ENOMEM));
 	strlcpy(sess->sessname, sessname, sizeof(sess->sessname));
 	atomic_set(&sess->busy, 0);
 	mutex_init(&sess->lock);
@@ -808,7 +808,7 @@ static struct rnbd_clt_session *alloc_sess(const char *sessname)
 
 	sess->cpu_queues = alloc_percpu(struct rnbd_cpu_qlist);
 	if (!sess->cpu_queues) {
-		err = -ENOMEM;
+		err = -ERR(ENOMEM);
 		goto err;
 	}
 	rnbd_init_cpu_qlists(sess->cpu_queues);
@@ -820,7 +820,7 @@ static struct rnbd_clt_session *alloc_sess(const char *sessname)
 	 */
 	sess->cpu_rr = alloc_percpu(int);
 	if (!sess->cpu_rr) {
-		err = -ENOMEM;
+		err = -ERR(ENOMEM);
 		goto err;
 	}
 	for_each_possible_cpu(cpu)
@@ -838,7 +838,7 @@ static int wait_for_rtrs_connection(struct rnbd_clt_session *sess)
 {
 	wait_event(sess->rtrs_waitq, sess->rtrs_ready);
 	if (IS_ERR_OR_NULL(sess->rtrs))
-		return -ECONNRESET;
+		return -ERR(ECONNRESET);
 
 	return 0;
 }
@@ -941,11 +941,11 @@ static int rnbd_client_open(struct block_device *block_device, fmode_t mode)
 	struct rnbd_clt_dev *dev = block_device->bd_disk->private_data;
 
 	if (dev->read_only && (mode & FMODE_WRITE))
-		return -EPERM;
+		return -ERR(EPERM);
 
 	if (dev->dev_state == DEV_STATE_UNMAPPED ||
 	    !rnbd_clt_get_dev(dev))
-		return -EIO;
+		return -ERR(EIO);
 
 	return 0;
 }
@@ -1200,7 +1200,7 @@ find_and_get_or_create_sess(const char *sessname,
 
 	sess = find_or_create_sess(sessname, &first);
 	if (sess == ERR_PTR(-ENOMEM))
-		return ERR_PTR(-ENOMEM);
+		return ERR_PTR(-ERR(ENOMEM));
 	else if (!first)
 		return sess;
 
@@ -1357,7 +1357,7 @@ static int rnbd_client_setup_device(struct rnbd_clt_session *sess,
 	dev->gd = alloc_disk_node(1 << RNBD_PART_BITS,	NUMA_NO_NODE);
 	if (!dev->gd) {
 		blk_cleanup_queue(dev->queue);
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 
 	rnbd_clt_setup_gen_disk(dev, idx);
@@ -1374,12 +1374,12 @@ static struct rnbd_clt_dev *init_dev(struct rnbd_clt_session *sess,
 
 	dev = kzalloc_node(sizeof(*dev), GFP_KERNEL, NUMA_NO_NODE);
 	if (!dev)
-		return ERR_PTR(-ENOMEM);
+		return ERR_PTR(-ERR(ENOMEM));
 
 	dev->hw_queues = kcalloc(nr_cpu_ids, sizeof(*dev->hw_queues),
 				 GFP_KERNEL);
 	if (!dev->hw_queues) {
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto out_alloc;
 	}
 
@@ -1487,7 +1487,7 @@ struct rnbd_clt_dev *rnbd_clt_map_device(const char *sessname,
 	int ret;
 
 	if (exists_devpath(pathname))
-		return ERR_PTR(-EEXIST);
+		return ERR_PTR(-ERR(EEXIST));
 
 	sess = find_and_get_or_create_sess(sessname, paths, path_cnt, port_nr);
 	if (IS_ERR(sess))
@@ -1501,7 +1501,7 @@ struct rnbd_clt_dev *rnbd_clt_map_device(const char *sessname,
 		goto put_sess;
 	}
 	if (insert_dev_if_not_exists_devpath(pathname, sess, dev)) {
-		ret = -EEXIST;
+		ret = -ERR(EEXIST);
 		goto put_dev;
 	}
 	ret = send_msg_open(dev, WAIT);
@@ -1579,7 +1579,7 @@ int rnbd_clt_unmap_device(struct rnbd_clt_dev *dev, bool force,
 	mutex_lock(&dev->lock);
 	if (dev->dev_state == DEV_STATE_UNMAPPED) {
 		rnbd_clt_info(dev, "Device is already being unmapped\n");
-		ret = -EALREADY;
+		ret = -ERR(EALREADY);
 		goto err;
 	}
 	refcount = refcount_read(&dev->refcount);
@@ -1587,7 +1587,7 @@ int rnbd_clt_unmap_device(struct rnbd_clt_dev *dev, bool force,
 		rnbd_clt_err(dev,
 			      "Closing device failed, device is in use, (%d device users)\n",
 			      refcount - 1);
-		ret = -EBUSY;
+		ret = -ERR(EBUSY);
 		goto err;
 	}
 	was_mapped = (dev->dev_state == DEV_STATE_MAPPED);
@@ -1624,11 +1624,11 @@ int rnbd_clt_remap_device(struct rnbd_clt_dev *dev)
 	if (dev->dev_state == DEV_STATE_MAPPED_DISCONNECTED)
 		err = 0;
 	else if (dev->dev_state == DEV_STATE_UNMAPPED)
-		err = -ENODEV;
+		err = -ERR(ENODEV);
 	else if (dev->dev_state == DEV_STATE_MAPPED)
-		err = -EALREADY;
+		err = -ERR(EALREADY);
 	else
-		err = -EBUSY;
+		err = -ERR(EBUSY);
 	mutex_unlock(&dev->lock);
 	if (!err) {
 		rnbd_clt_info(dev, "Remapping device.\n");
@@ -1705,7 +1705,7 @@ static int __init rnbd_client_init(void)
 	rnbd_client_major = register_blkdev(rnbd_client_major, "rnbd");
 	if (rnbd_client_major <= 0) {
 		pr_err("Failed to load module, block device registration failed\n");
-		return -EBUSY;
+		return -ERR(EBUSY);
 	}
 
 	err = rnbd_clt_create_sysfs_files();
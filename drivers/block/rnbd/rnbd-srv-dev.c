@@ -20,7 +20,7 @@ struct rnbd_dev *rnbd_dev_open(const char *path, fmode_t flags,
 
 	dev = kzalloc(sizeof(*dev), GFP_KERNEL);
 	if (!dev)
-		return ERR_PTR(-ENOMEM);
+		return ERR_PTR(-ERR(ENOMEM));
 
 	dev->blk_open_flags = flags;
 	dev->bdev = blkdev_get_by_path(path, flags, THIS_MODULE);
@@ -75,7 +75,7 @@ static struct bio *rnbd_bio_map_kern(void *data, struct bio_set *bs,
 
 	bio = bio_alloc_bioset(gfp_mask, nr_pages, bs);
 	if (!bio)
-		return ERR_PTR(-ENOMEM);
+		return ERR_PTR(-ERR(ENOMEM));
 
 	offset = offset_in_page(kaddr);
 	for (i = 0; i < nr_pages; i++) {
@@ -91,7 +91,7 @@ static struct bio *rnbd_bio_map_kern(void *data, struct bio_set *bs,
 				    offset) < bytes) {
 			/* we don't support partial mappings */
 			bio_put(bio);
-			return ERR_PTR(-EINVAL);
+			return ERR_PTR(-ERR(EINVAL));
 		}
 
 		data += bytes;
@@ -192,7 +192,7 @@ int rnbd_srv_create_sysfs_files(void)
 	}
 	rnbd_devs_kobj = kobject_create_and_add("devices", &rnbd_dev->kobj);
 	if (!rnbd_devs_kobj) {
-		err = -ENOMEM;
+		err = -ERR(ENOMEM);
 		goto dev_destroy;
 	}
 
@@ -34,7 +34,7 @@ static int dev_search_path_set(const char *val, const struct kernel_param *kp)
 	const char *p = strrchr(val, '\n') ? : val + strlen(val);
 
 	if (strlen(val) >= sizeof(dev_search_path))
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	snprintf(dev_search_path, sizeof(dev_search_path), "%.*s",
 		 (int)(p - val), val);
@@ -109,7 +109,7 @@ rnbd_get_sess_dev(int dev_id, struct rnbd_srv_session *srv_sess)
 	rcu_read_unlock();
 
 	if (!sess_dev || !ret)
-		return ERR_PTR(-ENXIO);
+		return ERR_PTR(-ERR(ENXIO));
 
 	return sess_dev;
 }
@@ -127,7 +127,7 @@ static int process_rdma(struct rtrs_srv *sess,
 
 	priv = kmalloc(sizeof(*priv), GFP_KERNEL);
 	if (!priv)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	dev_id = le32_to_cpu(msg->device_id);
 
@@ -135,7 +135,7 @@ static int process_rdma(struct rtrs_srv *sess,
 	if (IS_ERR(sess_dev)) {
 		pr_err_ratelimited("Got I/O request on session %s for unknown device id %d\n",
 				   srv_sess->sessname, dev_id);
-		err = -ENOTCONN;
+		err = -ERR(ENOTCONN);
 		goto err;
 	}
 
@@ -262,7 +262,7 @@ static int create_sess(struct rtrs_srv *rtrs)
 	}
 	srv_sess = kzalloc(sizeof(*srv_sess), GFP_KERNEL);
 	if (!srv_sess)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	srv_sess->queue_depth = rtrs_srv_get_queue_depth(rtrs);
 	err = bioset_init(&srv_sess->sess_bio_set, srv_sess->queue_depth,
@@ -301,7 +301,7 @@ static int rnbd_srv_link_ev(struct rtrs_srv *rtrs,
 
 	case RTRS_SRV_LINK_EV_DISCONNECTED:
 		if (WARN_ON_ONCE(!srv_sess))
-			return -EINVAL;
+			return -ERR(EINVAL);
 
 		destroy_sess(srv_sess);
 		return 0;
@@ -309,7 +309,7 @@ static int rnbd_srv_link_ev(struct rtrs_srv *rtrs,
 	default:
 		pr_warn("Received unknown RTRS session event %d from session %s\n",
 			ev, srv_sess->sessname);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 }
 
@@ -354,7 +354,7 @@ static int rnbd_srv_rdma_ev(struct rtrs_srv *rtrs, void *priv,
 	u16 type;
 
 	if (WARN_ON_ONCE(!srv_sess))
-		return -ENODEV;
+		return -ERR(ENODEV);
 
 	type = le16_to_cpu(hdr->type);
 
@@ -377,7 +377,7 @@ static int rnbd_srv_rdma_ev(struct rtrs_srv *rtrs, void *priv,
 	default:
 		pr_warn("Received unexpected message type %d with dir %d from session %s\n",
 			type, dir, srv_sess->sessname);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 
 	rtrs_srv_resp_rdma(id, ret);
@@ -392,7 +392,7 @@ static struct rnbd_srv_sess_dev
 
 	sess_dev = kzalloc(sizeof(*sess_dev), GFP_KERNEL);
 	if (!sess_dev)
-		return ERR_PTR(-ENOMEM);
+		return ERR_PTR(-ERR(ENOMEM));
 
 	error = xa_alloc(&srv_sess->index_idr, &sess_dev->device_id, sess_dev,
 			 xa_limit_32b, GFP_NOWAIT);
@@ -411,7 +411,7 @@ static struct rnbd_srv_dev *rnbd_srv_init_srv_dev(const char *id)
 
 	dev = kzalloc(sizeof(*dev), GFP_KERNEL);
 	if (!dev)
-		return ERR_PTR(-ENOMEM);
+		return ERR_PTR(-ERR(ENOMEM));
 
 	strlcpy(dev->id, id, sizeof(dev->id));
 	kref_init(&dev->kref);
@@ -449,7 +449,7 @@ static int rnbd_srv_check_update_open_perm(struct rnbd_srv_dev *srv_dev,
 					    struct rnbd_srv_session *srv_sess,
 					    enum rnbd_access_mode access_mode)
 {
-	int ret = -EPERM;
+	int ret = -ERR(EPERM);
 
 	mutex_lock(&srv_dev->lock);
 
@@ -482,7 +482,7 @@ static int rnbd_srv_check_update_open_perm(struct rnbd_srv_dev *srv_dev,
 	default:
 		pr_err("Received mapping request for device '%s' on session %s with invalid access mode: %d\n",
 		       srv_dev->id, srv_sess->sessname, access_mode);
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 	}
 
 	mutex_unlock(&srv_dev->lock);
@@ -579,7 +579,7 @@ static char *rnbd_srv_get_full_path(struct rnbd_srv_session *srv_sess,
 
 	full_path = kmalloc(PATH_MAX, GFP_KERNEL);
 	if (!full_path)
-		return ERR_PTR(-ENOMEM);
+		return ERR_PTR(-ERR(ENOMEM));
 
 	/*
 	 * Replace %SESSNAME% with a real session name in order to
@@ -595,7 +595,7 @@ static char *rnbd_srv_get_full_path(struct rnbd_srv_session *srv_sess,
 			pr_err("Too long path: %s, %s, %s\n",
 			       dev_search_path, srv_sess->sessname, dev_name);
 			kfree(full_path);
-			return ERR_PTR(-EINVAL);
+			return ERR_PTR(-ERR(EINVAL));
 		}
 	} else {
 		snprintf(full_path, PATH_MAX, "%s/%s",
@@ -694,13 +694,13 @@ static int process_msg_open(struct rtrs_srv *rtrs,
 		pr_err("Opening device for session %s failed, device path too long. '%s/%s' is longer than PATH_MAX (%d)\n",
 		       srv_sess->sessname, dev_search_path, open_msg->dev_name,
 		       PATH_MAX);
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto reject;
 	}
 	if (strstr(open_msg->dev_name, "..")) {
 		pr_err("Opening device for session %s failed, device path %s contains relative path ..\n",
 		       srv_sess->sessname, open_msg->dev_name);
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto reject;
 	}
 	full_path = rnbd_srv_get_full_path(srv_sess, open_msg->dev_name);
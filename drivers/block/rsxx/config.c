@@ -92,7 +92,7 @@ static int rsxx_save_config(struct rsxx_cardinfo *card)
 		dev_err(CARD_TO_DEV(card),
 			"Cannot save config with invalid version %d\n",
 			cfg.hdr.version);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 
 	/* Convert data to little endian for the CRC calculation. */
@@ -147,7 +147,7 @@ int rsxx_load_config(struct rsxx_cardinfo *card)
 			dev_info(CARD_TO_DEV(card),
 				"CRC (sb x%08x is x%08x)\n",
 				card->config.hdr.crc, crc);
-			return -EIO;
+			return -ERR(EIO);
 		}
 
 		/* Convert the data to CPU byteorder */
@@ -161,7 +161,7 @@ int rsxx_load_config(struct rsxx_cardinfo *card)
 		 * Config version changes require special handling from the
 		 * user
 		 */
-		return -EINVAL;
+		return -ERR(EINVAL);
 	} else {
 		dev_info(CARD_TO_DEV(card),
 			"Initializing card configuration.\n");
@@ -169,7 +169,7 @@ static ssize_t rsxx_cram_read(struct file *fp, char __user *ubuf,
 
 	buf = kzalloc(cnt, GFP_KERNEL);
 	if (!buf)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	st = rsxx_creg_read(card, CREG_ADD_CRAM + (u32)*ppos, cnt, buf, 1);
 	if (!st)
@@ -510,7 +510,7 @@ static int card_shutdown(struct rsxx_cardinfo *card)
 		 (jiffies - start < timeout));
 
 	if (state == CARD_STATE_STARTING)
-		return -ETIMEDOUT;
+		return -ERR(ETIMEDOUT);
 
 	/* Only issue a shutdown if we need to */
 	if ((state != CARD_STATE_SHUTTING_DOWN) &&
@@ -529,7 +529,7 @@ static int card_shutdown(struct rsxx_cardinfo *card)
 		 (jiffies - start < timeout));
 
 	if (state != CARD_STATE_SHUTDOWN)
-		return -ETIMEDOUT;
+		return -ERR(ETIMEDOUT);
 
 	return 0;
 }
@@ -752,7 +752,7 @@ static int rsxx_pci_probe(struct pci_dev *dev,
 
 	card = kzalloc(sizeof(*card), GFP_KERNEL);
 	if (!card)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	card->dev = dev;
 	pci_set_drvdata(dev, card);
@@ -784,14 +784,14 @@ static int rsxx_pci_probe(struct pci_dev *dev,
 
 	if (pci_resource_len(dev, 0) == 0) {
 		dev_err(CARD_TO_DEV(card), "BAR0 has length 0!\n");
-		st = -ENOMEM;
+		st = -ERR(ENOMEM);
 		goto failed_iomap;
 	}
 
 	card->regmap = pci_iomap(dev, 0, 0);
 	if (!card->regmap) {
 		dev_err(CARD_TO_DEV(card), "Failed to map BAR0\n");
-		st = -ENOMEM;
+		st = -ERR(ENOMEM);
 		goto failed_iomap;
 	}
 
@@ -833,7 +833,7 @@ static int rsxx_pci_probe(struct pci_dev *dev,
 	if (st) {
 		dev_warn(CARD_TO_DEV(card),
 			"Incompatible driver detected. Please update the driver.\n");
-		st = -EINVAL;
+		st = -ERR(EINVAL);
 		goto failed_compatiblity_check;
 	}
 
@@ -852,7 +852,7 @@ static int rsxx_pci_probe(struct pci_dev *dev,
 	card->ctrl = kcalloc(card->n_targets, sizeof(*card->ctrl),
 			     GFP_KERNEL);
 	if (!card->ctrl) {
-		st = -ENOMEM;
+		st = -ERR(ENOMEM);
 		goto failed_dma_setup;
 	}
 
@@ -1033,7 +1033,7 @@ static void rsxx_pci_remove(struct pci_dev *dev)
 static int rsxx_pci_suspend(struct pci_dev *dev, pm_message_t state)
 {
 	/* We don't support suspend at this time. */
-	return -ENOSYS;
+	return -ERR(ENOSYS);
 }
 
 static void rsxx_pci_shutdown(struct pci_dev *dev)
@@ -53,7 +53,7 @@ static int copy_to_creg_data(struct rsxx_cardinfo *card,
 	u32 *data = buf;
 
 	if (unlikely(card->eeh_state))
-		return -EIO;
+		return -ERR(EIO);
 
 	for (i = 0; cnt8 > 0; i++, cnt8 -= 4) {
 		/*
@@ -79,7 +79,7 @@ static int copy_from_creg_data(struct rsxx_cardinfo *card,
 	u32 *data = buf;
 
 	if (unlikely(card->eeh_state))
-		return -EIO;
+		return -ERR(EIO);
 
 	for (i = 0; cnt8 > 0; i++, cnt8 -= 4) {
 		/*
@@ -157,17 +157,17 @@ static int creg_queue_cmd(struct rsxx_cardinfo *card,
 
 	/* Don't queue stuff up if we're halted. */
 	if (unlikely(card->halt))
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	if (card->creg_ctrl.reset)
-		return -EAGAIN;
+		return -ERR(EAGAIN);
 
 	if (cnt8 > MAX_CREG_DATA8)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	cmd = kmem_cache_alloc(creg_cmd_pool, GFP_KERNEL);
 	if (!cmd)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	INIT_LIST_HEAD(&cmd->list);
 
@@ -256,10 +256,10 @@ static void creg_cmd_done(struct work_struct *work)
 		 * do anything else that could mess up the system and let
 		 * the sync function return an error.
 		 */
-		st = -EIO;
+		st = -ERR(EIO);
 		goto creg_done;
 	} else if (cmd->status & CREG_STAT_ERROR) {
-		st = -EIO;
+		st = -ERR(EIO);
 	}
 
 	if (cmd->op == CREG_OP_READ) {
@@ -269,13 +269,13 @@ static void creg_cmd_done(struct work_struct *work)
 		if (!cmd->buf) {
 			dev_err(CARD_TO_DEV(card),
 				"Buffer not given for read.\n");
-			st = -EIO;
+			st = -ERR(EIO);
 			goto creg_done;
 		}
 		if (cnt8 != cmd->cnt8) {
 			dev_err(CARD_TO_DEV(card),
 				"count mismatch\n");
-			st = -EIO;
+			st = -ERR(EIO);
 			goto creg_done;
 		}
 
@@ -411,7 +411,7 @@ static int __issue_creg_rw(struct rsxx_cardinfo *card,
 		dev_crit(CARD_TO_DEV(card),
 			"cregs timer failed\n");
 		creg_reset(card);
-		return -EIO;
+		return -ERR(EIO);
 	}
 
 	*hw_stat = completion.creg_status;
@@ -669,10 +669,10 @@ int rsxx_reg_access(struct rsxx_cardinfo *card,
 
 	st = copy_from_user(&cmd, ucmd, sizeof(cmd));
 	if (st)
-		return -EFAULT;
+		return -ERR(EFAULT);
 
 	if (cmd.cnt > RSXX_MAX_REG_CNT)
-		return -EFAULT;
+		return -ERR(EFAULT);
 
 	st = issue_reg_cmd(card, &cmd, read);
 	if (st)
@@ -680,12 +680,12 @@ int rsxx_reg_access(struct rsxx_cardinfo *card,
 
 	st = put_user(cmd.stat, &ucmd->stat);
 	if (st)
-		return -EFAULT;
+		return -ERR(EFAULT);
 
 	if (read) {
 		st = copy_to_user(ucmd->data, cmd.data, cmd.cnt);
 		if (st)
-			return -EFAULT;
+			return -ERR(EFAULT);
 	}
 
 	return 0;
@@ -725,7 +725,7 @@ int rsxx_creg_setup(struct rsxx_cardinfo *card)
 	card->creg_ctrl.creg_wq =
 			create_singlethread_workqueue(DRIVER_NAME"_creg");
 	if (!card->creg_ctrl.creg_wq)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	INIT_WORK(&card->creg_ctrl.done_work, creg_cmd_done);
 	mutex_init(&card->creg_ctrl.reset_lock);
@@ -778,7 +778,7 @@ int rsxx_creg_init(void)
 {
 	creg_cmd_pool = KMEM_CACHE(creg_cmd, SLAB_HWCACHE_ALIGN);
 	if (!creg_cmd_pool)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	return 0;
 }
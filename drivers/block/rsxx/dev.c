@@ -65,7 +65,7 @@ static int rsxx_blkdev_ioctl(struct block_device *bdev,
 		return rsxx_reg_access(card, (void __user *)arg, 0);
 	}
 
-	return -ENOTTY;
+	return -ERR(ENOTTY);
 }
 
 static int rsxx_getgeo(struct block_device *bdev, struct hd_geometry *geo)
@@ -230,14 +230,14 @@ int rsxx_setup_dev(struct rsxx_cardinfo *card)
 	card->major = register_blkdev(0, DRIVER_NAME);
 	if (card->major < 0) {
 		dev_err(CARD_TO_DEV(card), "Failed to get major number\n");
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 
 	card->queue = blk_alloc_queue(rsxx_make_request, NUMA_NO_NODE);
 	if (!card->queue) {
 		dev_err(CARD_TO_DEV(card), "Failed queue alloc\n");
 		unregister_blkdev(card->major, DRIVER_NAME);
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 
 	card->gendisk = alloc_disk(blkdev_minors);
@@ -245,7 +245,7 @@ int rsxx_setup_dev(struct rsxx_cardinfo *card)
 		dev_err(CARD_TO_DEV(card), "Failed disk alloc\n");
 		blk_cleanup_queue(card->queue);
 		unregister_blkdev(card->major, DRIVER_NAME);
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 
 	if (card->config_valid) {
@@ -297,7 +297,7 @@ int rsxx_dev_init(void)
 {
 	bio_meta_pool = KMEM_CACHE(rsxx_bio_meta, SLAB_HWCACHE_ALIGN);
 	if (!bio_meta_pool)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	return 0;
 }
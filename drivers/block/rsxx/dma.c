@@ -767,7 +767,7 @@ int rsxx_hw_buffers_init(struct pci_dev *dev, struct rsxx_dma_ctrl *ctrl)
 	ctrl->cmd.buf = dma_alloc_coherent(&dev->dev, COMMAND_BUFFER_SIZE8,
 				&ctrl->cmd.dma_addr, GFP_KERNEL);
 	if (ctrl->status.buf == NULL || ctrl->cmd.buf == NULL)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	memset(ctrl->status.buf, 0xac, STATUS_BUFFER_SIZE8);
 	iowrite32(lower_32_bits(ctrl->status.dma_addr),
@@ -783,7 +783,7 @@ int rsxx_hw_buffers_init(struct pci_dev *dev, struct rsxx_dma_ctrl *ctrl)
 	if (ctrl->status.idx > RSXX_MAX_OUTSTANDING_CMDS) {
 		dev_crit(&dev->dev, "Failed reading status cnt x%x\n",
 			ctrl->status.idx);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 	iowrite32(ctrl->status.idx, ctrl->regmap + HW_STATUS_CNT);
 	iowrite32(ctrl->status.idx, ctrl->regmap + SW_STATUS_CNT);
@@ -792,7 +792,7 @@ int rsxx_hw_buffers_init(struct pci_dev *dev, struct rsxx_dma_ctrl *ctrl)
 	if (ctrl->cmd.idx > RSXX_MAX_OUTSTANDING_CMDS) {
 		dev_crit(&dev->dev, "Failed reading cmd cnt x%x\n",
 			ctrl->status.idx);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 	iowrite32(ctrl->cmd.idx, ctrl->regmap + HW_CMD_IDX);
 	iowrite32(ctrl->cmd.idx, ctrl->regmap + SW_CMD_IDX);
@@ -810,7 +810,7 @@ static int rsxx_dma_ctrl_init(struct pci_dev *dev,
 
 	ctrl->trackers = vmalloc(DMA_TRACKER_LIST_SIZE8);
 	if (!ctrl->trackers)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	ctrl->trackers->head = 0;
 	for (i = 0; i < RSXX_MAX_OUTSTANDING_CMDS; i++) {
@@ -828,11 +828,11 @@ static int rsxx_dma_ctrl_init(struct pci_dev *dev,
 
 	ctrl->issue_wq = alloc_ordered_workqueue(DRIVER_NAME"_issue", 0);
 	if (!ctrl->issue_wq)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	ctrl->done_wq = alloc_ordered_workqueue(DRIVER_NAME"_done", 0);
 	if (!ctrl->done_wq)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	INIT_WORK(&ctrl->issue_dma_work, rsxx_schedule_issue);
 	INIT_WORK(&ctrl->dma_done_work, rsxx_schedule_done);
@@ -850,7 +850,7 @@ static int rsxx_dma_stripe_setup(struct rsxx_cardinfo *card,
 	if (!is_power_of_2(stripe_size8)) {
 		dev_err(CARD_TO_DEV(card),
 			"stripe_size is NOT a power of 2!\n");
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 
 	card->_stripe.lower_mask = stripe_size8 - 1;
@@ -1027,7 +1027,7 @@ int rsxx_eeh_save_issued_dmas(struct rsxx_cardinfo *card)
 	issued_dmas = kcalloc(card->n_targets, sizeof(*issued_dmas),
 			      GFP_KERNEL);
 	if (!issued_dmas)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	for (i = 0; i < card->n_targets; i++) {
 		INIT_LIST_HEAD(&issued_dmas[i]);
@@ -1075,7 +1075,7 @@ int rsxx_dma_init(void)
 {
 	rsxx_dma_pool = KMEM_CACHE(rsxx_dma, SLAB_HWCACHE_ALIGN);
 	if (!rsxx_dma_pool)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	return 0;
 }
@@ -236,7 +236,7 @@ static int add_persistent_gnt(struct xen_blkif_ring *ring,
 	if (ring->persistent_gnt_c >= max_pgrants) {
 		if (!blkif->vbd.overflow_max_grants)
 			blkif->vbd.overflow_max_grants = 1;
-		return -EBUSY;
+		return -ERR(EBUSY);
 	}
 	/* Figure out where to put new node */
 	new = &ring->persistent_gnts.rb_node;
@@ -250,7 +250,7 @@ static int add_persistent_gnt(struct xen_blkif_ring *ring,
 			new = &((*new)->rb_right);
 		else {
 			pr_alert_ratelimited("trying to add a gref that's already in the tree\n");
-			return -EINVAL;
+			return -ERR(EINVAL);
 		}
 	}
 
@@ -504,7 +504,7 @@ static int xen_vbd_translate(struct phys_req *req, struct xen_blkif *blkif,
 			     int operation)
 {
 	struct xen_vbd *vbd = &blkif->vbd;
-	int rc = -EACCES;
+	int rc = -ERR(EACCES);
 
 	if ((operation != REQ_OP_READ) && vbd->readonly)
 		goto out;
@@ -938,7 +938,7 @@ static int xen_blkbk_map(struct xen_blkif_ring *ring,
 	put_free_pages(ring, pages_to_gnt, segs_to_map);
 	for (i = last_map; i < num; i++)
 		pages[i]->handle = BLKBACK_INVALID_HANDLE;
-	return -ENOMEM;
+	return -ERR(ENOMEM);
 }
 
 static int xen_blkbk_map_seg(struct pending_req *pending_req)
@@ -989,7 +989,7 @@ static int xen_blkbk_parse_indirect(struct blkif_request *req,
 		first_sect = READ_ONCE(segments[i].first_sect);
 		last_sect = READ_ONCE(segments[i].last_sect);
 		if (last_sect >= (XEN_PAGE_SIZE >> 9) || last_sect < first_sect) {
-			rc = -EINVAL;
+			rc = -ERR(EINVAL);
 			goto unmap;
 		}
 
@@ -1055,7 +1055,7 @@ static int dispatch_other_io(struct xen_blkif_ring *ring,
 	free_req(ring, pending_req);
 	make_response(ring, req->u.other.id, req->operation,
 		      BLKIF_RSP_EOPNOTSUPP);
-	return -EIO;
+	return -ERR(EIO);
 }
 
 static void xen_blk_drain_io(struct xen_blkif_ring *ring)
@@ -1137,7 +1137,7 @@ __do_block_io_op(struct xen_blkif_ring *ring)
 		rc = blk_rings->common.rsp_prod_pvt;
 		pr_warn("Frontend provided bogus ring requests (%d - %d = %d). Halting ring processing on dev=%04x\n",
 			rp, rc, rp - rc, ring->blkif->vbd.pdevice);
-		return -EACCES;
+		return -ERR(EACCES);
 	}
 	while (rc != rp) {
 
@@ -1421,7 +1421,7 @@ static int dispatch_rw_block_io(struct xen_blkif_ring *ring,
 	make_response(ring, req->u.rw.id, req_operation, BLKIF_RSP_ERROR);
 	free_req(ring, pending_req);
 	msleep(1); /* back off a bit */
-	return -EIO;
+	return -ERR(EIO);
 
  fail_put_bio:
 	for (i = 0; i < nbio; i++)
@@ -1429,7 +1429,7 @@ static int dispatch_rw_block_io(struct xen_blkif_ring *ring,
 	atomic_set(&pending_req->pendcnt, 1);
 	__end_block_io_op(pending_req, BLK_STS_RESOURCE);
 	msleep(1); /* back off a bit */
-	return -EIO;
+	return -ERR(EIO);
 }
 
 
@@ -1481,7 +1481,7 @@ static int __init xen_blkif_init(void)
 	int rc = 0;
 
 	if (!xen_domain())
-		return -ENODEV;
+		return -ERR(ENODEV);
 
 	if (xen_blkif_max_ring_order > XENBUS_MAX_RING_GRANT_ORDER) {
 		pr_info("Invalid max_ring_order (%d), will use default max: %d.\n",
@@ -134,7 +134,7 @@ static int xen_blkif_alloc_rings(struct xen_blkif *blkif)
 	blkif->rings = kcalloc(blkif->nr_rings, sizeof(struct xen_blkif_ring),
 			       GFP_KERNEL);
 	if (!blkif->rings)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	for (r = 0; r < blkif->nr_rings; r++) {
 		struct xen_blkif_ring *ring = &blkif->rings[r];
@@ -166,7 +166,7 @@ static struct xen_blkif *xen_blkif_alloc(domid_t domid)
 
 	blkif = kmem_cache_zalloc(xen_blkif_cachep, GFP_KERNEL);
 	if (!blkif)
-		return ERR_PTR(-ENOMEM);
+		return ERR_PTR(-ERR(ENOMEM));
 
 	blkif->domid = domid;
 	atomic_set(&blkif->refcnt, 1);
@@ -242,7 +242,7 @@ static int xen_blkif_map(struct xen_blkif_ring *ring, grant_ref_t *gref,
 		BUG();
 	}
 
-	err = -EIO;
+	err = -ERR(EIO);
 	if (req_prod - rsp_prod > size)
 		goto fail;
 
@@ -325,7 +325,7 @@ static int xen_blkif_disconnect(struct xen_blkif *blkif)
 		ring->active = false;
 	}
 	if (busy)
-		return -EBUSY;
+		return -ERR(EBUSY);
 
 	blkif->nr_ring_pages = 0;
 	/*
@@ -357,7 +357,7 @@ int __init xen_blkif_interface_init(void)
 					     sizeof(struct xen_blkif),
 					     0, 0, NULL);
 	if (!xen_blkif_cachep)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	return 0;
 }
@@ -495,7 +495,7 @@ static int xen_vbd_create(struct xen_blkif *blkif, blkif_vdev_t handle,
 	if (IS_ERR(bdev)) {
 		pr_warn("xen_vbd_create: device %08x could not be opened\n",
 			vbd->pdevice);
-		return -ENOENT;
+		return -ERR(ENOENT);
 	}
 
 	vbd->bdev = bdev;
@@ -503,7 +503,7 @@ static int xen_vbd_create(struct xen_blkif *blkif, blkif_vdev_t handle,
 		pr_warn("xen_vbd_create: device %08x doesn't exist\n",
 			vbd->pdevice);
 		xen_vbd_free(vbd);
-		return -ENOENT;
+		return -ERR(ENOENT);
 	}
 	vbd->size = vbd_sz(vbd);
 
@@ -640,7 +640,7 @@ static int xen_blkbk_probe(struct xenbus_device *dev,
 	if (!be) {
 		xenbus_dev_fatal(dev, -ENOMEM,
 				 "allocating backend structure");
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 	be->dev = dev;
 	dev_set_drvdata(&dev->dev, be);
@@ -975,7 +975,7 @@ static int read_per_ring_refs(struct xen_blkif_ring *ring, const char *dir)
 	err = xenbus_scanf(XBT_NIL, dir, "event-channel", "%u",
 			  &evtchn);
 	if (err != 1) {
-		err = -EINVAL;
+		err = -ERR(EINVAL);
 		xenbus_dev_fatal(dev, err, "reading %s/event-channel", dir);
 		return err;
 	}
@@ -984,7 +984,7 @@ static int read_per_ring_refs(struct xen_blkif_ring *ring, const char *dir)
 
 	if (unlikely(!nr_grefs)) {
 		WARN_ON(true);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 
 	for (i = 0; i < nr_grefs; i++) {
@@ -998,7 +998,7 @@ static int read_per_ring_refs(struct xen_blkif_ring *ring, const char *dir)
 			if (nr_grefs == 1)
 				break;
 
-			err = -EINVAL;
+			err = -ERR(EINVAL);
 			xenbus_dev_fatal(dev, err, "reading %s/%s",
 					 dir, ring_ref_name);
 			return err;
@@ -1011,13 +1011,13 @@ static int read_per_ring_refs(struct xen_blkif_ring *ring, const char *dir)
 		err = xenbus_scanf(XBT_NIL, dir, "ring-ref", "%u",
 				   &ring_ref[0]);
 		if (err != 1) {
-			err = -EINVAL;
+			err = -ERR(EINVAL);
 			xenbus_dev_fatal(dev, err, "reading %s/ring-ref", dir);
 			return err;
 		}
 	}
 
-	err = -ENOMEM;
+	err = -ERR(ENOMEM);
 	for (i = 0; i < nr_grefs * XEN_BLKIF_REQS_PER_PAGE; i++) {
 		req = kzalloc(sizeof(*req), GFP_KERNEL);
 		if (!req)
@@ -1091,7 +1091,7 @@ static int connect_ring(struct backend_info *be)
 		blkif->blk_protocol = BLKIF_PROTOCOL_X86_64;
 	else {
 		xenbus_dev_fatal(dev, err, "unknown fe protocol %s", protocol);
-		return -ENOSYS;
+		return -ERR(ENOSYS);
 	}
 	pers_grants = xenbus_read_unsigned(dev->otherend, "feature-persistent",
 					   0);
@@ -1110,11 +1110,11 @@ static int connect_ring(struct backend_info *be)
 		xenbus_dev_fatal(dev, err,
 				"guest requested %u queues, exceeding the maximum of %u.",
 				requested_num_queues, xenblk_max_queues);
-		return -ENOSYS;
+		return -ERR(ENOSYS);
 	}
 	blkif->nr_rings = requested_num_queues;
 	if (xen_blkif_alloc_rings(blkif))
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	pr_info("%s: using %d queues, protocol %d (%s) %s\n", dev->nodename,
 		 blkif->nr_rings, blkif->blk_protocol, protocol,
@@ -1124,7 +1124,7 @@ static int connect_ring(struct backend_info *be)
 					       "ring-page-order", 0);
 
 	if (ring_page_order > xen_blkif_max_ring_order) {
-		err = -EINVAL;
+		err = -ERR(EINVAL);
 		xenbus_dev_fatal(dev, err,
 				 "requested ring page order %d exceed max:%d",
 				 ring_page_order,
@@ -1141,7 +1141,7 @@ static int connect_ring(struct backend_info *be)
 		xspath = kmalloc(xspathsize, GFP_KERNEL);
 		if (!xspath) {
 			xenbus_dev_fatal(dev, -ENOMEM, "reading ring references");
-			return -ENOMEM;
+			return -ERR(ENOMEM);
 		}
 
 		for (i = 0; i < blkif->nr_rings; i++) {
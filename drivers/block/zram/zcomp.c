@@ -54,7 +54,7 @@ static int zcomp_strm_init(struct zcomp_strm *zstrm, struct zcomp *comp)
 	zstrm->buffer = (void *)__get_free_pages(GFP_KERNEL | __GFP_ZERO, 1);
 	if (IS_ERR_OR_NULL(zstrm->tfm) || !zstrm->buffer) {
 		zcomp_strm_free(zstrm);
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 	return 0;
 }
@@ -183,7 +183,7 @@ static int zcomp_init(struct zcomp *comp)
 
 	comp->stream = alloc_percpu(struct zcomp_strm);
 	if (!comp->stream)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	ret = cpuhp_state_add_instance(CPUHP_ZCOMP_PREPARE, &comp->node);
 	if (ret < 0)
@@ -216,11 +216,11 @@ struct zcomp *zcomp_create(const char *compress)
 	int error;
 
 	if (!zcomp_available_algorithm(compress))
-		return ERR_PTR(-EINVAL);
+		return ERR_PTR(-ERR(EINVAL));
 
 	comp = kzalloc(sizeof(struct zcomp), GFP_KERNEL);
 	if (!comp)
-		return ERR_PTR(-ENOMEM);
+		return ERR_PTR(-ERR(ENOMEM));
 
 	comp->name = compress;
 	error = zcomp_init(comp);
@@ -258,7 +258,7 @@ static ssize_t mem_limit_store(struct device *dev,
 
 	limit = memparse(buf, &tmp);
 	if (buf == tmp) /* no chars parsed, invalid input */
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	down_write(&zram->init_lock);
 	zram->limit_pages = PAGE_ALIGN(limit) >> PAGE_SHIFT;
@@ -276,7 +276,7 @@ static ssize_t mem_used_max_store(struct device *dev,
 
 	err = kstrtoul(buf, 10, &val);
 	if (err || val != 0)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	down_read(&zram->init_lock);
 	if (init_done(zram)) {
@@ -296,12 +296,12 @@ static ssize_t idle_store(struct device *dev,
 	int index;
 
 	if (!sysfs_streq(buf, "all"))
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	down_read(&zram->init_lock);
 	if (!init_done(zram)) {
 		up_read(&zram->init_lock);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 
 	for (index = 0; index < nr_pages; index++) {
@@ -327,7 +327,7 @@ static ssize_t writeback_limit_enable_store(struct device *dev,
 {
 	struct zram *zram = dev_to_zram(dev);
 	u64 val;
-	ssize_t ret = -EINVAL;
+	ssize_t ret = -ERR(EINVAL);
 
 	if (kstrtoull(buf, 10, &val))
 		return ret;
@@ -362,7 +362,7 @@ static ssize_t writeback_limit_store(struct device *dev,
 {
 	struct zram *zram = dev_to_zram(dev);
 	u64 val;
-	ssize_t ret = -EINVAL;
+	ssize_t ret = -ERR(EINVAL);
 
 	if (kstrtoull(buf, 10, &val))
 		return ret;
@@ -460,12 +460,12 @@ static ssize_t backing_dev_store(struct device *dev,
 
 	file_name = kmalloc(PATH_MAX, GFP_KERNEL);
 	if (!file_name)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	down_write(&zram->init_lock);
 	if (init_done(zram)) {
 		pr_info("Can't setup backing device for initialized device\n");
-		err = -EBUSY;
+		err = -ERR(EBUSY);
 		goto out;
 	}
 
@@ -487,7 +487,7 @@ static ssize_t backing_dev_store(struct device *dev,
 
 	/* Support only block device in this moment */
 	if (!S_ISBLK(inode->i_mode)) {
-		err = -ENOTBLK;
+		err = -ERR(ENOTBLK);
 		goto out;
 	}
 
@@ -502,7 +502,7 @@ static ssize_t backing_dev_store(struct device *dev,
 	bitmap_sz = BITS_TO_LONGS(nr_pages) * sizeof(long);
 	bitmap = kvzalloc(bitmap_sz, GFP_KERNEL);
 	if (!bitmap) {
-		err = -ENOMEM;
+		err = -ERR(ENOMEM);
 		goto out;
 	}
 
@@ -597,13 +597,13 @@ static int read_from_bdev_async(struct zram *zram, struct bio_vec *bvec,
 
 	bio = bio_alloc(GFP_ATOMIC, 1);
 	if (!bio)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	bio->bi_iter.bi_sector = entry * (PAGE_SIZE >> 9);
 	bio_set_dev(bio, zram->bdev);
 	if (!bio_add_page(bio, bvec->bv_page, bvec->bv_len, bvec->bv_offset)) {
 		bio_put(bio);
-		return -EIO;
+		return -ERR(EIO);
 	}
 
 	if (!parent) {
@@ -639,22 +639,22 @@ static ssize_t writeback_store(struct device *dev,
 	else if (sysfs_streq(buf, "huge"))
 		mode = HUGE_WRITEBACK;
 	else
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	down_read(&zram->init_lock);
 	if (!init_done(zram)) {
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto release_init_lock;
 	}
 
 	if (!zram->backing_dev) {
-		ret = -ENODEV;
+		ret = -ERR(ENODEV);
 		goto release_init_lock;
 	}
 
 	page = alloc_page(GFP_KERNEL);
 	if (!page) {
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto release_init_lock;
 	}
 
@@ -668,7 +668,7 @@ static ssize_t writeback_store(struct device *dev,
 		spin_lock(&zram->wb_limit_lock);
 		if (zram->wb_limit_enable && !zram->bd_wb_limit) {
 			spin_unlock(&zram->wb_limit_lock);
-			ret = -EIO;
+			ret = -ERR(EIO);
 			break;
 		}
 		spin_unlock(&zram->wb_limit_lock);
@@ -676,7 +676,7 @@ static ssize_t writeback_store(struct device *dev,
 		if (!blk_idx) {
 			blk_idx = alloc_block_bdev(zram);
 			if (!blk_idx) {
-				ret = -ENOSPC;
+				ret = -ERR(ENOSPC);
 				break;
 			}
 		}
@@ -819,7 +819,7 @@ static int read_from_bdev_sync(struct zram *zram, struct bio_vec *bvec,
 				unsigned long entry, struct bio *bio)
 {
 	WARN_ON(1);
-	return -EIO;
+	return -ERR(EIO);
 }
 #endif
 
@@ -837,7 +837,7 @@ static inline void reset_bdev(struct zram *zram) {};
 static int read_from_bdev(struct zram *zram, struct bio_vec *bvec,
 			unsigned long entry, struct bio *parent, bool sync)
 {
-	return -EIO;
+	return -ERR(EIO);
 }
 
 static void free_block_bdev(struct zram *zram, unsigned long blk_idx) {};
@@ -874,13 +874,13 @@ static ssize_t read_block_state(struct file *file, char __user *buf,
 
 	kbuf = kvmalloc(count, GFP_KERNEL);
 	if (!kbuf)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	down_read(&zram->init_lock);
 	if (!init_done(zram)) {
 		up_read(&zram->init_lock);
 		kvfree(kbuf);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 
 	for (index = *ppos; index < nr_pages; index++) {
@@ -913,7 +913,7 @@ static ssize_t read_block_state(struct file *file, char __user *buf,
 
 	up_read(&zram->init_lock);
 	if (copy_to_user(buf, kbuf, written))
-		written = -EFAULT;
+		written = -ERR(EFAULT);
 	kvfree(kbuf);
 
 	return written;
@@ -999,13 +999,13 @@ static ssize_t comp_algorithm_store(struct device *dev,
 		compressor[sz - 1] = 0x00;
 
 	if (!zcomp_available_algorithm(compressor))
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	down_write(&zram->init_lock);
 	if (init_done(zram)) {
 		up_write(&zram->init_lock);
 		pr_info("Can't change algorithm for initialized device\n");
-		return -EBUSY;
+		return -ERR(EBUSY);
 	}
 
 	strcpy(zram->compressor, compressor);
@@ -1021,7 +1021,7 @@ static ssize_t compact_store(struct device *dev,
 	down_read(&zram->init_lock);
 	if (!init_done(zram)) {
 		up_read(&zram->init_lock);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 
 	zs_compact(zram->mem_pool);
@@ -1285,7 +1285,7 @@ static int zram_bvec_read(struct zram *zram, struct bio_vec *bvec,
 		/* Use a temporary buffer to decompress the page */
 		page = alloc_page(GFP_NOIO|__GFP_HIGHMEM);
 		if (!page)
-			return -ENOMEM;
+			return -ERR(ENOMEM);
 	}
 
 	ret = __zram_bvec_read(zram, page, index, bio, is_partial_io(bvec));
@@ -1372,7 +1372,7 @@ static int __zram_bvec_write(struct zram *zram, struct bio_vec *bvec,
 				__GFP_MOVABLE);
 		if (handle)
 			goto compress_again;
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 
 	alloced_pages = zs_get_total_pages(zram->mem_pool);
@@ -1381,7 +1381,7 @@ static int __zram_bvec_write(struct zram *zram, struct bio_vec *bvec,
 	if (zram->limit_pages && alloced_pages > zram->limit_pages) {
 		zcomp_stream_put(zram->comp);
 		zs_free(zram->mem_pool, handle);
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 
 	dst = zs_map_object(zram->mem_pool, handle, ZS_MM_WO);
@@ -1440,7 +1440,7 @@ static int zram_bvec_write(struct zram *zram, struct bio_vec *bvec,
 		 */
 		page = alloc_page(GFP_NOIO|__GFP_HIGHMEM);
 		if (!page)
-			return -ENOMEM;
+			return -ERR(ENOMEM);
 
 		ret = __zram_bvec_read(zram, page, index, bio, true);
 		if (ret)
@@ -1629,12 +1629,12 @@ static int zram_rw_page(struct block_device *bdev, sector_t sector,
 	unsigned long start_time;
 
 	if (PageTransHuge(page))
-		return -ENOTSUPP;
+		return -ERR(ENOTSUPP);
 	zram = bdev->bd_disk->private_data;
 
 	if (!valid_io_request(zram, sector, PAGE_SIZE)) {
 		atomic64_inc(&zram->stats.invalid_io);
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto out;
 	}
 
@@ -1712,18 +1712,18 @@ static ssize_t disksize_store(struct device *dev,
 
 	disksize = memparse(buf, NULL);
 	if (!disksize)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	down_write(&zram->init_lock);
 	if (init_done(zram)) {
 		pr_info("Cannot change disksize for initialized device\n");
-		err = -EBUSY;
+		err = -ERR(EBUSY);
 		goto out_unlock;
 	}
 
 	disksize = PAGE_ALIGN(disksize);
 	if (!zram_meta_alloc(zram, disksize)) {
-		err = -ENOMEM;
+		err = -ERR(ENOMEM);
 		goto out_unlock;
 	}
 
@@ -1764,19 +1764,19 @@ static ssize_t reset_store(struct device *dev,
 		return ret;
 
 	if (!do_reset)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	zram = dev_to_zram(dev);
 	bdev = bdget_disk(zram->disk, 0);
 	if (!bdev)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	mutex_lock(&bdev->bd_mutex);
 	/* Do not reset an active device or claimed device */
 	if (bdev->bd_openers || zram->claim) {
 		mutex_unlock(&bdev->bd_mutex);
 		bdput(bdev);
-		return -EBUSY;
+		return -ERR(EBUSY);
 	}
 
 	/* From now on, anyone can't open /dev/zram[0-9] */
@@ -1806,7 +1806,7 @@ static int zram_open(struct block_device *bdev, fmode_t mode)
 	zram = bdev->bd_disk->private_data;
 	/* zram was claimed to reset so open request fails */
 	if (zram->claim)
-		ret = -EBUSY;
+		ret = -ERR(EBUSY);
 
 	return ret;
 }
@@ -1880,7 +1880,7 @@ static int zram_add(void)
 
 	zram = kzalloc(sizeof(struct zram), GFP_KERNEL);
 	if (!zram)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	ret = idr_alloc(&zram_index_idr, zram, 0, 0, GFP_KERNEL);
 	if (ret < 0)
@@ -1895,7 +1895,7 @@ static int zram_add(void)
 	if (!queue) {
 		pr_err("Error allocating disk queue for device %d\n",
 			device_id);
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto out_free_idr;
 	}
 
@@ -1904,7 +1904,7 @@ static int zram_add(void)
 	if (!zram->disk) {
 		pr_err("Error allocating disk structure for device %d\n",
 			device_id);
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto out_free_queue;
 	}
 
@@ -1971,13 +1971,13 @@ static int zram_remove(struct zram *zram)
 
 	bdev = bdget_disk(zram->disk, 0);
 	if (!bdev)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	mutex_lock(&bdev->bd_mutex);
 	if (bdev->bd_openers || zram->claim) {
 		mutex_unlock(&bdev->bd_mutex);
 		bdput(bdev);
-		return -EBUSY;
+		return -ERR(EBUSY);
 	}
 
 	zram->claim = true;
@@ -2037,7 +2037,7 @@ static ssize_t hot_remove_store(struct class *class,
 	if (ret)
 		return ret;
 	if (dev_id < 0)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	mutex_lock(&zram_index_mutex);
 
@@ -2047,7 +2047,7 @@ static ssize_t hot_remove_store(struct class *class,
 		if (!ret)
 			idr_remove(&zram_index_idr, dev_id);
 	} else {
-		ret = -ENODEV;
+		ret = -ERR(ENODEV);
 	}
 
 	mutex_unlock(&zram_index_mutex);
@@ -2106,7 +2106,7 @@ static int __init zram_init(void)
 		pr_err("Unable to get major number\n");
 		class_unregister(&zram_control_class);
 		cpuhp_remove_multi_state(CPUHP_ZCOMP_PREPARE);
-		return -EBUSY;
+		return -ERR(EBUSY);
 	}
 
 	while (num_devices != 0) {
@@ -129,9 +129,9 @@ static void nvme_queue_scan(struct nvme_ctrl *ctrl)
 int nvme_try_sched_reset(struct nvme_ctrl *ctrl)
 {
 	if (ctrl->state != NVME_CTRL_RESETTING)
-		return -EBUSY;
+		return -ERR(EBUSY);
 	if (!queue_work(nvme_reset_wq, &ctrl->reset_work))
-		return -EBUSY;
+		return -ERR(EBUSY);
 	return 0;
 }
 EXPORT_SYMBOL_GPL(nvme_try_sched_reset);
@@ -139,9 +139,9 @@ EXPORT_SYMBOL_GPL(nvme_try_sched_reset);
 int nvme_reset_ctrl(struct nvme_ctrl *ctrl)
 {
 	if (!nvme_change_ctrl_state(ctrl, NVME_CTRL_RESETTING))
-		return -EBUSY;
+		return -ERR(EBUSY);
 	if (!queue_work(nvme_reset_wq, &ctrl->reset_work))
-		return -EBUSY;
+		return -ERR(EBUSY);
 	return 0;
 }
 EXPORT_SYMBOL_GPL(nvme_reset_ctrl);
@@ -154,7 +154,7 @@ int nvme_reset_ctrl_sync(struct nvme_ctrl *ctrl)
 	if (!ret) {
 		flush_work(&ctrl->reset_work);
 		if (ctrl->state != NVME_CTRL_LIVE)
-			ret = -ENETRESET;
+			ret = -ERR(ENETRESET);
 	}
 
 	return ret;
@@ -184,9 +184,9 @@ static void nvme_delete_ctrl_work(struct work_struct *work)
 int nvme_delete_ctrl(struct nvme_ctrl *ctrl)
 {
 	if (!nvme_change_ctrl_state(ctrl, NVME_CTRL_DELETING))
-		return -EBUSY;
+		return -ERR(EBUSY);
 	if (!queue_work(nvme_delete_wq, &ctrl->delete_work))
-		return -EBUSY;
+		return -ERR(EBUSY);
 	return 0;
 }
 EXPORT_SYMBOL_GPL(nvme_delete_ctrl);
@@ -833,7 +833,7 @@ int __nvme_submit_sync_cmd(struct request_queue *q, struct nvme_command *cmd,
 	if (result)
 		*result = nvme_req(req)->result;
 	if (nvme_req(req)->flags & NVME_REQ_CANCELLED)
-		ret = -EINTR;
+		ret = -ERR(EINTR);
 	else
 		ret = nvme_req(req)->status;
  out:
@@ -854,14 +854,14 @@ static void *nvme_add_user_metadata(struct bio *bio, void __user *ubuf,
 		unsigned len, u32 seed, bool write)
 {
 	struct bio_integrity_payload *bip;
-	int ret = -ENOMEM;
+	int ret = -ERR(ENOMEM);
 	void *buf;
 
 	buf = kmalloc(len, GFP_KERNEL);
 	if (!buf)
 		goto out;
 
-	ret = -EFAULT;
+	ret = -ERR(EFAULT);
 	if (write && copy_from_user(buf, ubuf, len))
 		goto out_free_meta;
 
@@ -877,7 +877,7 @@ static void *nvme_add_user_metadata(struct bio *bio, void __user *ubuf,
 			offset_in_page(buf));
 	if (ret == len)
 		return buf;
-	ret = -ENOMEM;
+	ret = -ERR(ENOMEM);
 out_free_meta:
 	kfree(buf);
 out:
@@ -924,14 +924,14 @@ static int nvme_submit_user_cmd(struct request_queue *q,
 
 	blk_execute_rq(req->q, disk, req, 0);
 	if (nvme_req(req)->flags & NVME_REQ_CANCELLED)
-		ret = -EINTR;
+		ret = -ERR(EINTR);
 	else
 		ret = nvme_req(req)->status;
 	if (result)
 		*result = le64_to_cpu(nvme_req(req)->result.u64);
 	if (meta && !ret && !write) {
 		if (copy_to_user(meta_buffer, meta, meta_len))
-			ret = -EFAULT;
+			ret = -ERR(EFAULT);
 	}
 	kfree(meta);
  out_unmap:
@@ -1047,7 +1047,7 @@ static int nvme_identify_ctrl(struct nvme_ctrl *dev, struct nvme_id_ctrl **id)
 
 	*id = kmalloc(sizeof(struct nvme_id_ctrl), GFP_KERNEL);
 	if (!*id)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	error = nvme_submit_sync_cmd(dev->admin_q, &c, *id,
 			sizeof(struct nvme_id_ctrl));
@@ -1111,7 +1111,7 @@ static int nvme_identify_ns_descs(struct nvme_ctrl *ctrl, unsigned nsid,
 
 	data = kzalloc(NVME_IDENTIFY_DATA_SIZE, GFP_KERNEL);
 	if (!data)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	status = nvme_submit_sync_cmd(ctrl->admin_q, &c, data,
 				      NVME_IDENTIFY_DATA_SIZE);
@@ -1162,7 +1162,7 @@ static int nvme_identify_ns(struct nvme_ctrl *ctrl,
 
 	*id = kmalloc(sizeof(**id), GFP_KERNEL);
 	if (!*id)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	error = nvme_submit_sync_cmd(ctrl->admin_q, &c, *id, sizeof(**id));
 	if (error) {
@@ -1279,9 +1279,9 @@ static int nvme_submit_io(struct nvme_ns *ns, struct nvme_user_io __user *uio)
 	void __user *metadata;
 
 	if (copy_from_user(&io, uio, sizeof(io)))
-		return -EFAULT;
+		return -ERR(EFAULT);
 	if (io.flags)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	switch (io.opcode) {
 	case nvme_cmd_write:
@@ -1289,7 +1289,7 @@ static int nvme_submit_io(struct nvme_ns *ns, struct nvme_user_io __user *uio)
 	case nvme_cmd_compare:
 		break;
 	default:
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 
 	length = (io.nblocks + 1) << ns->lba_shift;
@@ -1301,7 +1301,7 @@ static int nvme_submit_io(struct nvme_ns *ns, struct nvme_user_io __user *uio)
 		meta_len = 0;
 	} else if (meta_len) {
 		if ((io.metadata & 3) || !io.metadata)
-			return -EINVAL;
+			return -ERR(EINVAL);
 	}
 
 	memset(&c, 0, sizeof(c));
@@ -1415,11 +1415,11 @@ static int nvme_user_cmd(struct nvme_ctrl *ctrl, struct nvme_ns *ns,
 	int status;
 
 	if (!capable(CAP_SYS_ADMIN))
-		return -EACCES;
+		return -ERR(EACCES);
 	if (copy_from_user(&cmd, ucmd, sizeof(cmd)))
-		return -EFAULT;
+		return -ERR(EFAULT);
 	if (cmd.flags)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	memset(&c, 0, sizeof(c));
 	c.common.opcode = cmd.opcode;
@@ -1446,7 +1446,7 @@ static int nvme_user_cmd(struct nvme_ctrl *ctrl, struct nvme_ns *ns,
 
 	if (status >= 0) {
 		if (put_user(result, &ucmd->result))
-			return -EFAULT;
+			return -ERR(EFAULT);
 	}
 
 	return status;
@@ -1462,11 +1462,11 @@ static int nvme_user_cmd64(struct nvme_ctrl *ctrl, struct nvme_ns *ns,
 	int status;
 
 	if (!capable(CAP_SYS_ADMIN))
-		return -EACCES;
+		return -ERR(EACCES);
 	if (copy_from_user(&cmd, ucmd, sizeof(cmd)))
-		return -EFAULT;
+		return -ERR(EFAULT);
 	if (cmd.flags)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	memset(&c, 0, sizeof(c));
 	c.common.opcode = cmd.opcode;
@@ -1493,7 +1493,7 @@ static int nvme_user_cmd64(struct nvme_ctrl *ctrl, struct nvme_ns *ns,
 
 	if (status >= 0) {
 		if (put_user(cmd.result, &ucmd->result))
-			return -EFAULT;
+			return -ERR(EFAULT);
 	}
 
 	return status;
@@ -1602,7 +1602,7 @@ static int nvme_ioctl(struct block_device *bdev, fmode_t mode,
 		if (ns->ndev)
 			ret = nvme_nvm_ioctl(ns, cmd, arg);
 		else
-			ret = -ENOTTY;
+			ret = -ERR(ENOTTY);
 	}
 
 	nvme_put_ns_from_disk(head, srcu_idx);
@@ -1669,7 +1669,7 @@ static int nvme_open(struct block_device *bdev, fmode_t mode)
 fail_put_ns:
 	nvme_put_ns(ns);
 fail:
-	return -ENXIO;
+	return -ERR(ENXIO);
 }
 
 static void nvme_release(struct gendisk *disk, fmode_t mode)
@@ -1958,7 +1958,7 @@ static int __nvme_revalidate_disk(struct gendisk *disk, struct nvme_id_ns *id)
 				ns->features |= NVME_NS_METADATA_SUPPORTED;
 		} else {
 			if (WARN_ON_ONCE(ctrl->ops->flags & NVME_F_FABRICS))
-				return -EINVAL;
+				return -ERR(EINVAL);
 			if (ctrl->ops->flags & NVME_F_METADATA_SUPPORTED)
 				ns->features |= NVME_NS_METADATA_SUPPORTED;
 		}
@@ -1987,7 +1987,7 @@ static int nvme_revalidate_disk(struct gendisk *disk)
 
 	if (test_bit(NVME_NS_DEAD, &ns->flags)) {
 		set_capacity(disk, 0);
-		return -ENODEV;
+		return -ERR(ENODEV);
 	}
 
 	ret = nvme_identify_ns(ctrl, ns->head->ns_id, &id);
@@ -1995,7 +1995,7 @@ static int nvme_revalidate_disk(struct gendisk *disk)
 		goto out;
 
 	if (id->ncap == 0) {
-		ret = -ENODEV;
+		ret = -ERR(ENODEV);
 		goto free_id;
 	}
 
@@ -2006,7 +2006,7 @@ static int nvme_revalidate_disk(struct gendisk *disk)
 	if (!nvme_ns_ids_equal(&ns->head->ids, &ids)) {
 		dev_err(ctrl->device,
 			"identifiers changed for nsid %d\n", ns->head->ns_id);
-		ret = -ENODEV;
+		ret = -ERR(ENODEV);
 		goto free_id;
 	}
 
@@ -2077,7 +2077,7 @@ static int nvme_pr_register(struct block_device *bdev, u64 old,
 	u32 cdw10;
 
 	if (flags & ~PR_FL_IGNORE_KEY)
-		return -EOPNOTSUPP;
+		return -ERR(EOPNOTSUPP);
 
 	cdw10 = old ? 2 : 0;
 	cdw10 |= (flags & PR_FL_IGNORE_KEY) ? 1 << 3 : 0;
@@ -2091,7 +2091,7 @@ static int nvme_pr_reserve(struct block_device *bdev, u64 key,
 	u32 cdw10;
 
 	if (flags & ~PR_FL_IGNORE_KEY)
-		return -EOPNOTSUPP;
+		return -ERR(EOPNOTSUPP);
 
 	cdw10 = nvme_pr_type(type) << 8;
 	cdw10 |= ((flags & PR_FL_IGNORE_KEY) ? 1 << 3 : 0);
@@ -2164,7 +2164,7 @@ static int nvme_ns_head_open(struct block_device *bdev, fmode_t mode)
 	struct nvme_ns_head *head = bdev->bd_disk->private_data;
 
 	if (!kref_get_unless_zero(&head->ref))
-		return -ENXIO;
+		return -ERR(ENXIO);
 	return 0;
 }
 
@@ -2193,18 +2193,18 @@ static int nvme_wait_ready(struct nvme_ctrl *ctrl, u64 cap, bool enabled)
 
 	while ((ret = ctrl->ops->reg_read32(ctrl, NVME_REG_CSTS, &csts)) == 0) {
 		if (csts == ~0)
-			return -ENODEV;
+			return -ERR(ENODEV);
 		if ((csts & NVME_CSTS_RDY) == bit)
 			break;
 
 		usleep_range(1000, 2000);
 		if (fatal_signal_pending(current))
-			return -EINTR;
+			return -ERR(EINTR);
 		if (time_after(jiffies, timeout)) {
 			dev_err(ctrl->device,
 				"Device not ready; aborting %s, CSTS=0x%x\n",
 				enabled ? "initialisation" : "reset", csts);
-			return -ENODEV;
+			return -ERR(ENODEV);
 		}
 	}
 
@@ -2256,7 +2256,7 @@ int nvme_enable_ctrl(struct nvme_ctrl *ctrl)
 		dev_err(ctrl->device,
 			"Minimum device page size %u too large for host (%u)\n",
 			1 << dev_page_min, 1 << page_shift);
-		return -ENODEV;
+		return -ERR(ENODEV);
 	}
 
 	ctrl->page_size = 1 << page_shift;
@@ -2293,11 +2293,11 @@ int nvme_shutdown_ctrl(struct nvme_ctrl *ctrl)
 
 		msleep(100);
 		if (fatal_signal_pending(current))
-			return -EINTR;
+			return -ERR(EINTR);
 		if (time_after(jiffies, timeout)) {
 			dev_err(ctrl->device,
 				"Device shutdown incomplete; abort shutdown\n");
-			return -ENODEV;
+			return -ERR(ENODEV);
 		}
 	}
 
@@ -2741,7 +2741,7 @@ static int nvme_init_subsystem(struct nvme_ctrl *ctrl, struct nvme_id_ctrl *id)
 
 	subsys = kzalloc(sizeof(*subsys), GFP_KERNEL);
 	if (!subsys)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	subsys->instance = -1;
 	mutex_init(&subsys->lock);
@@ -2772,7 +2772,7 @@ static int nvme_init_subsystem(struct nvme_ctrl *ctrl, struct nvme_id_ctrl *id)
 		subsys = found;
 
 		if (!nvme_validate_cntlid(subsys, ctrl, id)) {
-			ret = -EINVAL;
+			ret = -ERR(EINVAL);
 			goto out_put_subsystem;
 		}
 	} else {
@@ -2872,7 +2872,7 @@ int nvme_init_identify(struct nvme_ctrl *ctrl)
 	ret = nvme_identify_ctrl(ctrl, &id);
 	if (ret) {
 		dev_err(ctrl->device, "Identify Controller failed (%d)\n", ret);
-		return -EIO;
+		return -ERR(EIO);
 	}
 
 	if (id->lpa & NVME_CTRL_LPA_CMD_EFFECTS_LOG) {
@@ -2980,14 +2980,14 @@ int nvme_init_identify(struct nvme_ctrl *ctrl)
 				"Mismatching cntlid: Connect %u vs Identify "
 				"%u, rejecting\n",
 				ctrl->cntlid, le16_to_cpu(id->cntlid));
-			ret = -EINVAL;
+			ret = -ERR(EINVAL);
 			goto out_free;
 		}
 
 		if (!ctrl->opts->discovery_nqn && !ctrl->kas) {
 			dev_err(ctrl->device,
 				"keep-alive support is mandatory for fabrics\n");
-			ret = -EINVAL;
+			ret = -ERR(EINVAL);
 			goto out_free;
 		}
 	} else {
@@ -3060,7 +3060,7 @@ static int nvme_dev_user_cmd(struct nvme_ctrl *ctrl, void __user *argp)
 
 	down_read(&ctrl->namespaces_rwsem);
 	if (list_empty(&ctrl->namespaces)) {
-		ret = -ENOTTY;
+		ret = -ERR(ENOTTY);
 		goto out_unlock;
 	}
 
@@ -3068,7 +3068,7 @@ static int nvme_dev_user_cmd(struct nvme_ctrl *ctrl, void __user *argp)
 	if (ns != list_last_entry(&ctrl->namespaces, struct nvme_ns, list)) {
 		dev_warn(ctrl->device,
 			"NVME_IOCTL_IO_CMD not supported when multiple namespaces present!\n");
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto out_unlock;
 	}
 
@@ -3108,7 +3108,7 @@ static long nvme_dev_ioctl(struct file *file, unsigned int cmd,
 		nvme_queue_scan(ctrl);
 		return 0;
 	default:
-		return -ENOTTY;
+		return -ERR(ENOTTY);
 	}
 }
 
@@ -3315,7 +3315,7 @@ static ssize_t nvme_sysfs_delete(struct device *dev,
 
 	/* Can't delete non-created controllers */
 	if (!ctrl->created)
-		return -EBUSY;
+		return -ERR(EBUSY);
 
 	if (device_remove_file_self(dev, attr))
 		nvme_delete_ctrl_sync(ctrl);
@@ -3469,7 +3469,7 @@ static int __nvme_check_ids(struct nvme_subsystem *subsys,
 	list_for_each_entry(h, &subsys->nsheads, entry) {
 		if (nvme_ns_ids_valid(&new->ids) &&
 		    nvme_ns_ids_equal(&new->ids, &h->ids))
-			return -EINVAL;
+			return -ERR(EINVAL);
 	}
 
 	return 0;
@@ -3480,7 +3480,7 @@ static struct nvme_ns_head *nvme_alloc_ns_head(struct nvme_ctrl *ctrl,
 {
 	struct nvme_ns_head *head;
 	size_t size = sizeof(*head);
-	int ret = -ENOMEM;
+	int ret = -ERR(ENOMEM);
 
 #ifdef CONFIG_NVME_MULTIPATH
 	size += num_possible_nodes() * sizeof(struct nvme_ns *);
@@ -3556,7 +3556,7 @@ static int nvme_init_ns_head(struct nvme_ns *ns, unsigned nsid,
 		}
 		head->shared = is_shared;
 	} else {
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		if (!is_shared || !head->shared) {
 			dev_err(ctrl->device,
 				"Duplicate unshared namespace %d\n", nsid);
@@ -3789,11 +3789,11 @@ static int nvme_scan_ns_list(struct nvme_ctrl *ctrl)
 	int ret = 0, i;
 
 	if (nvme_ctrl_limited_cns(ctrl))
-		return -EOPNOTSUPP;
+		return -ERR(EOPNOTSUPP);
 
 	ns_list = kzalloc(NVME_IDENTIFY_DATA_SIZE, GFP_KERNEL);
 	if (!ns_list)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	for (;;) {
 		ret = nvme_identify_ns_list(ctrl, prev, ns_list);
@@ -4186,7 +4186,7 @@ int nvme_init_ctrl(struct nvme_ctrl *ctrl, struct device *dev,
 			PAGE_SIZE);
 	ctrl->discard_page = alloc_page(GFP_KERNEL);
 	if (!ctrl->discard_page) {
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto out;
 	}
 
@@ -4372,7 +4372,7 @@ static inline void _nvme_check_size(void)
 
 static int __init nvme_core_init(void)
 {
-	int result = -ENOMEM;
+	int result = -ERR(ENOMEM);
 
 	_nvme_check_size();
 
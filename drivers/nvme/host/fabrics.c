@@ -389,7 +389,7 @@ int nvmf_connect_admin_queue(struct nvme_ctrl *ctrl)
 
 	data = kzalloc(sizeof(*data), GFP_KERNEL);
 	if (!data)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	uuid_copy(&data->hostid, &ctrl->opts->host->id);
 	data->cntlid = cpu_to_le16(0xffff);
@@ -452,7 +452,7 @@ int nvmf_connect_io_queue(struct nvme_ctrl *ctrl, u16 qid, bool poll)
 
 	data = kzalloc(sizeof(*data), GFP_KERNEL);
 	if (!data)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	uuid_copy(&data->hostid, &ctrl->opts->host->id);
 	data->cntlid = cpu_to_le16(ctrl->cntlid);
@@ -493,7 +493,7 @@ EXPORT_SYMBOL_GPL(nvmf_should_reconnect);
 int nvmf_register_transport(struct nvmf_transport_ops *ops)
 {
 	if (!ops->create_ctrl)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	down_write(&nvmf_transports_rwsem);
 	list_add_tail(&ops->entry, &nvmf_transports);
@@ -637,7 +637,7 @@ static int nvmf_parse_options(struct nvmf_ctrl_options *opts,
 
 	options = o = kstrdup(buf, GFP_KERNEL);
 	if (!options)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	uuid_gen(&hostid);
 
@@ -651,7 +651,7 @@ static int nvmf_parse_options(struct nvmf_ctrl_options *opts,
 		case NVMF_OPT_TRANSPORT:
 			p = match_strdup(args);
 			if (!p) {
-				ret = -ENOMEM;
+				ret = -ERR(ENOMEM);
 				goto out;
 			}
 			kfree(opts->transport);
@@ -660,7 +660,7 @@ static int nvmf_parse_options(struct nvmf_ctrl_options *opts,
 		case NVMF_OPT_NQN:
 			p = match_strdup(args);
 			if (!p) {
-				ret = -ENOMEM;
+				ret = -ERR(ENOMEM);
 				goto out;
 			}
 			kfree(opts->subsysnqn);
@@ -669,7 +669,7 @@ static int nvmf_parse_options(struct nvmf_ctrl_options *opts,
 			if (nqnlen >= NVMF_NQN_SIZE) {
 				pr_err("%s needs to be < %d bytes\n",
 					opts->subsysnqn, NVMF_NQN_SIZE);
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out;
 			}
 			opts->discovery_nqn =
@@ -679,7 +679,7 @@ static int nvmf_parse_options(struct nvmf_ctrl_options *opts,
 		case NVMF_OPT_TRADDR:
 			p = match_strdup(args);
 			if (!p) {
-				ret = -ENOMEM;
+				ret = -ERR(ENOMEM);
 				goto out;
 			}
 			kfree(opts->traddr);
@@ -688,7 +688,7 @@ static int nvmf_parse_options(struct nvmf_ctrl_options *opts,
 		case NVMF_OPT_TRSVCID:
 			p = match_strdup(args);
 			if (!p) {
-				ret = -ENOMEM;
+				ret = -ERR(ENOMEM);
 				goto out;
 			}
 			kfree(opts->trsvcid);
@@ -696,25 +696,25 @@ static int nvmf_parse_options(struct nvmf_ctrl_options *opts,
 			break;
 		case NVMF_OPT_QUEUE_SIZE:
 			if (match_int(args, &token)) {
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out;
 			}
 			if (token < NVMF_MIN_QUEUE_SIZE ||
 			    token > NVMF_MAX_QUEUE_SIZE) {
 				pr_err("Invalid queue_size %d\n", token);
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out;
 			}
 			opts->queue_size = token;
 			break;
 		case NVMF_OPT_NR_IO_QUEUES:
 			if (match_int(args, &token)) {
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out;
 			}
 			if (token <= 0) {
 				pr_err("Invalid number of IOQs %d\n", token);
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out;
 			}
 			if (opts->discovery_nqn) {
@@ -727,13 +727,13 @@ static int nvmf_parse_options(struct nvmf_ctrl_options *opts,
 			break;
 		case NVMF_OPT_KATO:
 			if (match_int(args, &token)) {
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out;
 			}
 
 			if (token < 0) {
 				pr_err("Invalid keep_alive_tmo %d\n", token);
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out;
 			} else if (token == 0 && !opts->discovery_nqn) {
 				/* Allowed for debug */
@@ -743,7 +743,7 @@ static int nvmf_parse_options(struct nvmf_ctrl_options *opts,
 			break;
 		case NVMF_OPT_CTRL_LOSS_TMO:
 			if (match_int(args, &token)) {
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out;
 			}
 
@@ -755,12 +755,12 @@ static int nvmf_parse_options(struct nvmf_ctrl_options *opts,
 			if (opts->host) {
 				pr_err("hostnqn already user-assigned: %s\n",
 				       opts->host->nqn);
-				ret = -EADDRINUSE;
+				ret = -ERR(EADDRINUSE);
 				goto out;
 			}
 			p = match_strdup(args);
 			if (!p) {
-				ret = -ENOMEM;
+				ret = -ERR(ENOMEM);
 				goto out;
 			}
 			nqnlen = strlen(p);
@@ -768,25 +768,25 @@ static int nvmf_parse_options(struct nvmf_ctrl_options *opts,
 				pr_err("%s needs to be < %d bytes\n",
 					p, NVMF_NQN_SIZE);
 				kfree(p);
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out;
 			}
 			nvmf_host_put(opts->host);
 			opts->host = nvmf_host_add(p);
 			kfree(p);
 			if (!opts->host) {
-				ret = -ENOMEM;
+				ret = -ERR(ENOMEM);
 				goto out;
 			}
 			break;
 		case NVMF_OPT_RECONNECT_DELAY:
 			if (match_int(args, &token)) {
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out;
 			}
 			if (token <= 0) {
 				pr_err("Invalid reconnect_delay %d\n", token);
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out;
 			}
 			opts->reconnect_delay = token;
@@ -794,7 +794,7 @@ static int nvmf_parse_options(struct nvmf_ctrl_options *opts,
 		case NVMF_OPT_HOST_TRADDR:
 			p = match_strdup(args);
 			if (!p) {
-				ret = -ENOMEM;
+				ret = -ERR(ENOMEM);
 				goto out;
 			}
 			kfree(opts->host_traddr);
@@ -803,13 +803,13 @@ static int nvmf_parse_options(struct nvmf_ctrl_options *opts,
 		case NVMF_OPT_HOST_ID:
 			p = match_strdup(args);
 			if (!p) {
-				ret = -ENOMEM;
+				ret = -ERR(ENOMEM);
 				goto out;
 			}
 			ret = uuid_parse(p, &hostid);
 			if (ret) {
 				pr_err("Invalid hostid %s\n", p);
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				kfree(p);
 				goto out;
 			}
@@ -829,36 +829,36 @@ static int nvmf_parse_options(struct nvmf_ctrl_options *opts,
 			break;
 		case NVMF_OPT_NR_WRITE_QUEUES:
 			if (match_int(args, &token)) {
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out;
 			}
 			if (token <= 0) {
 				pr_err("Invalid nr_write_queues %d\n", token);
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out;
 			}
 			opts->nr_write_queues = token;
 			break;
 		case NVMF_OPT_NR_POLL_QUEUES:
 			if (match_int(args, &token)) {
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out;
 			}
 			if (token <= 0) {
 				pr_err("Invalid nr_poll_queues %d\n", token);
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out;
 			}
 			opts->nr_poll_queues = token;
 			break;
 		case NVMF_OPT_TOS:
 			if (match_int(args, &token)) {
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out;
 			}
 			if (token < 0) {
 				pr_err("Invalid type of service %d\n", token);
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out;
 			}
 			if (token > 255) {
@@ -870,7 +870,7 @@ static int nvmf_parse_options(struct nvmf_ctrl_options *opts,
 		default:
 			pr_warn("unknown parameter or missing value '%s' in ctrl creation request\n",
 				p);
-			ret = -EINVAL;
+			ret = -ERR(EINVAL);
 			goto out;
 		}
 	}
@@ -913,7 +913,7 @@ static int nvmf_check_required_opts(struct nvmf_ctrl_options *opts,
 			}
 		}
 
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 
 	return 0;
@@ -963,7 +963,7 @@ static int nvmf_check_allowed_opts(struct nvmf_ctrl_options *opts,
 			}
 		}
 
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 
 	return 0;
@@ -997,7 +997,7 @@ nvmf_create_ctrl(struct device *dev, const char *buf)
 
 	opts = kzalloc(sizeof(*opts), GFP_KERNEL);
 	if (!opts)
-		return ERR_PTR(-ENOMEM);
+		return ERR_PTR(-ERR(ENOMEM));
 
 	ret = nvmf_parse_options(opts, buf);
 	if (ret)
@@ -1021,12 +1021,12 @@ nvmf_create_ctrl(struct device *dev, const char *buf)
 	if (!ops) {
 		pr_info("no handler found for transport %s.\n",
 			opts->transport);
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto out_unlock;
 	}
 
 	if (!try_module_get(ops->module)) {
-		ret = -EBUSY;
+		ret = -ERR(EBUSY);
 		goto out_unlock;
 	}
 	up_read(&nvmf_transports_rwsem);
@@ -1071,7 +1071,7 @@ static ssize_t nvmf_dev_write(struct file *file, const char __user *ubuf,
 	int ret = 0;
 
 	if (count > PAGE_SIZE)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	buf = memdup_user_nul(ubuf, count);
 	if (IS_ERR(buf))
@@ -1079,7 +1079,7 @@ static ssize_t nvmf_dev_write(struct file *file, const char __user *ubuf,
 
 	mutex_lock(&nvmf_dev_mutex);
 	if (seq_file->private) {
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto out_unlock;
 	}
 
@@ -1105,7 +1105,7 @@ static int nvmf_dev_show(struct seq_file *seq_file, void *private)
 	mutex_lock(&nvmf_dev_mutex);
 	ctrl = seq_file->private;
 	if (!ctrl) {
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto out_unlock;
 	}
 
@@ -1157,7 +1157,7 @@ static int __init nvmf_init(void)
 
 	nvmf_default_host = nvmf_host_default();
 	if (!nvmf_default_host)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	nvmf_class = class_create(THIS_MODULE, "nvme-fabrics");
 	if (IS_ERR(nvmf_class)) {
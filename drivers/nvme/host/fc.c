@@ -290,12 +290,12 @@ nvme_fc_attach_to_unreg_lport(struct nvme_fc_port_info *pinfo,
 			continue;
 
 		if (lport->dev != dev) {
-			lport = ERR_PTR(-EXDEV);
+			lport = ERR_PTR(-ERR(EXDEV));
 			goto out_done;
 		}
 
 		if (lport->localport.port_state != FC_OBJSTATE_DELETED) {
-			lport = ERR_PTR(-EEXIST);
+			lport = ERR_PTR(-ERR(EEXIST));
 			goto out_done;
 		}
 
@@ -360,7 +360,7 @@ nvme_fc_register_localport(struct nvme_fc_port_info *pinfo,
 	    !template->ls_abort || !template->fcp_abort ||
 	    !template->max_hw_queues || !template->max_sgl_segments ||
 	    !template->max_dif_sgl_segments || !template->dma_boundary) {
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto out_reghost_failed;
 	}
 
@@ -389,18 +389,18 @@ nvme_fc_register_localport(struct nvme_fc_port_info *pinfo,
 	newrec = kmalloc((sizeof(*newrec) + template->local_priv_sz),
 			 GFP_KERNEL);
 	if (!newrec) {
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto out_reghost_failed;
 	}
 
 	idx = ida_simple_get(&nvme_fc_local_port_cnt, 0, 0, GFP_KERNEL);
 	if (idx < 0) {
-		ret = -ENOSPC;
+		ret = -ERR(ENOSPC);
 		goto out_fail_kfree;
 	}
 
 	if (!get_device(dev) && dev) {
-		ret = -ENODEV;
+		ret = -ERR(ENODEV);
 		goto out_ida_put;
 	}
 
@@ -460,13 +460,13 @@ nvme_fc_unregister_localport(struct nvme_fc_local_port *portptr)
 	unsigned long flags;
 
 	if (!portptr)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	spin_lock_irqsave(&nvme_fc_lock, flags);
 
 	if (portptr->port_state != FC_OBJSTATE_ONLINE) {
 		spin_unlock_irqrestore(&nvme_fc_lock, flags);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 	portptr->port_state = FC_OBJSTATE_DELETED;
 
@@ -595,7 +595,7 @@ nvme_fc_attach_to_suspended_rport(struct nvme_fc_lport *lport,
 			continue;
 
 		if (!nvme_fc_rport_get(rport)) {
-			rport = ERR_PTR(-ENOLCK);
+			rport = ERR_PTR(-ERR(ENOLCK));
 			goto out_done;
 		}
 
@@ -608,7 +608,7 @@ nvme_fc_attach_to_suspended_rport(struct nvme_fc_lport *lport,
 			/* means lldd called us twice */
 			spin_unlock_irqrestore(&rport->lock, flags);
 			nvme_fc_rport_put(rport);
-			return ERR_PTR(-ESTALE);
+			return ERR_PTR(-ERR(ESTALE));
 		}
 
 		rport->remoteport.port_role = pinfo->port_role;
@@ -673,7 +673,7 @@ nvme_fc_register_remoteport(struct nvme_fc_local_port *localport,
 	int ret, idx;
 
 	if (!nvme_fc_lport_get(lport)) {
-		ret = -ESHUTDOWN;
+		ret = -ERR(ESHUTDOWN);
 		goto out_reghost_failed;
 	}
 
@@ -703,13 +703,13 @@ nvme_fc_register_remoteport(struct nvme_fc_local_port *localport,
 	newrec = kmalloc((sizeof(*newrec) + lport->ops->remote_priv_sz),
 			 GFP_KERNEL);
 	if (!newrec) {
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto out_lport_put;
 	}
 
 	idx = ida_simple_get(&lport->endp_cnt, 0, 0, GFP_KERNEL);
 	if (idx < 0) {
-		ret = -ENOSPC;
+		ret = -ERR(ENOSPC);
 		goto out_kfree_rport;
 	}
 
@@ -850,13 +850,13 @@ nvme_fc_unregister_remoteport(struct nvme_fc_remote_port *portptr)
 	unsigned long flags;
 
 	if (!portptr)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	spin_lock_irqsave(&rport->lock, flags);
 
 	if (portptr->port_state != FC_OBJSTATE_ONLINE) {
 		spin_unlock_irqrestore(&rport->lock, flags);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 	portptr->port_state = FC_OBJSTATE_DELETED;
 
@@ -919,7 +919,7 @@ nvme_fc_set_remoteport_devloss(struct nvme_fc_remote_port *portptr,
 
 	if (portptr->port_state != FC_OBJSTATE_ONLINE) {
 		spin_unlock_irqrestore(&rport->lock, flags);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 
 	/* a dev_loss_tmo of 0 (immediate) is allowed to be set */
@@ -1064,10 +1064,10 @@ __nvme_fc_send_ls_req(struct nvme_fc_rport *rport,
 	int ret = 0;
 
 	if (rport->remoteport.port_state != FC_OBJSTATE_ONLINE)
-		return -ECONNREFUSED;
+		return -ERR(ECONNREFUSED);
 
 	if (!nvme_fc_rport_get(rport))
-		return -ESHUTDOWN;
+		return -ERR(ESHUTDOWN);
 
 	lsreq->done = done;
 	lsop->rport = rport;
@@ -1079,7 +1079,7 @@ __nvme_fc_send_ls_req(struct nvme_fc_rport *rport,
 				  lsreq->rqstlen + lsreq->rsplen,
 				  DMA_BIDIRECTIONAL);
 	if (fc_dma_mapping_error(rport->dev, lsreq->rqstdma)) {
-		ret = -EFAULT;
+		ret = -ERR(EFAULT);
 		goto out_putrport;
 	}
 	lsreq->rspdma = lsreq->rqstdma + lsreq->rqstlen;
@@ -1151,7 +1151,7 @@ nvme_fc_send_ls_req(struct nvme_fc_rport *rport, struct nvmefc_ls_req_op *lsop)
 
 	/* ACC or RJT payload ? */
 	if (rjt->w0.ls_cmd == FCNVME_LS_RJT)
-		return -ENXIO;
+		return -ERR(ENXIO);
 
 	return 0;
 }
@@ -1184,7 +1184,7 @@ nvme_fc_connect_admin_queue(struct nvme_fc_ctrl *ctrl,
 		dev_info(ctrl->ctrl.device,
 			"NVME-FC{%d}: send Create Association failed: ENOMEM\n",
 			ctrl->cnum);
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto out_no_memory;
 	}
 
@@ -1259,7 +1259,7 @@ nvme_fc_connect_admin_queue(struct nvme_fc_ctrl *ctrl,
 		fcret = VERR_CONN_ID_LEN;
 
 	if (fcret) {
-		ret = -EBADF;
+		ret = -ERR(EBADF);
 		dev_err(ctrl->dev,
 			"q %d Create Association LS failed: %s\n",
 			queue->qnum, validation_errors[fcret]);
@@ -1300,7 +1300,7 @@ nvme_fc_connect_queue(struct nvme_fc_ctrl *ctrl, struct nvme_fc_queue *queue,
 		dev_info(ctrl->ctrl.device,
 			"NVME-FC{%d}: send Create Connection failed: ENOMEM\n",
 			ctrl->cnum);
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto out_no_memory;
 	}
 
@@ -1365,7 +1365,7 @@ nvme_fc_connect_queue(struct nvme_fc_ctrl *ctrl, struct nvme_fc_queue *queue,
 		fcret = VERR_CONN_ID_LEN;
 
 	if (fcret) {
-		ret = -EBADF;
+		ret = -ERR(EBADF);
 		dev_err(ctrl->dev,
 			"q %d Create I/O Connection LS failed: %s\n",
 			queue->qnum, validation_errors[fcret]);
@@ -1731,7 +1731,7 @@ nvme_fc_rcv_ls_req(struct nvme_fc_remote_port *portptr,
 			"RCV %s LS failed: no LLDD xmt_ls_rsp\n",
 			(w0->ls_cmd <= NVME_FC_LAST_LS_CMD_VALUE) ?
 				nvmefc_ls_names[w0->ls_cmd] : "");
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto out_put;
 	}
 
@@ -1740,7 +1740,7 @@ nvme_fc_rcv_ls_req(struct nvme_fc_remote_port *portptr,
 			"RCV %s LS failed: payload too large\n",
 			(w0->ls_cmd <= NVME_FC_LAST_LS_CMD_VALUE) ?
 				nvmefc_ls_names[w0->ls_cmd] : "");
-		ret = -E2BIG;
+		ret = -ERR(E2BIG);
 		goto out_put;
 	}
 
@@ -1753,7 +1753,7 @@ nvme_fc_rcv_ls_req(struct nvme_fc_remote_port *portptr,
 			"RCV %s LS failed: No memory\n",
 			(w0->ls_cmd <= NVME_FC_LAST_LS_CMD_VALUE) ?
 				nvmefc_ls_names[w0->ls_cmd] : "");
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto out_put;
 	}
 	lsop->rqstbuf = (union nvmefc_ls_requests *)&lsop[1];
@@ -1767,7 +1767,7 @@ nvme_fc_rcv_ls_req(struct nvme_fc_remote_port *portptr,
 			"RCV %s LS failed: DMA mapping failure\n",
 			(w0->ls_cmd <= NVME_FC_LAST_LS_CMD_VALUE) ?
 				nvmefc_ls_names[w0->ls_cmd] : "");
-		ret = -EFAULT;
+		ret = -ERR(EFAULT);
 		goto out_free;
 	}
 
@@ -1780,7 +1780,7 @@ nvme_fc_rcv_ls_req(struct nvme_fc_remote_port *portptr,
 	spin_lock_irqsave(&rport->lock, flags);
 	if (rport->remoteport.port_state != FC_OBJSTATE_ONLINE) {
 		spin_unlock_irqrestore(&rport->lock, flags);
-		ret = -ENOTCONN;
+		ret = -ERR(ENOTCONN);
 		goto out_unmap;
 	}
 	list_add_tail(&lsop->lsrcv_list, &rport->ls_rcv_list);
@@ -1840,7 +1840,7 @@ __nvme_fc_abort_op(struct nvme_fc_ctrl *ctrl, struct nvme_fc_fcp_op *op)
 	spin_unlock_irqrestore(&ctrl->lock, flags);
 
 	if (opstate != FCPOP_STATE_ACTIVE)
-		return -ECANCELED;
+		return -ERR(ECANCELED);
 
 	ctrl->lport->ops->fcp_abort(&ctrl->lport->localport,
 					&ctrl->rport->remoteport,
@@ -2075,7 +2075,7 @@ __nvme_fc_init_request(struct nvme_fc_ctrl *ctrl,
 	if (fc_dma_mapping_error(ctrl->lport->dev, op->fcp_req.cmddma)) {
 		dev_err(ctrl->dev,
 			"FCP Op failed - cmdiu dma mapping failed.\n");
-		ret = EFAULT;
+		ret = ERR(EFAULT);
 		goto out_on_error;
 	}
 
@@ -2085,7 +2085,7 @@ __nvme_fc_init_request(struct nvme_fc_ctrl *ctrl,
 	if (fc_dma_mapping_error(ctrl->lport->dev, op->fcp_req.rspdma)) {
 		dev_err(ctrl->dev,
 			"FCP Op failed - rspiu dma mapping failed.\n");
-		ret = EFAULT;
+		ret = ERR(EFAULT);
 	}
 
 	atomic_set(&op->state, FCPOP_STATE_IDLE);
@@ -2127,7 +2127,7 @@ nvme_fc_init_aen_ops(struct nvme_fc_ctrl *ctrl)
 			private = kzalloc(ctrl->lport->ops->fcprqst_priv_sz,
 						GFP_KERNEL);
 			if (!private)
-				return -ENOMEM;
+				return -ERR(ENOMEM);
 		}
 
 		cmdiu = &aen_op->cmd_iu;
@@ -2477,7 +2477,7 @@ nvme_fc_map_data(struct nvme_fc_ctrl *ctrl, struct request *rq,
 			blk_rq_nr_phys_segments(rq), freq->sg_table.sgl,
 			NVME_INLINE_SG_CNT);
 	if (ret)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	op->nents = blk_rq_map_sg(rq->q, rq, freq->sg_table.sgl);
 	WARN_ON(op->nents > blk_rq_nr_phys_segments(rq));
@@ -2486,7 +2486,7 @@ nvme_fc_map_data(struct nvme_fc_ctrl *ctrl, struct request *rq,
 	if (unlikely(freq->sg_cnt <= 0)) {
 		sg_free_table_chained(&freq->sg_table, NVME_INLINE_SG_CNT);
 		freq->sg_cnt = 0;
-		return -EFAULT;
+		return -ERR(EFAULT);
 	}
 
 	/*
@@ -2856,7 +2856,7 @@ nvme_fc_recreate_io_queues(struct nvme_fc_ctrl *ctrl)
 		dev_info(ctrl->ctrl.device,
 			"Fail Reconnect: At least 1 io queue "
 			"required (was %d)\n", prior_ioq_cnt);
-		return -ENOSPC;
+		return -ERR(ENOSPC);
 	}
 
 	ctrl->ctrl.queue_count = nr_io_queues + 1;
@@ -2957,10 +2957,10 @@ nvme_fc_create_association(struct nvme_fc_ctrl *ctrl)
 	++ctrl->ctrl.nr_reconnects;
 
 	if (ctrl->rport->remoteport.port_state != FC_OBJSTATE_ONLINE)
-		return -ENODEV;
+		return -ERR(ENODEV);
 
 	if (nvme_fc_ctlr_active_on_rport(ctrl))
-		return -ENOTUNIQ;
+		return -ERR(ENOTUNIQ);
 
 	dev_info(ctrl->ctrl.device,
 		"NVME-FC{%d}: create association : host wwpn 0x%016llx "
@@ -3295,7 +3295,7 @@ nvme_fc_reset_ctrl_work(struct work_struct *work)
 	if (ctrl->rport->remoteport.port_state == FC_OBJSTATE_ONLINE)
 		ret = nvme_fc_create_association(ctrl);
 	else
-		ret = -ENOTCONN;
+		ret = -ERR(ENOTCONN);
 
 	if (ret)
 		nvme_fc_reconnect_or_delete(ctrl, ret);
@@ -3402,25 +3402,25 @@ nvme_fc_init_ctrl(struct device *dev, struct nvmf_ctrl_options *opts,
 
 	if (!(rport->remoteport.port_role &
 	    (FC_PORT_ROLE_NVME_DISCOVERY | FC_PORT_ROLE_NVME_TARGET))) {
-		ret = -EBADR;
+		ret = -ERR(EBADR);
 		goto out_fail;
 	}
 
 	if (!opts->duplicate_connect &&
 	    nvme_fc_existing_controller(rport, opts)) {
-		ret = -EALREADY;
+		ret = -ERR(EALREADY);
 		goto out_fail;
 	}
 
 	ctrl = kzalloc(sizeof(*ctrl), GFP_KERNEL);
 	if (!ctrl) {
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto out_fail;
 	}
 
 	idx = ida_simple_get(&nvme_fc_ctrl_cnt, 0, 0, GFP_KERNEL);
 	if (idx < 0) {
-		ret = -ENOSPC;
+		ret = -ERR(ENOSPC);
 		goto out_free_ctrl;
 	}
 
@@ -3457,7 +3457,7 @@ nvme_fc_init_ctrl(struct device *dev, struct nvmf_ctrl_options *opts,
 	ctrl->ctrl.kato = opts->kato;
 	ctrl->ctrl.cntlid = 0xffff;
 
-	ret = -ENOMEM;
+	ret = -ERR(ENOMEM);
 	ctrl->queues = kcalloc(ctrl->ctrl.queue_count,
 				sizeof(struct nvme_fc_queue), GFP_KERNEL);
 	if (!ctrl->queues)
@@ -3557,7 +3557,7 @@ nvme_fc_init_ctrl(struct device *dev, struct nvmf_ctrl_options *opts,
 	 */
 	nvme_fc_rport_get(rport);
 
-	return ERR_PTR(-EIO);
+	return ERR_PTR(-ERR(EIO));
 
 out_cleanup_admin_q:
 	blk_cleanup_queue(ctrl->ctrl.admin_q);
@@ -3589,7 +3589,7 @@ __nvme_fc_parse_u64(substring_t *sstr, u64 *val)
 	u64 token64;
 
 	if (match_u64(sstr, &token64))
-		return -EINVAL;
+		return -ERR(EINVAL);
 	*val = token64;
 
 	return 0;
@@ -3640,7 +3640,7 @@ nvme_fc_parse_traddr(struct nvmet_fc_traddr *traddr, char *buf, size_t blen)
 
 out_einval:
 	pr_warn("%s: bad traddr string\n", __func__);
-	return -EINVAL;
+	return -ERR(EINVAL);
 }
 
 static struct nvme_ctrl *
@@ -3656,11 +3656,11 @@ nvme_fc_create_ctrl(struct device *dev, struct nvmf_ctrl_options *opts)
 
 	ret = nvme_fc_parse_traddr(&raddr, opts->traddr, NVMF_TRADDR_SIZE);
 	if (ret || !raddr.nn || !raddr.pn)
-		return ERR_PTR(-EINVAL);
+		return ERR_PTR(-ERR(EINVAL));
 
 	ret = nvme_fc_parse_traddr(&laddr, opts->host_traddr, NVMF_TRADDR_SIZE);
 	if (ret || !laddr.nn || !laddr.pn)
-		return ERR_PTR(-EINVAL);
+		return ERR_PTR(-ERR(EINVAL));
 
 	/* find the host and remote ports to connect together */
 	spin_lock_irqsave(&nvme_fc_lock, flags);
@@ -3690,7 +3690,7 @@ nvme_fc_create_ctrl(struct device *dev, struct nvmf_ctrl_options *opts)
 
 	pr_warn("%s: %s - %s combination not found\n",
 		__func__, opts->traddr, opts->host_traddr);
-	return ERR_PTR(-ENOENT);
+	return ERR_PTR(-ERR(ENOENT));
 }
 
 
@@ -3792,7 +3792,7 @@ static int __init nvme_fc_init_module(void)
 
 	nvme_fc_wq = alloc_workqueue("nvme_fc_wq", WQ_MEM_RECLAIM, 0);
 	if (!nvme_fc_wq)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	/*
 	 * NOTE:
@@ -29,7 +29,7 @@ static int nvme_get_temp_thresh(struct nvme_ctrl *ctrl, int sensor, bool under,
 	ret = nvme_get_features(ctrl, NVME_FEAT_TEMP_THRESH, threshold, NULL, 0,
 				&status);
 	if (ret > 0)
-		return -EIO;
+		return -ERR(EIO);
 	if (ret < 0)
 		return ret;
 	*temp = kelvin_to_millicelsius(status & NVME_TEMP_THRESH_MASK);
@@ -52,7 +52,7 @@ static int nvme_set_temp_thresh(struct nvme_ctrl *ctrl, int sensor, bool under,
 	ret = nvme_set_features(ctrl, NVME_FEAT_TEMP_THRESH, threshold, NULL, 0,
 				NULL);
 	if (ret > 0)
-		return -EIO;
+		return -ERR(EIO);
 
 	return ret;
 }
@@ -64,7 +64,7 @@ static int nvme_hwmon_get_smart_log(struct nvme_hwmon_data *data)
 	ret = nvme_get_log(data->ctrl, NVME_NSID_ALL, NVME_LOG_SMART, 0,
 			   &data->log, sizeof(data->log), 0);
 
-	return ret <= 0 ? ret : -EIO;
+	return ret <= 0 ? ret : -ERR(EIO);
 }
 
 static int nvme_hwmon_read(struct device *dev, enum hwmon_sensor_types type,
@@ -108,7 +108,7 @@ static int nvme_hwmon_read(struct device *dev, enum hwmon_sensor_types type,
 		*val = !!(log->critical_warning & NVME_SMART_CRIT_TEMPERATURE);
 		break;
 	default:
-		err = -EOPNOTSUPP;
+		err = -ERR(EOPNOTSUPP);
 		break;
 	}
 unlock:
@@ -130,7 +130,7 @@ static int nvme_hwmon_write(struct device *dev, enum hwmon_sensor_types type,
 		break;
 	}
 
-	return -EOPNOTSUPP;
+	return -ERR(EOPNOTSUPP);
 }
 
 static const char * const nvme_hwmon_sensor_names[] = {
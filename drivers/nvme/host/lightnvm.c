@@ -289,13 +289,13 @@ static int nvme_nvm_setup_12(struct nvme_nvm_id12 *id,
 	int sec_per_pg, sec_per_pl, pg_per_blk;
 
 	if (id->cgrps != 1)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	src = &id->grp;
 
 	if (src->mtype != 0) {
 		pr_err("nvm: memory type not supported\n");
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 
 	/* 1.2 spec. only reports a single version id - unfold */
@@ -440,12 +440,12 @@ static int nvme_nvm_identity(struct nvm_dev *nvmdev)
 
 	id = kmalloc(sizeof(struct nvme_nvm_id12), GFP_KERNEL);
 	if (!id)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	ret = nvme_submit_sync_cmd(ns->ctrl->admin_q, (struct nvme_command *)&c,
 				id, sizeof(struct nvme_nvm_id12));
 	if (ret) {
-		ret = -EIO;
+		ret = -ERR(EIO);
 		goto out;
 	}
 
@@ -464,7 +464,7 @@ static int nvme_nvm_identity(struct nvm_dev *nvmdev)
 	default:
 		dev_err(ns->ctrl->device, "OCSSD revision not supported (%d)\n",
 							id->ver_id);
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 	}
 
 out:
@@ -491,31 +491,31 @@ static int nvme_nvm_get_bb_tbl(struct nvm_dev *nvmdev, struct ppa_addr ppa,
 
 	bb_tbl = kzalloc(tblsz, GFP_KERNEL);
 	if (!bb_tbl)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	ret = nvme_submit_sync_cmd(ctrl->admin_q, (struct nvme_command *)&c,
 								bb_tbl, tblsz);
 	if (ret) {
 		dev_err(ctrl->device, "get bad block table failed (%d)\n", ret);
-		ret = -EIO;
+		ret = -ERR(EIO);
 		goto out;
 	}
 
 	if (bb_tbl->tblid[0] != 'B' || bb_tbl->tblid[1] != 'B' ||
 		bb_tbl->tblid[2] != 'L' || bb_tbl->tblid[3] != 'T') {
 		dev_err(ctrl->device, "bbt format mismatch\n");
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto out;
 	}
 
 	if (le16_to_cpu(bb_tbl->verid) != 1) {
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		dev_err(ctrl->device, "bbt version not supported\n");
 		goto out;
 	}
 
 	if (le32_to_cpu(bb_tbl->tblks) != nr_blks) {
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		dev_err(ctrl->device,
 				"bbt unsuspected blocks returned (%u!=%u)",
 				le32_to_cpu(bb_tbl->tblks), nr_blks);
@@ -574,7 +574,7 @@ static int nvme_nvm_get_chk_meta(struct nvm_dev *ndev,
 
 	dev_meta = kmalloc(max_len, GFP_KERNEL);
 	if (!dev_meta)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	/* Normalize lba address space to obtain log offset */
 	ppa.ppa = slba;
@@ -678,7 +678,7 @@ static int nvme_nvm_submit_io(struct nvm_dev *dev, struct nvm_rq *rqd,
 
 	cmd = kzalloc(sizeof(struct nvme_nvm_command), GFP_KERNEL);
 	if (!cmd)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	rq = nvme_nvm_alloc_request(q, rqd, cmd);
 	if (IS_ERR(rq)) {
@@ -770,7 +770,7 @@ static int nvme_nvm_submit_user_cmd(struct request_queue *q,
 	rq = nvme_alloc_request(q, (struct nvme_command *)vcmd, 0,
 			NVME_QID_ANY);
 	if (IS_ERR(rq)) {
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto err_cmd;
 	}
 
@@ -779,12 +779,12 @@ static int nvme_nvm_submit_user_cmd(struct request_queue *q,
 	if (ppa_buf && ppa_len) {
 		ppa_list = dma_pool_alloc(dev->dma_pool, GFP_KERNEL, &ppa_dma);
 		if (!ppa_list) {
-			ret = -ENOMEM;
+			ret = -ERR(ENOMEM);
 			goto err_rq;
 		}
 		if (copy_from_user(ppa_list, (void __user *)ppa_buf,
 						sizeof(u64) * (ppa_len + 1))) {
-			ret = -EFAULT;
+			ret = -ERR(EFAULT);
 			goto err_ppa;
 		}
 		vcmd->ph_rw.spba = cpu_to_le64(ppa_dma);
@@ -802,7 +802,7 @@ static int nvme_nvm_submit_user_cmd(struct request_queue *q,
 			metadata = dma_pool_alloc(dev->dma_pool, GFP_KERNEL,
 								&metadata_dma);
 			if (!metadata) {
-				ret = -ENOMEM;
+				ret = -ERR(ENOMEM);
 				goto err_map;
 			}
 
@@ -810,7 +810,7 @@ static int nvme_nvm_submit_user_cmd(struct request_queue *q,
 				if (copy_from_user(metadata,
 						(void __user *)meta_buf,
 						meta_len)) {
-					ret = -EFAULT;
+					ret = -ERR(EFAULT);
 					goto err_meta;
 				}
 			}
@@ -823,9 +823,9 @@ static int nvme_nvm_submit_user_cmd(struct request_queue *q,
 	blk_execute_rq(q, NULL, rq, 0);
 
 	if (nvme_req(rq)->flags & NVME_REQ_CANCELLED)
-		ret = -EINTR;
+		ret = -ERR(EINTR);
 	else if (nvme_req(rq)->status & 0x7ff)
-		ret = -EIO;
+		ret = -ERR(EIO);
 	if (result)
 		*result = nvme_req(rq)->status & 0x7ff;
 	if (status)
@@ -833,7 +833,7 @@ static int nvme_nvm_submit_user_cmd(struct request_queue *q,
 
 	if (metadata && !ret && !write) {
 		if (copy_to_user(meta_buf, (void *)metadata, meta_len))
-			ret = -EFAULT;
+			ret = -ERR(EFAULT);
 	}
 err_meta:
 	if (meta_buf && meta_len)
@@ -859,9 +859,9 @@ static int nvme_nvm_submit_vio(struct nvme_ns *ns,
 	int ret;
 
 	if (copy_from_user(&vio, uvio, sizeof(vio)))
-		return -EFAULT;
+		return -ERR(EFAULT);
 	if (vio.flags)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	memset(&c, 0, sizeof(c));
 	c.ph_rw.opcode = vio.opcode;
@@ -879,7 +879,7 @@ static int nvme_nvm_submit_vio(struct nvme_ns *ns,
 			&vio.result, &vio.status, 0);
 
 	if (ret && copy_to_user(uvio, &vio, sizeof(vio)))
-		return -EFAULT;
+		return -ERR(EFAULT);
 
 	return ret;
 }
@@ -894,11 +894,11 @@ static int nvme_nvm_user_vcmd(struct nvme_ns *ns, int admin,
 	int ret;
 
 	if (copy_from_user(&vcmd, uvcmd, sizeof(vcmd)))
-		return -EFAULT;
+		return -ERR(EFAULT);
 	if ((vcmd.opcode != 0xF2) && (!capable(CAP_SYS_ADMIN)))
-		return -EACCES;
+		return -ERR(EACCES);
 	if (vcmd.flags)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	memset(&c, 0, sizeof(c));
 	c.common.opcode = vcmd.opcode;
@@ -926,7 +926,7 @@ static int nvme_nvm_user_vcmd(struct nvme_ns *ns, int admin,
 			&vcmd.result, &vcmd.status, timeout);
 
 	if (ret && copy_to_user(uvcmd, &vcmd, sizeof(vcmd)))
-		return -EFAULT;
+		return -ERR(EFAULT);
 
 	return ret;
 }
@@ -941,7 +941,7 @@ int nvme_nvm_ioctl(struct nvme_ns *ns, unsigned int cmd, unsigned long arg)
 	case NVME_NVM_IOCTL_SUBMIT_VIO:
 		return nvme_nvm_submit_vio(ns, (void __user *)arg);
 	default:
-		return -ENOTTY;
+		return -ERR(ENOTTY);
 	}
 }
 
@@ -955,7 +955,7 @@ int nvme_nvm_register(struct nvme_ns *ns, char *disk_name, int node)
 
 	dev = nvm_alloc_dev(node);
 	if (!dev)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	/* Note that csecs and sos will be overridden if it is a 1.2 drive. */
 	geo = &dev->geo;
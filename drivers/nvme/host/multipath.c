@@ -402,7 +402,7 @@ int nvme_mpath_alloc_disk(struct nvme_ctrl *ctrl, struct nvme_ns_head *head)
 out_cleanup_queue:
 	blk_cleanup_queue(q);
 out:
-	return -ENOMEM;
+	return -ERR(ENOMEM);
 }
 
 static void nvme_mpath_set_live(struct nvme_ns *ns)
@@ -447,23 +447,23 @@ static int nvme_parse_ana_log(struct nvme_ctrl *ctrl, void *data,
 		size_t nsid_buf_size;
 
 		if (WARN_ON_ONCE(offset > ctrl->ana_log_size - sizeof(*desc)))
-			return -EINVAL;
+			return -ERR(EINVAL);
 
 		nr_nsids = le32_to_cpu(desc->nnsids);
 		nsid_buf_size = nr_nsids * sizeof(__le32);
 
 		if (WARN_ON_ONCE(desc->grpid == 0))
-			return -EINVAL;
+			return -ERR(EINVAL);
 		if (WARN_ON_ONCE(le32_to_cpu(desc->grpid) > ctrl->anagrpmax))
-			return -EINVAL;
+			return -ERR(EINVAL);
 		if (WARN_ON_ONCE(desc->state == 0))
-			return -EINVAL;
+			return -ERR(EINVAL);
 		if (WARN_ON_ONCE(desc->state > NVME_ANA_CHANGE))
-			return -EINVAL;
+			return -ERR(EINVAL);
 
 		offset += sizeof(*desc);
 		if (WARN_ON_ONCE(offset > ctrl->ana_log_size - nsid_buf_size))
-			return -EINVAL;
+			return -ERR(EINVAL);
 
 		error = cb(ctrl, desc, data);
 		if (error)
@@ -617,7 +617,7 @@ static ssize_t nvme_subsys_iopolicy_store(struct device *dev,
 		}
 	}
 
-	return -EINVAL;
+	return -ERR(EINVAL);
 }
 SUBSYS_ATTR_RW(iopolicy, S_IRUGO | S_IWUSR,
 		      nvme_subsys_iopolicy_show, nvme_subsys_iopolicy_store);
@@ -647,7 +647,7 @@ static int nvme_lookup_ana_group_desc(struct nvme_ctrl *ctrl,
 		return 0;
 
 	*dst = *desc;
-	return -ENXIO; /* just break out of the loop */
+	return -ERR(ENXIO); /* just break out of the loop */
 }
 
 void nvme_mpath_add_disk(struct nvme_ns *ns, struct nvme_id_ns *id)
@@ -735,7 +735,7 @@ int nvme_mpath_init(struct nvme_ctrl *ctrl, struct nvme_id_ctrl *id)
 	kfree(ctrl->ana_log_buf);
 	ctrl->ana_log_buf = kmalloc(ctrl->ana_log_size, GFP_KERNEL);
 	if (!ctrl->ana_log_buf) {
-		error = -ENOMEM;
+		error = -ERR(ENOMEM);
 		goto out;
 	}
 
@@ -75,7 +75,7 @@ static int io_queue_count_set(const char *val, const struct kernel_param *kp)
 
 	ret = kstrtouint(val, 10, &n);
 	if (ret != 0 || n > num_possible_cpus())
-		return -EINVAL;
+		return -ERR(EINVAL);
 	return param_set_uint(val, kp);
 }
 
@@ -155,7 +155,7 @@ static int io_queue_depth_set(const char *val, const struct kernel_param *kp)
 
 	ret = kstrtoint(val, 10, &n);
 	if (ret != 0 || n < 2)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	return param_set_int(val, kp);
 }
@@ -243,7 +243,7 @@ static int nvme_dbbuf_dma_alloc(struct nvme_dev *dev)
 					    &dev->dbbuf_dbs_dma_addr,
 					    GFP_KERNEL);
 	if (!dev->dbbuf_dbs)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	dev->dbbuf_eis = dma_alloc_coherent(dev->dev, mem_size,
 					    &dev->dbbuf_eis_dma_addr,
 					    GFP_KERNEL);
@@ -251,7 +251,7 @@ static int nvme_dbbuf_dma_alloc(struct nvme_dev *dev)
 		dma_free_coherent(dev->dev, mem_size,
 				  dev->dbbuf_dbs, dev->dbbuf_dbs_dma_addr);
 		dev->dbbuf_dbs = NULL;
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 
 	return 0;
@@ -1410,7 +1410,7 @@ static int nvme_cmb_qdepth(struct nvme_dev *dev, int nr_io_queues,
 		 * original depth
 		 */
 		if (q_depth < 64)
-			return -ENOMEM;
+			return -ERR(ENOMEM);
 	}
 
 	return q_depth;
@@ -1438,7 +1438,7 @@ static int nvme_alloc_sq_cmds(struct nvme_dev *dev, struct nvme_queue *nvmeq,
 	nvmeq->sq_cmds = dma_alloc_coherent(dev->dev, SQ_SIZE(nvmeq),
 				&nvmeq->sq_dma_addr, GFP_KERNEL);
 	if (!nvmeq->sq_cmds)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	return 0;
 }
 
@@ -1474,7 +1474,7 @@ static int nvme_alloc_queue(struct nvme_dev *dev, int qid, int depth)
 	dma_free_coherent(dev->dev, CQ_SIZE(nvmeq), (void *)nvmeq->cqes,
 			  nvmeq->cq_dma_addr);
  free_nvmeq:
-	return -ENOMEM;
+	return -ERR(ENOMEM);
 }
 
 static int queue_request_irq(struct nvme_queue *nvmeq)
@@ -1599,18 +1599,18 @@ static int nvme_alloc_admin_tags(struct nvme_dev *dev)
 		dev->admin_tagset.driver_data = dev;
 
 		if (blk_mq_alloc_tag_set(&dev->admin_tagset))
-			return -ENOMEM;
+			return -ERR(ENOMEM);
 		dev->ctrl.admin_tagset = &dev->admin_tagset;
 
 		dev->ctrl.admin_q = blk_mq_init_queue(&dev->admin_tagset);
 		if (IS_ERR(dev->ctrl.admin_q)) {
 			blk_mq_free_tag_set(&dev->admin_tagset);
-			return -ENOMEM;
+			return -ERR(ENOMEM);
 		}
 		if (!blk_get_queue(dev->ctrl.admin_q)) {
 			nvme_dev_remove_admin(dev);
 			dev->ctrl.admin_q = NULL;
-			return -ENODEV;
+			return -ERR(ENODEV);
 		}
 	} else
 		blk_mq_unquiesce_queue(dev->ctrl.admin_q);
@@ -1630,13 +1630,13 @@ static int nvme_remap_bar(struct nvme_dev *dev, unsigned long size)
 	if (size <= dev->bar_mapped_size)
 		return 0;
 	if (size > pci_resource_len(pdev, 0))
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	if (dev->bar)
 		iounmap(dev->bar);
 	dev->bar = ioremap(pci_resource_start(pdev, 0), size);
 	if (!dev->bar) {
 		dev->bar_mapped_size = 0;
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 	dev->bar_mapped_size = size;
 	dev->dbs = dev->bar + NVME_REG_DBS;
@@ -1702,7 +1702,7 @@ static int nvme_create_io_queues(struct nvme_dev *dev)
 
 	for (i = dev->ctrl.queue_count; i <= dev->max_qid; i++) {
 		if (nvme_alloc_queue(dev, i, dev->q_depth)) {
-			ret = -ENOMEM;
+			ret = -ERR(ENOMEM);
 			break;
 		}
 	}
@@ -1926,7 +1926,7 @@ static int __nvme_alloc_host_mem(struct nvme_dev *dev, u64 preferred,
 			descs_dma);
 out:
 	dev->host_mem_descs = NULL;
-	return -ENOMEM;
+	return -ERR(ENOMEM);
 }
 
 static int nvme_alloc_host_mem(struct nvme_dev *dev, u64 min, u64 preferred)
@@ -1944,7 +1944,7 @@ static int nvme_alloc_host_mem(struct nvme_dev *dev, u64 min, u64 preferred)
 		}
 	}
 
-	return -ENOMEM;
+	return -ERR(ENOMEM);
 }
 
 static int nvme_setup_host_mem(struct nvme_dev *dev)
@@ -2128,7 +2128,7 @@ static int nvme_setup_io_queues(struct nvme_dev *dev)
 		if (!result)
 			break;
 		if (!--nr_io_queues)
-			return -ENOMEM;
+			return -ERR(ENOMEM);
 	} while (1);
 	adminq->q_db = dev->dbs;
 
@@ -2144,7 +2144,7 @@ static int nvme_setup_io_queues(struct nvme_dev *dev)
 
 	result = nvme_setup_irqs(dev, nr_io_queues);
 	if (result <= 0)
-		return -EIO;
+		return -ERR(EIO);
 
 	dev->num_vecs = result;
 	result = max(result - 1, 1);
@@ -2293,7 +2293,7 @@ static void nvme_dev_add(struct nvme_dev *dev)
 
 static int nvme_pci_enable(struct nvme_dev *dev)
 {
-	int result = -ENOMEM;
+	int result = -ERR(ENOMEM);
 	struct pci_dev *pdev = to_pci_dev(dev->dev);
 
 	if (pci_enable_device_mem(pdev))
@@ -2305,7 +2305,7 @@ static int nvme_pci_enable(struct nvme_dev *dev)
 		goto disable;
 
 	if (readl(dev->bar + NVME_REG_CSTS) == -1) {
-		result = -ENODEV;
+		result = -ERR(ENODEV);
 		goto disable;
 	}
 
@@ -2452,7 +2452,7 @@ static void nvme_dev_disable(struct nvme_dev *dev, bool shutdown)
 static int nvme_disable_prepare_reset(struct nvme_dev *dev, bool shutdown)
 {
 	if (!nvme_wait_reset(&dev->ctrl))
-		return -EBUSY;
+		return -ERR(EBUSY);
 	nvme_dev_disable(dev, shutdown);
 	return 0;
 }
@@ -2462,14 +2462,14 @@ static int nvme_setup_prp_pools(struct nvme_dev *dev)
 	dev->prp_page_pool = dma_pool_create("prp list page", dev->dev,
 						PAGE_SIZE, PAGE_SIZE, 0);
 	if (!dev->prp_page_pool)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	/* Optimisation for I/Os between 4k and 128k */
 	dev->prp_small_pool = dma_pool_create("prp list 256", dev->dev,
 						256, 256, 0);
 	if (!dev->prp_small_pool) {
 		dma_pool_destroy(dev->prp_page_pool);
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 	return 0;
 }
@@ -2524,7 +2524,7 @@ static void nvme_reset_work(struct work_struct *work)
 	int result;
 
 	if (WARN_ON(dev->ctrl.state != NVME_CTRL_RESETTING)) {
-		result = -ENODEV;
+		result = -ERR(ENODEV);
 		goto out;
 	}
 
@@ -2571,7 +2571,7 @@ static void nvme_reset_work(struct work_struct *work)
 	if (!nvme_change_ctrl_state(&dev->ctrl, NVME_CTRL_CONNECTING)) {
 		dev_warn(dev->ctrl.device,
 			"failed to mark controller CONNECTING\n");
-		result = -EBUSY;
+		result = -ERR(EBUSY);
 		goto out;
 	}
 
@@ -2636,7 +2636,7 @@ static void nvme_reset_work(struct work_struct *work)
 	if (!nvme_change_ctrl_state(&dev->ctrl, NVME_CTRL_LIVE)) {
 		dev_warn(dev->ctrl.device,
 			"failed to mark controller live state\n");
-		result = -ENODEV;
+		result = -ERR(ENODEV);
 		goto out;
 	}
 
@@ -2705,7 +2705,7 @@ static int nvme_dev_map(struct nvme_dev *dev)
 	struct pci_dev *pdev = to_pci_dev(dev->dev);
 
 	if (pci_request_mem_regions(pdev, "nvme"))
-		return -ENODEV;
+		return -ERR(ENODEV);
 
 	if (nvme_remap_bar(dev, NVME_REG_DBS + 4096))
 		goto release;
@@ -2713,7 +2713,7 @@ static int nvme_dev_map(struct nvme_dev *dev)
 	return 0;
   release:
 	pci_release_mem_regions(pdev);
-	return -ENODEV;
+	return -ERR(ENODEV);
 }
 
 static unsigned long check_vendor_combination_bug(struct pci_dev *pdev)
@@ -2781,7 +2781,7 @@ static int nvme_probe(struct pci_dev *pdev, const struct pci_device_id *id)
 
 	dev = kzalloc_node(sizeof(*dev), GFP_KERNEL, node);
 	if (!dev)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	dev->nr_write_queues = write_queues;
 	dev->nr_poll_queues = poll_queues;
@@ -2821,7 +2821,7 @@ static int nvme_probe(struct pci_dev *pdev, const struct pci_device_id *id)
 						(void *) alloc_size,
 						GFP_KERNEL, node);
 	if (!dev->iod_mempool) {
-		result = -ENOMEM;
+		result = -ERR(ENOMEM);
 		goto release_pools;
 	}
 
@@ -2936,7 +2936,7 @@ static int nvme_suspend(struct device *dev)
 	struct pci_dev *pdev = to_pci_dev(dev);
 	struct nvme_dev *ndev = pci_get_drvdata(pdev);
 	struct nvme_ctrl *ctrl = &ndev->ctrl;
-	int ret = -EBUSY;
+	int ret = -ERR(EBUSY);
 
 	ndev->last_ps = U32_MAX;
 
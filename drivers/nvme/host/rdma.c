@@ -182,13 +182,13 @@ static int nvme_rdma_alloc_qe(struct ib_device *ibdev, struct nvme_rdma_qe *qe,
 {
 	qe->data = kzalloc(capsule_size, GFP_KERNEL);
 	if (!qe->data)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	qe->dma = ib_dma_map_single(ibdev, qe->data, capsule_size, dir);
 	if (ib_dma_mapping_error(ibdev, qe->dma)) {
 		kfree(qe->data);
 		qe->data = NULL;
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 
 	return 0;
@@ -249,7 +249,7 @@ static int nvme_rdma_wait_for_cm(struct nvme_rdma_queue *queue)
 	if (ret < 0)
 		return ret;
 	if (ret == 0)
-		return -ETIMEDOUT;
+		return -ERR(ETIMEDOUT);
 	WARN_ON_ONCE(queue->cm_error > 0);
 	return queue->cm_error;
 }
@@ -301,7 +301,7 @@ static int nvme_rdma_init_request(struct blk_mq_tag_set *set,
 	nvme_req(rq)->ctrl = &ctrl->ctrl;
 	req->sqe.data = kzalloc(sizeof(struct nvme_command), GFP_KERNEL);
 	if (!req->sqe.data)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	/* metadata nvme_rdma_sgl struct is located after command's data SGL */
 	if (queue->pi_support)
@@ -462,7 +462,7 @@ static int nvme_rdma_create_queue_ib(struct nvme_rdma_queue *queue)
 	if (!queue->device) {
 		dev_err(queue->cm_id->device->dev.parent,
 			"no client data found!\n");
-		return -ECONNREFUSED;
+		return -ERR(ECONNREFUSED);
 	}
 	ibdev = queue->device->dev;
 
@@ -494,7 +494,7 @@ static int nvme_rdma_create_queue_ib(struct nvme_rdma_queue *queue)
 	queue->rsp_ring = nvme_rdma_alloc_ring(ibdev, queue->queue_size,
 			sizeof(struct nvme_completion), DMA_FROM_DEVICE);
 	if (!queue->rsp_ring) {
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto out_destroy_qp;
 	}
 
@@ -1033,7 +1033,7 @@ static void nvme_rdma_reconnect_or_remove(struct nvme_rdma_ctrl *ctrl)
 
 static int nvme_rdma_setup_ctrl(struct nvme_rdma_ctrl *ctrl, bool new)
 {
-	int ret = -EINVAL;
+	int ret = -ERR(EINVAL);
 	bool changed;
 
 	ret = nvme_rdma_configure_admin_queue(ctrl, new);
@@ -1082,7 +1082,7 @@ static int nvme_rdma_setup_ctrl(struct nvme_rdma_ctrl *ctrl, bool new)
 		 */
 		WARN_ON_ONCE(ctrl->ctrl.state != NVME_CTRL_DELETING);
 		WARN_ON_ONCE(new);
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto destroy_io;
 	}
 
@@ -1290,7 +1290,7 @@ static int nvme_rdma_map_sg_fr(struct nvme_rdma_queue *queue,
 
 	req->mr = ib_mr_pool_get(queue->qp, &queue->qp->rdma_mrs);
 	if (WARN_ON_ONCE(!req->mr))
-		return -EAGAIN;
+		return -ERR(EAGAIN);
 
 	/*
 	 * Align the MR to a 4K page size to match the ctrl page size and
@@ -1303,7 +1303,7 @@ static int nvme_rdma_map_sg_fr(struct nvme_rdma_queue *queue,
 		req->mr = NULL;
 		if (nr < 0)
 			return nr;
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 
 	ib_update_fast_reg_key(req->mr, ib_inc_rkey(req->mr->rkey));
@@ -1399,7 +1399,7 @@ static int nvme_rdma_map_sg_pi(struct nvme_rdma_queue *queue,
 
 	req->mr = ib_mr_pool_get(queue->qp, &queue->qp->sig_mrs);
 	if (WARN_ON_ONCE(!req->mr))
-		return -EAGAIN;
+		return -ERR(EAGAIN);
 
 	nr = ib_map_mr_sg_pi(req->mr, sgl->sg_table.sgl, count, NULL,
 			     req->metadata_sgl->sg_table.sgl, pi_count, NULL,
@@ -1437,7 +1437,7 @@ static int nvme_rdma_map_sg_pi(struct nvme_rdma_queue *queue,
 	req->mr = NULL;
 	if (nr < 0)
 		return nr;
-	return -EINVAL;
+	return -ERR(EINVAL);
 }
 
 static int nvme_rdma_map_data(struct nvme_rdma_queue *queue,
@@ -1462,7 +1462,7 @@ static int nvme_rdma_map_data(struct nvme_rdma_queue *queue,
 			blk_rq_nr_phys_segments(rq), req->data_sgl.sg_table.sgl,
 			NVME_INLINE_SG_CNT);
 	if (ret)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	req->data_sgl.nents = blk_rq_map_sg(rq->q, rq,
 					    req->data_sgl.sg_table.sgl);
@@ -1470,7 +1470,7 @@ static int nvme_rdma_map_data(struct nvme_rdma_queue *queue,
 	count = ib_dma_map_sg(ibdev, req->data_sgl.sg_table.sgl,
 			      req->data_sgl.nents, rq_dma_dir(rq));
 	if (unlikely(count <= 0)) {
-		ret = -EIO;
+		ret = -ERR(EIO);
 		goto out_free_table;
 	}
 
@@ -1482,7 +1482,7 @@ static int nvme_rdma_map_data(struct nvme_rdma_queue *queue,
 				req->metadata_sgl->sg_table.sgl,
 				NVME_INLINE_METADATA_SG_CNT);
 		if (unlikely(ret)) {
-			ret = -ENOMEM;
+			ret = -ERR(ENOMEM);
 			goto out_unmap_sg;
 		}
 
@@ -1493,7 +1493,7 @@ static int nvme_rdma_map_data(struct nvme_rdma_queue *queue,
 					 req->metadata_sgl->nents,
 					 rq_dma_dir(rq));
 		if (unlikely(pi_count <= 0)) {
-			ret = -EIO;
+			ret = -ERR(EIO);
 			goto out_free_pi_table;
 		}
 	}
@@ -1773,7 +1773,7 @@ static int nvme_rdma_conn_rejected(struct nvme_rdma_queue *queue,
 			"Connect rejected: status %d (%s).\n", status, rej_msg);
 	}
 
-	return -ECONNRESET;
+	return -ERR(ECONNRESET);
 }
 
 static int nvme_rdma_addr_resolved(struct nvme_rdma_queue *queue)
@@ -1885,7 +1885,7 @@ static int nvme_rdma_cm_handler(struct rdma_cm_id *cm_id,
 	case RDMA_CM_EVENT_ADDR_ERROR:
 		dev_dbg(queue->ctrl->ctrl.device,
 			"CM error event %d\n", ev->event);
-		cm_error = -ECONNRESET;
+		cm_error = -ERR(ECONNRESET);
 		break;
 	case RDMA_CM_EVENT_DISCONNECTED:
 	case RDMA_CM_EVENT_ADDR_CHANGE:
@@ -2241,7 +2241,7 @@ static struct nvme_ctrl *nvme_rdma_create_ctrl(struct device *dev,
 
 	ctrl = kzalloc(sizeof(*ctrl), GFP_KERNEL);
 	if (!ctrl)
-		return ERR_PTR(-ENOMEM);
+		return ERR_PTR(-ERR(ENOMEM));
 	ctrl->ctrl.opts = opts;
 	INIT_LIST_HEAD(&ctrl->list);
 
@@ -2249,7 +2249,7 @@ static struct nvme_ctrl *nvme_rdma_create_ctrl(struct device *dev,
 		opts->trsvcid =
 			kstrdup(__stringify(NVME_RDMA_IP_PORT), GFP_KERNEL);
 		if (!opts->trsvcid) {
-			ret = -ENOMEM;
+			ret = -ERR(ENOMEM);
 			goto out_free_ctrl;
 		}
 		opts->mask |= NVMF_OPT_TRSVCID;
@@ -2274,7 +2274,7 @@ static struct nvme_ctrl *nvme_rdma_create_ctrl(struct device *dev,
 	}
 
 	if (!opts->duplicate_connect && nvme_rdma_existing_controller(opts)) {
-		ret = -EALREADY;
+		ret = -ERR(EALREADY);
 		goto out_free_ctrl;
 	}
 
@@ -2288,7 +2288,7 @@ static struct nvme_ctrl *nvme_rdma_create_ctrl(struct device *dev,
 	ctrl->ctrl.sqsize = opts->queue_size - 1;
 	ctrl->ctrl.kato = opts->kato;
 
-	ret = -ENOMEM;
+	ret = -ERR(ENOMEM);
 	ctrl->queues = kcalloc(ctrl->ctrl.queue_count, sizeof(*ctrl->queues),
 				GFP_KERNEL);
 	if (!ctrl->queues)
@@ -2319,7 +2319,7 @@ static struct nvme_ctrl *nvme_rdma_create_ctrl(struct device *dev,
 	nvme_uninit_ctrl(&ctrl->ctrl);
 	nvme_put_ctrl(&ctrl->ctrl);
 	if (ret > 0)
-		ret = -EIO;
+		ret = -ERR(EIO);
 	return ERR_PTR(ret);
 out_kfree_queues:
 	kfree(ctrl->queues);
@@ -339,7 +339,7 @@ static int nvme_tcp_verify_hdgst(struct nvme_tcp_queue *queue,
 		dev_err(queue->ctrl->ctrl.device,
 			"queue %d: header digest flag is cleared\n",
 			nvme_tcp_queue_id(queue));
-		return -EPROTO;
+		return -ERR(EPROTO);
 	}
 
 	recv_digest = *(__le32 *)(pdu + hdr->hlen);
@@ -349,7 +349,7 @@ static int nvme_tcp_verify_hdgst(struct nvme_tcp_queue *queue,
 		dev_err(queue->ctrl->ctrl.device,
 			"header digest error: recv %#x expected %#x\n",
 			le32_to_cpu(recv_digest), le32_to_cpu(exp_digest));
-		return -EIO;
+		return -ERR(EIO);
 	}
 
 	return 0;
@@ -368,7 +368,7 @@ static int nvme_tcp_check_ddgst(struct nvme_tcp_queue *queue, void *pdu)
 		dev_err(queue->ctrl->ctrl.device,
 			"queue %d: data digest flag is cleared\n",
 		nvme_tcp_queue_id(queue));
-		return -EPROTO;
+		return -ERR(EPROTO);
 	}
 	crypto_ahash_init(queue->rcv_hash);
 
@@ -397,7 +397,7 @@ static int nvme_tcp_init_request(struct blk_mq_tag_set *set,
 		sizeof(struct nvme_tcp_cmd_pdu) + hdgst,
 		GFP_KERNEL | __GFP_ZERO);
 	if (!req->pdu)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	req->queue = queue;
 	nvme_req(rq)->ctrl = &ctrl->ctrl;
@@ -461,7 +461,7 @@ static int nvme_tcp_process_nvme_cqe(struct nvme_tcp_queue *queue,
 			"queue %d tag 0x%x not found\n",
 			nvme_tcp_queue_id(queue), cqe->command_id);
 		nvme_tcp_error_recovery(&queue->ctrl->ctrl);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 
 	nvme_end_request(rq, cqe->status, cqe->result);
@@ -480,14 +480,14 @@ static int nvme_tcp_handle_c2h_data(struct nvme_tcp_queue *queue,
 		dev_err(queue->ctrl->ctrl.device,
 			"queue %d tag %#x not found\n",
 			nvme_tcp_queue_id(queue), pdu->command_id);
-		return -ENOENT;
+		return -ERR(ENOENT);
 	}
 
 	if (!blk_rq_payload_bytes(rq)) {
 		dev_err(queue->ctrl->ctrl.device,
 			"queue %d tag %#x unexpected data\n",
 			nvme_tcp_queue_id(queue), rq->tag);
-		return -EIO;
+		return -ERR(EIO);
 	}
 
 	queue->data_remaining = le32_to_cpu(pdu->data_length);
@@ -498,7 +498,7 @@ static int nvme_tcp_handle_c2h_data(struct nvme_tcp_queue *queue,
 			"queue %d tag %#x SUCCESS set but not last PDU\n",
 			nvme_tcp_queue_id(queue), rq->tag);
 		nvme_tcp_error_recovery(&queue->ctrl->ctrl);
-		return -EPROTO;
+		return -ERR(EPROTO);
 	}
 
 	return 0;
@@ -543,7 +543,7 @@ static int nvme_tcp_setup_h2c_data_pdu(struct nvme_tcp_request *req,
 			"req %d r2t len %u exceeded data len %u (%zu sent)\n",
 			rq->tag, req->pdu_len, req->data_len,
 			req->data_sent);
-		return -EPROTO;
+		return -ERR(EPROTO);
 	}
 
 	if (unlikely(le32_to_cpu(pdu->r2t_offset) < req->data_sent)) {
@@ -551,7 +551,7 @@ static int nvme_tcp_setup_h2c_data_pdu(struct nvme_tcp_request *req,
 			"req %d unexpected r2t offset %u (expected %zu)\n",
 			rq->tag, le32_to_cpu(pdu->r2t_offset),
 			req->data_sent);
-		return -EPROTO;
+		return -ERR(EPROTO);
 	}
 
 	memset(data, 0, sizeof(*data));
@@ -584,7 +584,7 @@ static int nvme_tcp_handle_r2t(struct nvme_tcp_queue *queue,
 		dev_err(queue->ctrl->ctrl.device,
 			"queue %d tag %#x not found\n",
 			nvme_tcp_queue_id(queue), pdu->command_id);
-		return -ENOENT;
+		return -ERR(ENOENT);
 	}
 	req = blk_mq_rq_to_pdu(rq);
 
@@ -646,7 +646,7 @@ static int nvme_tcp_recv_pdu(struct nvme_tcp_queue *queue, struct sk_buff *skb,
 	default:
 		dev_err(queue->ctrl->ctrl.device,
 			"unsupported pdu type (%d)\n", hdr->type);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 }
 
@@ -669,7 +669,7 @@ static int nvme_tcp_recv_data(struct nvme_tcp_queue *queue, struct sk_buff *skb,
 		dev_err(queue->ctrl->ctrl.device,
 			"queue %d tag %#x not found\n",
 			nvme_tcp_queue_id(queue), pdu->command_id);
-		return -ENOENT;
+		return -ERR(ENOENT);
 	}
 	req = blk_mq_rq_to_pdu(rq);
 
@@ -692,7 +692,7 @@ static int nvme_tcp_recv_data(struct nvme_tcp_queue *queue, struct sk_buff *skb,
 					"queue %d no space in request %#x",
 					nvme_tcp_queue_id(queue), rq->tag);
 				nvme_tcp_init_recv_ctx(queue);
-				return -EIO;
+				return -ERR(EIO);
 			}
 			nvme_tcp_init_iter(req, READ);
 		}
@@ -759,7 +759,7 @@ static int nvme_tcp_recv_ddgst(struct nvme_tcp_queue *queue,
 			"data digest error: recv %#x expected %#x\n",
 			le32_to_cpu(queue->recv_ddgst),
 			le32_to_cpu(queue->exp_ddgst));
-		return -EIO;
+		return -ERR(EIO);
 	}
 
 	if (pdu->hdr.flags & NVME_TCP_F_DATA_SUCCESS) {
@@ -793,7 +793,7 @@ static int nvme_tcp_recv_skb(read_descriptor_t *desc, struct sk_buff *skb,
 			result = nvme_tcp_recv_ddgst(queue, skb, &offset, &len);
 			break;
 		default:
-			result = -EFAULT;
+			result = -ERR(EFAULT);
 		}
 		if (result) {
 			dev_err(queue->ctrl->ctrl.device,
@@ -916,7 +916,7 @@ static int nvme_tcp_try_send_data(struct nvme_tcp_request *req)
 			return 1;
 		}
 	}
-	return -EAGAIN;
+	return -ERR(EAGAIN);
 }
 
 static int nvme_tcp_try_send_cmd_pdu(struct nvme_tcp_request *req)
@@ -956,7 +956,7 @@ static int nvme_tcp_try_send_cmd_pdu(struct nvme_tcp_request *req)
 	}
 	req->offset += ret;
 
-	return -EAGAIN;
+	return -ERR(EAGAIN);
 }
 
 static int nvme_tcp_try_send_data_pdu(struct nvme_tcp_request *req)
@@ -987,7 +987,7 @@ static int nvme_tcp_try_send_data_pdu(struct nvme_tcp_request *req)
 	}
 	req->offset += ret;
 
-	return -EAGAIN;
+	return -ERR(EAGAIN);
 }
 
 static int nvme_tcp_try_send_ddgst(struct nvme_tcp_request *req)
@@ -1010,7 +1010,7 @@ static int nvme_tcp_try_send_ddgst(struct nvme_tcp_request *req)
 	}
 
 	req->offset += ret;
-	return -EAGAIN;
+	return -ERR(EAGAIN);
 }
 
 static int nvme_tcp_try_send(struct nvme_tcp_queue *queue)
@@ -1141,7 +1141,7 @@ static int nvme_tcp_alloc_crypto(struct nvme_tcp_queue *queue)
 	ahash_request_free(queue->snd_hash);
 free_tfm:
 	crypto_free_ahash(tfm);
-	return -ENOMEM;
+	return -ERR(ENOMEM);
 }
 
 static void nvme_tcp_free_async_req(struct nvme_tcp_ctrl *ctrl)
@@ -1161,7 +1161,7 @@ static int nvme_tcp_alloc_async_req(struct nvme_tcp_ctrl *ctrl)
 		sizeof(struct nvme_tcp_cmd_pdu) + hdgst,
 		GFP_KERNEL | __GFP_ZERO);
 	if (!async->pdu)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	async->queue = &ctrl->queues[0];
 	return 0;
@@ -1193,11 +1193,11 @@ static int nvme_tcp_init_connection(struct nvme_tcp_queue *queue)
 
 	icreq = kzalloc(sizeof(*icreq), GFP_KERNEL);
 	if (!icreq)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	icresp = kzalloc(sizeof(*icresp), GFP_KERNEL);
 	if (!icresp) {
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto free_icreq;
 	}
 
@@ -1227,7 +1227,7 @@ static int nvme_tcp_init_connection(struct nvme_tcp_queue *queue)
 	if (ret < 0)
 		goto free_icresp;
 
-	ret = -EINVAL;
+	ret = -ERR(EINVAL);
 	if (icresp->hdr.type != nvme_tcp_icresp) {
 		pr_err("queue %d: bad type returned %d\n",
 			nvme_tcp_queue_id(queue), icresp->hdr.type);
@@ -1420,7 +1420,7 @@ static int nvme_tcp_alloc_queue(struct nvme_ctrl *nctrl,
 			nvme_tcp_hdgst_len(queue);
 	queue->pdu = kmalloc(rcv_pdu_size, GFP_KERNEL);
 	if (!queue->pdu) {
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto err_crypto;
 	}
 
@@ -1929,7 +1929,7 @@ static int nvme_tcp_setup_ctrl(struct nvme_ctrl *ctrl, bool new)
 		 */
 		WARN_ON_ONCE(ctrl->state != NVME_CTRL_DELETING);
 		WARN_ON_ONCE(new);
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto destroy_io;
 	}
 
@@ -2362,7 +2362,7 @@ static struct nvme_ctrl *nvme_tcp_create_ctrl(struct device *dev,
 
 	ctrl = kzalloc(sizeof(*ctrl), GFP_KERNEL);
 	if (!ctrl)
-		return ERR_PTR(-ENOMEM);
+		return ERR_PTR(-ERR(ENOMEM));
 
 	INIT_LIST_HEAD(&ctrl->list);
 	ctrl->ctrl.opts = opts;
@@ -2380,7 +2380,7 @@ static struct nvme_ctrl *nvme_tcp_create_ctrl(struct device *dev,
 		opts->trsvcid =
 			kstrdup(__stringify(NVME_TCP_DISC_PORT), GFP_KERNEL);
 		if (!opts->trsvcid) {
-			ret = -ENOMEM;
+			ret = -ERR(ENOMEM);
 			goto out_free_ctrl;
 		}
 		opts->mask |= NVMF_OPT_TRSVCID;
@@ -2405,14 +2405,14 @@ static struct nvme_ctrl *nvme_tcp_create_ctrl(struct device *dev,
 	}
 
 	if (!opts->duplicate_connect && nvme_tcp_existing_controller(opts)) {
-		ret = -EALREADY;
+		ret = -ERR(EALREADY);
 		goto out_free_ctrl;
 	}
 
 	ctrl->queues = kcalloc(ctrl->ctrl.queue_count, sizeof(*ctrl->queues),
 				GFP_KERNEL);
 	if (!ctrl->queues) {
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto out_free_ctrl;
 	}
 
@@ -2422,7 +2422,7 @@ static struct nvme_ctrl *nvme_tcp_create_ctrl(struct device *dev,
 
 	if (!nvme_change_ctrl_state(&ctrl->ctrl, NVME_CTRL_CONNECTING)) {
 		WARN_ON_ONCE(1);
-		ret = -EINTR;
+		ret = -ERR(EINTR);
 		goto out_uninit_ctrl;
 	}
 
@@ -2443,7 +2443,7 @@ static struct nvme_ctrl *nvme_tcp_create_ctrl(struct device *dev,
 	nvme_uninit_ctrl(&ctrl->ctrl);
 	nvme_put_ctrl(&ctrl->ctrl);
 	if (ret > 0)
-		ret = -EIO;
+		ret = -ERR(EIO);
 	return ERR_PTR(ret);
 out_kfree_queues:
 	kfree(ctrl->queues);
@@ -2469,7 +2469,7 @@ static int __init nvme_tcp_init_module(void)
 	nvme_tcp_wq = alloc_workqueue("nvme_tcp_wq",
 			WQ_MEM_RECLAIM | WQ_HIGHPRI, 0);
 	if (!nvme_tcp_wq)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	nvmf_register_transport(&nvme_tcp_transport);
 	return 0;
@@ -73,7 +73,7 @@ static ssize_t nvmet_addr_adrfam_store(struct config_item *item,
 	int i;
 
 	if (nvmet_is_port_enabled(port, __func__))
-		return -EACCES;
+		return -ERR(EACCES);
 
 	for (i = 1; i < ARRAY_SIZE(nvmet_addr_family); i++) {
 		if (sysfs_streq(page, nvmet_addr_family[i].name))
@@ -81,7 +81,7 @@ static ssize_t nvmet_addr_adrfam_store(struct config_item *item,
 	}
 
 	pr_err("Invalid value '%s' for adrfam\n", page);
-	return -EINVAL;
+	return -ERR(EINVAL);
 
 found:
 	port->disc_addr.adrfam = nvmet_addr_family[i].type;
@@ -107,11 +107,11 @@ static ssize_t nvmet_addr_portid_store(struct config_item *item,
 
 	if (kstrtou16(page, 0, &portid)) {
 		pr_err("Invalid value '%s' for portid\n", page);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 
 	if (nvmet_is_port_enabled(port, __func__))
-		return -EACCES;
+		return -ERR(EACCES);
 
 	port->disc_addr.portid = cpu_to_le16(portid);
 	return count;
@@ -135,14 +135,14 @@ static ssize_t nvmet_addr_traddr_store(struct config_item *item,
 
 	if (count > NVMF_TRADDR_SIZE) {
 		pr_err("Invalid value '%s' for traddr\n", page);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 
 	if (nvmet_is_port_enabled(port, __func__))
-		return -EACCES;
+		return -ERR(EACCES);
 
 	if (sscanf(page, "%s\n", port->disc_addr.traddr) != 1)
-		return -EINVAL;
+		return -ERR(EINVAL);
 	return count;
 }
 
@@ -176,7 +176,7 @@ static ssize_t nvmet_addr_treq_store(struct config_item *item,
 	int i;
 
 	if (nvmet_is_port_enabled(port, __func__))
-		return -EACCES;
+		return -ERR(EACCES);
 
 	for (i = 0; i < ARRAY_SIZE(nvmet_addr_treq); i++) {
 		if (sysfs_streq(page, nvmet_addr_treq[i].name))
@@ -184,7 +184,7 @@ static ssize_t nvmet_addr_treq_store(struct config_item *item,
 	}
 
 	pr_err("Invalid value '%s' for treq\n", page);
-	return -EINVAL;
+	return -ERR(EINVAL);
 
 found:
 	treq |= nvmet_addr_treq[i].type;
@@ -210,13 +210,13 @@ static ssize_t nvmet_addr_trsvcid_store(struct config_item *item,
 
 	if (count > NVMF_TRSVCID_SIZE) {
 		pr_err("Invalid value '%s' for trsvcid\n", page);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 	if (nvmet_is_port_enabled(port, __func__))
-		return -EACCES;
+		return -ERR(EACCES);
 
 	if (sscanf(page, "%s\n", port->disc_addr.trsvcid) != 1)
-		return -EINVAL;
+		return -ERR(EINVAL);
 	return count;
 }
 
@@ -237,11 +237,11 @@ static ssize_t nvmet_param_inline_data_size_store(struct config_item *item,
 	int ret;
 
 	if (nvmet_is_port_enabled(port, __func__))
-		return -EACCES;
+		return -ERR(EACCES);
 	ret = kstrtoint(page, 0, &port->inline_data_size);
 	if (ret) {
 		pr_err("Invalid value '%s' for inline_data_size\n", page);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 	return count;
 }
@@ -264,11 +264,11 @@ static ssize_t nvmet_param_pi_enable_store(struct config_item *item,
 	bool val;
 
 	if (strtobool(page, &val))
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	if (port->enabled) {
 		pr_err("Disable port before setting pi_enable value.\n");
-		return -EACCES;
+		return -ERR(EACCES);
 	}
 
 	port->pi_enable = val;
@@ -306,7 +306,7 @@ static ssize_t nvmet_addr_trtype_store(struct config_item *item,
 	int i;
 
 	if (nvmet_is_port_enabled(port, __func__))
-		return -EACCES;
+		return -ERR(EACCES);
 
 	for (i = 0; i < ARRAY_SIZE(nvmet_transport); i++) {
 		if (sysfs_streq(page, nvmet_transport[i].name))
@@ -314,7 +314,7 @@ static ssize_t nvmet_addr_trtype_store(struct config_item *item,
 	}
 
 	pr_err("Invalid value '%s' for trtype\n", page);
-	return -EINVAL;
+	return -ERR(EINVAL);
 
 found:
 	memset(&port->disc_addr.tsas, 0, NVMF_TSAS_SIZE);
@@ -343,17 +343,17 @@ static ssize_t nvmet_ns_device_path_store(struct config_item *item,
 	int ret;
 
 	mutex_lock(&subsys->lock);
-	ret = -EBUSY;
+	ret = -ERR(EBUSY);
 	if (ns->enabled)
 		goto out_unlock;
 
-	ret = -EINVAL;
+	ret = -ERR(EINVAL);
 	len = strcspn(page, "\n");
 	if (!len)
 		goto out_unlock;
 
 	kfree(ns->device_path);
-	ret = -ENOMEM;
+	ret = -ERR(ENOMEM);
 	ns->device_path = kmemdup_nul(page, len, GFP_KERNEL);
 	if (!ns->device_path)
 		goto out_unlock;
@@ -387,7 +387,7 @@ static ssize_t nvmet_ns_p2pmem_store(struct config_item *item,
 
 	mutex_lock(&ns->subsys->lock);
 	if (ns->enabled) {
-		ret = -EBUSY;
+		ret = -ERR(EBUSY);
 		goto out_unlock;
 	}
 
@@ -424,12 +424,12 @@ static ssize_t nvmet_ns_device_uuid_store(struct config_item *item,
 
 	mutex_lock(&subsys->lock);
 	if (ns->enabled) {
-		ret = -EBUSY;
+		ret = -ERR(EBUSY);
 		goto out_unlock;
 	}
 
 	if (uuid_parse(page, &ns->uuid))
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 
 out_unlock:
 	mutex_unlock(&subsys->lock);
@@ -455,17 +455,17 @@ static ssize_t nvmet_ns_device_nguid_store(struct config_item *item,
 
 	mutex_lock(&subsys->lock);
 	if (ns->enabled) {
-		ret = -EBUSY;
+		ret = -ERR(EBUSY);
 		goto out_unlock;
 	}
 
 	for (i = 0; i < 16; i++) {
 		if (p + 2 > page + count) {
-			ret = -EINVAL;
+			ret = -ERR(EINVAL);
 			goto out_unlock;
 		}
 		if (!isxdigit(p[0]) || !isxdigit(p[1])) {
-			ret = -EINVAL;
+			ret = -ERR(EINVAL);
 			goto out_unlock;
 		}
 
@@ -501,7 +501,7 @@ static ssize_t nvmet_ns_ana_grpid_store(struct config_item *item,
 		return ret;
 
 	if (newgrpid < 1 || newgrpid > NVMET_MAX_ANAGRPS)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	down_write(&nvmet_ana_sem);
 	oldgrpid = ns->anagrpid;
@@ -530,7 +530,7 @@ static ssize_t nvmet_ns_enable_store(struct config_item *item,
 	int ret = 0;
 
 	if (strtobool(page, &enable))
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	if (enable)
 		ret = nvmet_ns_enable(ns);
@@ -554,13 +554,13 @@ static ssize_t nvmet_ns_buffered_io_store(struct config_item *item,
 	bool val;
 
 	if (strtobool(page, &val))
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	mutex_lock(&ns->subsys->lock);
 	if (ns->enabled) {
 		pr_err("disable ns before setting buffered_io value.\n");
 		mutex_unlock(&ns->subsys->lock);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 
 	ns->buffered_io = val;
@@ -577,16 +577,16 @@ static ssize_t nvmet_ns_revalidate_size_store(struct config_item *item,
 	bool val;
 
 	if (strtobool(page, &val))
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	if (!val)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	mutex_lock(&ns->subsys->lock);
 	if (!ns->enabled) {
 		pr_err("enable ns before revalidate.\n");
 		mutex_unlock(&ns->subsys->lock);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 	nvmet_ns_revalidate(ns);
 	mutex_unlock(&ns->subsys->lock);
@@ -638,13 +638,13 @@ static struct config_group *nvmet_ns_make(struct config_group *group,
 	if (ret)
 		goto out;
 
-	ret = -EINVAL;
+	ret = -ERR(EINVAL);
 	if (nsid == 0 || nsid == NVME_NSID_ALL) {
 		pr_err("invalid nsid %#x", nsid);
 		goto out;
 	}
 
-	ret = -ENOMEM;
+	ret = -ERR(ENOMEM);
 	ns = nvmet_ns_alloc(subsys, nsid);
 	if (!ns)
 		goto out;
@@ -676,16 +676,16 @@ static int nvmet_port_subsys_allow_link(struct config_item *parent,
 
 	if (target->ci_type != &nvmet_subsys_type) {
 		pr_err("can only link subsystems into the subsystems dir.!\n");
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 	subsys = to_subsys(target);
 	link = kmalloc(sizeof(*link), GFP_KERNEL);
 	if (!link)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	link->subsys = subsys;
 
 	down_write(&nvmet_config_sem);
-	ret = -EEXIST;
+	ret = -ERR(EEXIST);
 	list_for_each_entry(p, &port->subsystems, entry) {
 		if (p->subsys == subsys)
 			goto out_free_link;
@@ -755,23 +755,23 @@ static int nvmet_allowed_hosts_allow_link(struct config_item *parent,
 
 	if (target->ci_type != &nvmet_host_type) {
 		pr_err("can only link hosts into the allowed_hosts directory!\n");
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 
 	host = to_host(target);
 	link = kmalloc(sizeof(*link), GFP_KERNEL);
 	if (!link)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	link->host = host;
 
 	down_write(&nvmet_config_sem);
-	ret = -EINVAL;
+	ret = -ERR(EINVAL);
 	if (subsys->allow_any_host) {
 		pr_err("can't add hosts when allow_any_host is set!\n");
 		goto out_free_link;
 	}
 
-	ret = -EEXIST;
+	ret = -ERR(EEXIST);
 	list_for_each_entry(p, &subsys->hosts, entry) {
 		if (!strcmp(nvmet_host_name(p->host), nvmet_host_name(host)))
 			goto out_free_link;
@@ -835,12 +835,12 @@ static ssize_t nvmet_subsys_attr_allow_any_host_store(struct config_item *item,
 	int ret = 0;
 
 	if (strtobool(page, &allow_any_host))
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	down_write(&nvmet_config_sem);
 	if (allow_any_host && !list_empty(&subsys->hosts)) {
 		pr_err("Can't set allow_any_host when explicit hosts are set!\n");
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto out_unlock;
 	}
 
@@ -881,7 +881,7 @@ static ssize_t nvmet_subsys_attr_version_store(struct config_item *item,
 
 	ret = sscanf(page, "%d.%d.%d\n", &major, &minor, &tertiary);
 	if (ret != 2 && ret != 3)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	down_write(&nvmet_config_sem);
 	subsys->ver = NVME_VS(major, minor, tertiary);
@@ -905,7 +905,7 @@ static ssize_t nvmet_subsys_attr_serial_store(struct config_item *item,
 	u64 serial;
 
 	if (sscanf(page, "%llx\n", &serial) != 1)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	down_write(&nvmet_config_sem);
 	to_subsys(item)->serial = serial;
@@ -927,10 +927,10 @@ static ssize_t nvmet_subsys_attr_cntlid_min_store(struct config_item *item,
 	u16 cntlid_min;
 
 	if (sscanf(page, "%hu\n", &cntlid_min) != 1)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	if (cntlid_min == 0)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	down_write(&nvmet_config_sem);
 	if (cntlid_min >= to_subsys(item)->cntlid_max)
@@ -941,7 +941,7 @@ static ssize_t nvmet_subsys_attr_cntlid_min_store(struct config_item *item,
 
 out_unlock:
 	up_write(&nvmet_config_sem);
-	return -EINVAL;
+	return -ERR(EINVAL);
 }
 CONFIGFS_ATTR(nvmet_subsys_, attr_cntlid_min);
 
@@ -957,10 +957,10 @@ static ssize_t nvmet_subsys_attr_cntlid_max_store(struct config_item *item,
 	u16 cntlid_max;
 
 	if (sscanf(page, "%hu\n", &cntlid_max) != 1)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	if (cntlid_max == 0)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	down_write(&nvmet_config_sem);
 	if (cntlid_max <= to_subsys(item)->cntlid_min)
@@ -971,7 +971,7 @@ static ssize_t nvmet_subsys_attr_cntlid_max_store(struct config_item *item,
 
 out_unlock:
 	up_write(&nvmet_config_sem);
-	return -EINVAL;
+	return -ERR(EINVAL);
 }
 CONFIGFS_ATTR(nvmet_subsys_, attr_cntlid_max);
 
@@ -1009,21 +1009,21 @@ static ssize_t nvmet_subsys_attr_model_store(struct config_item *item,
 
 	len = strcspn(page, "\n");
 	if (!len)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	for (pos = 0; pos < len; pos++) {
 		if (!nvmet_is_ascii(page[pos]))
-			return -EINVAL;
+			return -ERR(EINVAL);
 	}
 
 	new_model_number = kmemdup_nul(page, len, GFP_KERNEL);
 	if (!new_model_number)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	new_model = kzalloc(sizeof(*new_model) + len + 1, GFP_KERNEL);
 	if (!new_model) {
 		kfree(new_model_number);
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 	memcpy(new_model->number, new_model_number, len);
 
@@ -1054,7 +1054,7 @@ static ssize_t nvmet_subsys_attr_pi_enable_store(struct config_item *item,
 	bool pi_enable;
 
 	if (strtobool(page, &pi_enable))
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	subsys->pi_support = pi_enable;
 	return count;
@@ -1103,7 +1103,7 @@ static struct config_group *nvmet_subsys_make(struct config_group *group,
 
 	if (sysfs_streq(name, NVME_DISC_SUBSYS_NAME)) {
 		pr_err("can't create discovery subsystem through configfs\n");
-		return ERR_PTR(-EINVAL);
+		return ERR_PTR(-ERR(EINVAL));
 	}
 
 	subsys = nvmet_subsys_alloc(name, NVME_NQN_NVME);
@@ -1157,7 +1157,7 @@ static ssize_t nvmet_referral_enable_store(struct config_item *item,
 	return count;
 inval:
 	pr_err("Invalid value '%s' for enable\n", page);
-	return -EINVAL;
+	return -ERR(EINVAL);
 }
 
 CONFIGFS_ATTR(nvmet_referral_, enable);
@@ -1209,7 +1209,7 @@ static struct config_group *nvmet_referral_make(
 
 	port = kzalloc(sizeof(*port), GFP_KERNEL);
 	if (!port)
-		return ERR_PTR(-ENOMEM);
+		return ERR_PTR(-ERR(ENOMEM));
 
 	INIT_LIST_HEAD(&port->entry);
 	config_group_init_type_name(&port->group, name, &nvmet_referral_type);
@@ -1263,7 +1263,7 @@ static ssize_t nvmet_ana_group_ana_state_store(struct config_item *item,
 	}
 
 	pr_err("Invalid value '%s' for ana_state\n", page);
-	return -EINVAL;
+	return -ERR(EINVAL);
 
 found:
 	down_write(&nvmet_ana_sem);
@@ -1319,11 +1319,11 @@ static struct config_group *nvmet_ana_groups_make_group(
 	if (ret)
 		goto out;
 
-	ret = -EINVAL;
+	ret = -ERR(EINVAL);
 	if (grpid <= 1 || grpid > NVMET_MAX_ANAGRPS)
 		goto out;
 
-	ret = -ENOMEM;
+	ret = -ERR(ENOMEM);
 	grp = kzalloc(sizeof(*grp), GFP_KERNEL);
 	if (!grp)
 		goto out;
@@ -1395,17 +1395,17 @@ static struct config_group *nvmet_ports_make(struct config_group *group,
 	u32 i;
 
 	if (kstrtou16(name, 0, &portid))
-		return ERR_PTR(-EINVAL);
+		return ERR_PTR(-ERR(EINVAL));
 
 	port = kzalloc(sizeof(*port), GFP_KERNEL);
 	if (!port)
-		return ERR_PTR(-ENOMEM);
+		return ERR_PTR(-ERR(ENOMEM));
 
 	port->ana_state = kcalloc(NVMET_MAX_ANAGRPS + 1,
 			sizeof(*port->ana_state), GFP_KERNEL);
 	if (!port->ana_state) {
 		kfree(port);
-		return ERR_PTR(-ENOMEM);
+		return ERR_PTR(-ERR(ENOMEM));
 	}
 
 	for (i = 1; i <= NVMET_MAX_ANAGRPS; i++) {
@@ -1485,7 +1485,7 @@ static struct config_group *nvmet_hosts_make_group(struct config_group *group,
 
 	host = kzalloc(sizeof(*host), GFP_KERNEL);
 	if (!host)
-		return ERR_PTR(-ENOMEM);
+		return ERR_PTR(-ERR(ENOMEM));
 
 	config_group_init_type_name(&host->group, name, &nvmet_host_type);
 
@@ -280,7 +280,7 @@ int nvmet_register_transport(const struct nvmet_fabrics_ops *ops)
 
 	down_write(&nvmet_config_sem);
 	if (nvmet_transports[ops->type])
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 	else
 		nvmet_transports[ops->type] = ops;
 	up_write(&nvmet_config_sem);
@@ -325,12 +325,12 @@ int nvmet_enable_port(struct nvmet_port *port)
 		if (!ops) {
 			pr_err("transport type %d not supported\n",
 				port->disc_addr.trtype);
-			return -EINVAL;
+			return -ERR(EINVAL);
 		}
 	}
 
 	if (!try_module_get(ops->owner))
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	/*
 	 * If the user requested PI support and the transport isn't pi capable,
@@ -339,7 +339,7 @@ int nvmet_enable_port(struct nvmet_port *port)
 	if (port->pi_enable && !ops->metadata_support) {
 		pr_err("T10-PI is not supported by transport type %d\n",
 		       port->disc_addr.trtype);
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto out_put;
 	}
 
@@ -464,19 +464,19 @@ static int nvmet_p2pmem_ns_enable(struct nvmet_ns *ns)
 
 	if (!ns->bdev) {
 		pr_err("peer-to-peer DMA is not supported by non-block device namespaces\n");
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 
 	if (!blk_queue_pci_p2pdma(ns->bdev->bd_queue)) {
 		pr_err("peer-to-peer DMA is not supported by the driver of %s\n",
 		       ns->device_path);
-		return -EINVAL;
+		return -ERR(EINVAL);
 	}
 
 	if (ns->p2p_dev) {
 		ret = pci_p2pdma_distance(ns->p2p_dev, nvmet_ns_dev(ns), true);
 		if (ret < 0)
-			return -EINVAL;
+			return -ERR(EINVAL);
 	} else {
 		/*
 		 * Right now we just check that there is p2pmem available so
@@ -489,7 +489,7 @@ static int nvmet_p2pmem_ns_enable(struct nvmet_ns *ns)
 		if (!p2p_dev) {
 			pr_err("no peer-to-peer memory is available for %s\n",
 			       ns->device_path);
-			return -EINVAL;
+			return -ERR(EINVAL);
 		}
 
 		pci_dev_put(p2p_dev);
@@ -561,7 +561,7 @@ int nvmet_ns_enable(struct nvmet_ns *ns)
 	if (ns->enabled)
 		goto out_unlock;
 
-	ret = -EMFILE;
+	ret = -ERR(EMFILE);
 	if (subsys->nr_namespaces == NVMET_MAX_NAMESPACES)
 		goto out_unlock;
 
@@ -1017,7 +1017,7 @@ static int nvmet_req_alloc_p2pmem_sgls(struct nvmet_req *req)
 out_free_sg:
 	pci_p2pmem_free_sgl(req->p2p_dev, req->sg);
 out_err:
-	return -ENOMEM;
+	return -ERR(ENOMEM);
 }
 
 static bool nvmet_req_find_p2p_dev(struct nvmet_req *req)
@@ -1057,7 +1057,7 @@ int nvmet_req_alloc_sgls(struct nvmet_req *req)
 out_free:
 	sgl_free(req->sg);
 out:
-	return -ENOMEM;
+	return -ERR(ENOMEM);
 }
 EXPORT_SYMBOL_GPL(nvmet_req_alloc_sgls);
 
@@ -1493,7 +1493,7 @@ struct nvmet_subsys *nvmet_subsys_alloc(const char *subsysnqn,
 
 	subsys = kzalloc(sizeof(*subsys), GFP_KERNEL);
 	if (!subsys)
-		return ERR_PTR(-ENOMEM);
+		return ERR_PTR(-ERR(ENOMEM));
 
 	subsys->ver = NVME_VS(1, 3, 0); /* NVMe 1.3.0 */
 	/* generate a random serial number as our controllers are ephemeral: */
@@ -1509,14 +1509,14 @@ struct nvmet_subsys *nvmet_subsys_alloc(const char *subsysnqn,
 	default:
 		pr_err("%s: Unknown Subsystem type - %d\n", __func__, type);
 		kfree(subsys);
-		return ERR_PTR(-EINVAL);
+		return ERR_PTR(-ERR(EINVAL));
 	}
 	subsys->type = type;
 	subsys->subsysnqn = kstrndup(subsysnqn, NVMF_NQN_SIZE,
 			GFP_KERNEL);
 	if (!subsys->subsysnqn) {
 		kfree(subsys);
-		return ERR_PTR(-ENOMEM);
+		return ERR_PTR(-ERR(ENOMEM));
 	}
 	subsys->cntlid_min = NVME_CNTLID_MIN;
 	subsys->cntlid_max = NVME_CNTLID_MAX;
@@ -1566,7 +1566,7 @@ static int __init nvmet_init(void)
 	buffered_io_wq = alloc_workqueue("nvmet-buffered-io-wq",
 			WQ_MEM_RECLAIM, 0);
 	if (!buffered_io_wq) {
-		error = -ENOMEM;
+		error = -ERR(ENOMEM);
 		goto out;
 	}
 
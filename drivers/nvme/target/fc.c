@@ -384,10 +384,10 @@ __nvmet_fc_send_ls_req(struct nvmet_fc_tgtport *tgtport,
 	int ret = 0;
 
 	if (!tgtport->ops->ls_req)
-		return -EOPNOTSUPP;
+		return -ERR(EOPNOTSUPP);
 
 	if (!nvmet_fc_tgtport_get(tgtport))
-		return -ESHUTDOWN;
+		return -ERR(ESHUTDOWN);
 
 	lsreq->done = done;
 	lsop->req_queued = false;
@@ -397,7 +397,7 @@ __nvmet_fc_send_ls_req(struct nvmet_fc_tgtport *tgtport,
 				  lsreq->rqstlen + lsreq->rsplen,
 				  DMA_BIDIRECTIONAL);
 	if (fc_dma_mapping_error(tgtport->dev, lsreq->rqstdma)) {
-		ret = -EFAULT;
+		ret = -ERR(EFAULT);
 		goto out_puttgtport;
 	}
 	lsreq->rspdma = lsreq->rqstdma + lsreq->rqstlen;
@@ -538,7 +538,7 @@ nvmet_fc_alloc_ls_iodlist(struct nvmet_fc_tgtport *tgtport)
 	iod = kcalloc(NVMET_LS_CTX_COUNT, sizeof(struct nvmet_fc_ls_iod),
 			GFP_KERNEL);
 	if (!iod)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	tgtport->iod = iod;
 
@@ -576,7 +576,7 @@ nvmet_fc_alloc_ls_iodlist(struct nvmet_fc_tgtport *tgtport)
 
 	kfree(iod);
 
-	return -EFAULT;
+	return -ERR(EFAULT);
 }
 
 static void
@@ -1038,7 +1038,7 @@ nvmet_fc_alloc_hostport(struct nvmet_fc_tgtport *tgtport, void *hosthandle)
 
 	/* take reference for what will be the newly allocated hostport */
 	if (!nvmet_fc_tgtport_get(tgtport))
-		return ERR_PTR(-EINVAL);
+		return ERR_PTR(-ERR(EINVAL));
 
 	newhost = kzalloc(sizeof(*newhost), GFP_KERNEL);
 	if (!newhost) {
@@ -1054,7 +1054,7 @@ nvmet_fc_alloc_hostport(struct nvmet_fc_tgtport *tgtport, void *hosthandle)
 		spin_unlock_irqrestore(&tgtport->lock, flags);
 		/* no allocation - release reference */
 		nvmet_fc_tgtport_put(tgtport);
-		return (match) ? match : ERR_PTR(-ENOMEM);
+		return (match) ? match : ERR_PTR(-ERR(ENOMEM));
 	}
 
 	newhost->tgtport = tgtport;
@@ -1362,25 +1362,25 @@ nvmet_fc_register_targetport(struct nvmet_fc_port_info *pinfo,
 	    !template->fcp_req_release || !template->targetport_delete ||
 	    !template->max_hw_queues || !template->max_sgl_segments ||
 	    !template->max_dif_sgl_segments || !template->dma_boundary) {
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto out_regtgt_failed;
 	}
 
 	newrec = kzalloc((sizeof(*newrec) + template->target_priv_sz),
 			 GFP_KERNEL);
 	if (!newrec) {
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto out_regtgt_failed;
 	}
 
 	idx = ida_simple_get(&nvmet_fc_tgtport_cnt, 0, 0, GFP_KERNEL);
 	if (idx < 0) {
-		ret = -ENOSPC;
+		ret = -ERR(ENOSPC);
 		goto out_fail_kfree;
 	}
 
 	if (!get_device(dev) && dev) {
-		ret = -ENODEV;
+		ret = -ERR(ENODEV);
 		goto out_ida_put;
 	}
 
@@ -1407,7 +1407,7 @@ nvmet_fc_register_targetport(struct nvmet_fc_port_info *pinfo,
 
 	ret = nvmet_fc_alloc_ls_iodlist(newrec);
 	if (ret) {
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto out_free_newrec;
 	}
 
@@ -2042,7 +2042,7 @@ nvmet_fc_rcv_ls_req(struct nvmet_fc_target_port *target_port,
 			(w0->ls_cmd <= NVME_FC_LAST_LS_CMD_VALUE) ?
 				nvmefc_ls_names[w0->ls_cmd] : "",
 			lsreqbuf_len);
-		return -E2BIG;
+		return -ERR(E2BIG);
 	}
 
 	if (!nvmet_fc_tgtport_get(tgtport)) {
@@ -2050,7 +2050,7 @@ nvmet_fc_rcv_ls_req(struct nvmet_fc_target_port *target_port,
 			"RCV %s LS failed: target deleting\n",
 			(w0->ls_cmd <= NVME_FC_LAST_LS_CMD_VALUE) ?
 				nvmefc_ls_names[w0->ls_cmd] : "");
-		return -ESHUTDOWN;
+		return -ERR(ESHUTDOWN);
 	}
 
 	iod = nvmet_fc_alloc_ls_iod(tgtport);
@@ -2060,7 +2060,7 @@ nvmet_fc_rcv_ls_req(struct nvmet_fc_target_port *target_port,
 			(w0->ls_cmd <= NVME_FC_LAST_LS_CMD_VALUE) ?
 				nvmefc_ls_names[w0->ls_cmd] : "");
 		nvmet_fc_tgtport_put(tgtport);
-		return -ENOENT;
+		return -ERR(ENOENT);
 	}
 
 	iod->lsrsp = lsrsp;
@@ -2670,12 +2670,12 @@ nvmet_fc_rcv_fcp_req(struct nvmet_fc_target_port *target_port,
 			(cmdiu->format_id != NVME_CMD_FORMAT_ID) ||
 			(cmdiu->fc_id != NVME_CMD_FC_ID) ||
 			(be16_to_cpu(cmdiu->iu_len) != (sizeof(*cmdiu)/4)))
-		return -EIO;
+		return -ERR(EIO);
 
 	queue = nvmet_fc_find_target_queue(tgtport,
 				be64_to_cpu(cmdiu->connection_id));
 	if (!queue)
-		return -ENOTCONN;
+		return -ERR(ENOTCONN);
 
 	/*
 	 * note: reference taken by find_target_queue
@@ -2704,7 +2704,7 @@ nvmet_fc_rcv_fcp_req(struct nvmet_fc_target_port *target_port,
 		spin_unlock_irqrestore(&queue->qlock, flags);
 		/* release the queue lookup reference */
 		nvmet_fc_tgt_q_put(queue);
-		return -ENOENT;
+		return -ERR(ENOENT);
 	}
 
 	deferfcp = list_first_entry_or_null(&queue->avail_defer_list,
@@ -2720,7 +2720,7 @@ nvmet_fc_rcv_fcp_req(struct nvmet_fc_target_port *target_port,
 		if (!deferfcp) {
 			/* release the queue lookup reference */
 			nvmet_fc_tgt_q_put(queue);
-			return -ENOMEM;
+			return -ERR(ENOMEM);
 		}
 		spin_lock_irqsave(&queue->qlock, flags);
 	}
@@ -2737,7 +2737,7 @@ nvmet_fc_rcv_fcp_req(struct nvmet_fc_target_port *target_port,
 
 	spin_unlock_irqrestore(&queue->qlock, flags);
 
-	return -EOVERFLOW;
+	return -ERR(EOVERFLOW);
 }
 EXPORT_SYMBOL_GPL(nvmet_fc_rcv_fcp_req);
 
@@ -2806,7 +2806,7 @@ __nvme_fc_parse_u64(substring_t *sstr, u64 *val)
 	u64 token64;
 
 	if (match_u64(sstr, &token64))
-		return -EINVAL;
+		return -ERR(EINVAL);
 	*val = token64;
 
 	return 0;
@@ -2857,7 +2857,7 @@ nvme_fc_parse_traddr(struct nvmet_fc_traddr *traddr, char *buf, size_t blen)
 
 out_einval:
 	pr_warn("%s: bad traddr string\n", __func__);
-	return -EINVAL;
+	return -ERR(EINVAL);
 }
 
 static int
@@ -2872,7 +2872,7 @@ nvmet_fc_add_port(struct nvmet_port *port)
 	/* validate the address info */
 	if ((port->disc_addr.trtype != NVMF_TRTYPE_FC) ||
 	    (port->disc_addr.adrfam != NVMF_ADDR_FAMILY_FC))
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	/* map the traddr address info to a target port */
 
@@ -2883,9 +2883,9 @@ nvmet_fc_add_port(struct nvmet_port *port)
 
 	pe = kzalloc(sizeof(*pe), GFP_KERNEL);
 	if (!pe)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
-	ret = -ENXIO;
+	ret = -ERR(ENXIO);
 	spin_lock_irqsave(&nvmet_fc_tgtlock, flags);
 	list_for_each_entry(tgtport, &nvmet_fc_target_list, tgt_list) {
 		if ((tgtport->fc_target_port.node_name == traddr.nn) &&
@@ -2895,7 +2895,7 @@ nvmet_fc_add_port(struct nvmet_port *port)
 				nvmet_fc_portentry_bind(tgtport, pe, port);
 				ret = 0;
 			} else
-				ret = -EALREADY;
+				ret = -ERR(EALREADY);
 			break;
 		}
 	}
@@ -54,7 +54,7 @@ fcloop_parse_options(struct fcloop_ctrl_options *opts,
 
 	options = o = kstrdup(buf, GFP_KERNEL);
 	if (!options)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	while ((p = strsep(&o, ",\n")) != NULL) {
 		if (!*p)
@@ -65,49 +65,49 @@ fcloop_parse_options(struct fcloop_ctrl_options *opts,
 		switch (token) {
 		case NVMF_OPT_WWNN:
 			if (match_u64(args, &token64)) {
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out_free_options;
 			}
 			opts->wwnn = token64;
 			break;
 		case NVMF_OPT_WWPN:
 			if (match_u64(args, &token64)) {
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out_free_options;
 			}
 			opts->wwpn = token64;
 			break;
 		case NVMF_OPT_ROLES:
 			if (match_int(args, &token)) {
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out_free_options;
 			}
 			opts->roles = token;
 			break;
 		case NVMF_OPT_FCADDR:
 			if (match_hex(args, &token)) {
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out_free_options;
 			}
 			opts->fcaddr = token;
 			break;
 		case NVMF_OPT_LPWWNN:
 			if (match_u64(args, &token64)) {
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out_free_options;
 			}
 			opts->lpwwnn = token64;
 			break;
 		case NVMF_OPT_LPWWPN:
 			if (match_u64(args, &token64)) {
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out_free_options;
 			}
 			opts->lpwwpn = token64;
 			break;
 		default:
 			pr_warn("unknown parameter or missing value '%s'\n", p);
-			ret = -EINVAL;
+			ret = -ERR(EINVAL);
 			goto out_free_options;
 		}
 	}
@@ -132,7 +132,7 @@ fcloop_parse_nm_options(struct device *dev, u64 *nname, u64 *pname,
 
 	options = o = kstrdup(buf, GFP_KERNEL);
 	if (!options)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	while ((p = strsep(&o, ",\n")) != NULL) {
 		if (!*p)
@@ -142,21 +142,21 @@ fcloop_parse_nm_options(struct device *dev, u64 *nname, u64 *pname,
 		switch (token) {
 		case NVMF_OPT_WWNN:
 			if (match_u64(args, &token64)) {
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out_free_options;
 			}
 			*nname = token64;
 			break;
 		case NVMF_OPT_WWPN:
 			if (match_u64(args, &token64)) {
-				ret = -EINVAL;
+				ret = -ERR(EINVAL);
 				goto out_free_options;
 			}
 			*pname = token64;
 			break;
 		default:
 			pr_warn("unknown parameter or missing value '%s'\n", p);
-			ret = -EINVAL;
+			ret = -ERR(EINVAL);
 			goto out_free_options;
 		}
 	}
@@ -166,9 +166,9 @@ fcloop_parse_nm_options(struct device *dev, u64 *nname, u64 *pname,
 
 	if (!ret) {
 		if (*nname == -1)
-			return -EINVAL;
+			return -ERR(EINVAL);
 		if (*pname == -1)
-			return -EINVAL;
+			return -ERR(EINVAL);
 	}
 
 	return ret;
@@ -572,7 +572,7 @@ fcloop_fcp_recv_work(struct work_struct *work)
 	spin_unlock_irq(&tfcp_req->reqlock);
 
 	if (unlikely(aborted))
-		ret = -ECANCELED;
+		ret = -ERR(ECANCELED);
 	else
 		ret = nvmet_fc_rcv_fcp_req(tfcp_req->tport->targetport,
 				&tfcp_req->tgt_fcp_req,
@@ -655,11 +655,11 @@ fcloop_fcp_req(struct nvme_fc_local_port *localport,
 	struct fcloop_fcpreq *tfcp_req;
 
 	if (!rport->targetport)
-		return -ECONNREFUSED;
+		return -ERR(ECONNREFUSED);
 
 	tfcp_req = kzalloc(sizeof(*tfcp_req), GFP_ATOMIC);
 	if (!tfcp_req)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	inireq->fcpreq = fcpreq;
 	inireq->tfcp_req = tfcp_req;
@@ -752,7 +752,7 @@ fcloop_fcp_op(struct nvmet_fc_target_port *tgtport,
 
 	if (unlikely(active))
 		/* illegal - call while i/o active */
-		return -EALREADY;
+		return -ERR(EALREADY);
 
 	if (unlikely(aborted)) {
 		/* target transport has aborted i/o prior */
@@ -803,7 +803,7 @@ fcloop_fcp_op(struct nvmet_fc_target_port *tgtport,
 					fcpreq->rsplen : tgt_fcpreq->rsplen);
 			memcpy(fcpreq->rspaddr, tgt_fcpreq->rspaddr, rsplen);
 			if (rsplen < tgt_fcpreq->rsplen)
-				fcp_err = -E2BIG;
+				fcp_err = -ERR(E2BIG);
 			fcpreq->rcv_rsplen = rsplen;
 			fcpreq->status = 0;
 		}
@@ -811,7 +811,7 @@ fcloop_fcp_op(struct nvmet_fc_target_port *tgtport,
 		break;
 
 	default:
-		fcp_err = -EINVAL;
+		fcp_err = -ERR(EINVAL);
 		break;
 	}
 
@@ -1031,11 +1031,11 @@ fcloop_create_local_port(struct device *dev, struct device_attribute *attr,
 	struct fcloop_lport *lport;
 	struct fcloop_lport_priv *lport_priv;
 	unsigned long flags;
-	int ret = -ENOMEM;
+	int ret = -ERR(ENOMEM);
 
 	lport = kzalloc(sizeof(*lport), GFP_KERNEL);
 	if (!lport)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	opts = kzalloc(sizeof(*opts), GFP_KERNEL);
 	if (!opts)
@@ -1047,7 +1047,7 @@ fcloop_create_local_port(struct device *dev, struct device_attribute *attr,
 
 	/* everything there ? */
 	if ((opts->mask & LPORT_OPTS) != LPORT_OPTS) {
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto out_free_opts;
 	}
 
@@ -1131,7 +1131,7 @@ fcloop_delete_local_port(struct device *dev, struct device_attribute *attr,
 	spin_unlock_irqrestore(&fcloop_lock, flags);
 
 	if (!lport)
-		return -ENOENT;
+		return -ERR(ENOENT);
 
 	ret = __wait_localport_unreg(lport);
 
@@ -1158,7 +1158,7 @@ fcloop_alloc_nport(const char *buf, size_t count, bool remoteport)
 
 	/* everything there ? */
 	if ((opts->mask & opts_mask) != opts_mask) {
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto out_free_opts;
 	}
 
@@ -1244,7 +1244,7 @@ fcloop_create_remote_port(struct device *dev, struct device_attribute *attr,
 
 	nport = fcloop_alloc_nport(buf, count, true);
 	if (!nport)
-		return -EIO;
+		return -ERR(EIO);
 
 	memset(&pinfo, 0, sizeof(pinfo));
 	pinfo.node_name = nport->node_name;
@@ -1294,7 +1294,7 @@ static int
 __remoteport_unreg(struct fcloop_nport *nport, struct fcloop_rport *rport)
 {
 	if (!rport)
-		return -EALREADY;
+		return -ERR(EALREADY);
 
 	return nvme_fc_unregister_remoteport(rport->remoteport);
 }
@@ -1327,7 +1327,7 @@ fcloop_delete_remote_port(struct device *dev, struct device_attribute *attr,
 	spin_unlock_irqrestore(&fcloop_lock, flags);
 
 	if (!nport)
-		return -ENOENT;
+		return -ERR(ENOENT);
 
 	ret = __remoteport_unreg(nport, rport);
 
@@ -1346,7 +1346,7 @@ fcloop_create_target_port(struct device *dev, struct device_attribute *attr,
 
 	nport = fcloop_alloc_nport(buf, count, false);
 	if (!nport)
-		return -EIO;
+		return -ERR(EIO);
 
 	tinfo.node_name = nport->node_name;
 	tinfo.port_name = nport->port_name;
@@ -1392,7 +1392,7 @@ static int
 __targetport_unreg(struct fcloop_nport *nport, struct fcloop_tport *tport)
 {
 	if (!tport)
-		return -EALREADY;
+		return -ERR(EALREADY);
 
 	return nvmet_fc_unregister_targetport(tport->targetport);
 }
@@ -1425,7 +1425,7 @@ fcloop_delete_target_port(struct device *dev, struct device_attribute *attr,
 	spin_unlock_irqrestore(&fcloop_lock, flags);
 
 	if (!nport)
-		return -ENOENT;
+		return -ERR(ENOENT);
 
 	ret = __targetport_unreg(nport, tport);
 
@@ -182,7 +182,7 @@ static int nvmet_bdev_alloc_bip(struct nvmet_req *req, struct bio *bio,
 	bi = bdev_get_integrity(bdev);
 	if (unlikely(!bi)) {
 		pr_err("Unable to locate bio_integrity\n");
-		return -ENODEV;
+		return -ERR(ENODEV);
 	}
 
 	bip = bio_integrity_alloc(bio, GFP_NOIO,
@@ -205,7 +205,7 @@ static int nvmet_bdev_alloc_bip(struct nvmet_req *req, struct bio *bio,
 		if (unlikely(rc != len)) {
 			pr_err("bio_integrity_add_page() failed; %d\n", rc);
 			sg_miter_stop(miter);
-			return -ENOMEM;
+			return -ERR(ENOMEM);
 		}
 
 		resid -= len;
@@ -220,7 +220,7 @@ static int nvmet_bdev_alloc_bip(struct nvmet_req *req, struct bio *bio,
 static int nvmet_bdev_alloc_bip(struct nvmet_req *req, struct bio *bio,
 				struct sg_mapping_iter *miter)
 {
-	return -EINVAL;
+	return -ERR(EINVAL);
 }
 #endif /* CONFIG_BLK_DEV_INTEGRITY */
 
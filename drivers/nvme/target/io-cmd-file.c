@@ -69,7 +69,7 @@ int nvmet_file_ns_enable(struct nvmet_ns *ns)
 			NVMET_MAX_MPOOL_BVEC * sizeof(struct bio_vec),
 			0, SLAB_HWCACHE_ALIGN, NULL);
 	if (!ns->bvec_cache) {
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto err;
 	}
 
@@ -77,7 +77,7 @@ int nvmet_file_ns_enable(struct nvmet_ns *ns)
 			mempool_free_slab, ns->bvec_cache);
 
 	if (!ns->bvec_pool) {
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto err;
 	}
 
@@ -183,7 +183,7 @@ static bool nvmet_file_execute_io(struct nvmet_req *req, int ki_flags)
 	}
 
 	if (WARN_ON_ONCE(total_len != req->transfer_len)) {
-		ret = -EIO;
+		ret = -ERR(EIO);
 		goto complete;
 	}
 
@@ -311,7 +311,7 @@ static void nvmet_file_execute_discard(struct nvmet_req *req)
 		len <<= req->ns->blksize_shift;
 		if (offset + len > req->ns->size) {
 			req->error_slba = le64_to_cpu(range.slba);
-			status = errno_to_nvme_status(req, -ENOSPC);
+			status = errno_to_nvme_status(req, -ERR(ENOSPC));
 			break;
 		}
 
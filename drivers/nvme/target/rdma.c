@@ -180,7 +180,7 @@ static int srq_size_set(const char *val, const struct kernel_param *kp)
 
 	ret = kstrtoint(val, 10, &n);
 	if (ret != 0 || n < 256)
-		return -EINVAL;
+		return -ERR(EINVAL);
 
 	return param_set_int(val, kp);
 }
@@ -314,7 +314,7 @@ static int nvmet_rdma_alloc_inline_pages(struct nvmet_rdma_device *ndev,
 		if (sg_page(sg))
 			__free_page(sg_page(sg));
 	}
-	return -ENOMEM;
+	return -ERR(ENOMEM);
 }
 
 static int nvmet_rdma_alloc_cmd(struct nvmet_rdma_device *ndev,
@@ -351,7 +351,7 @@ static int nvmet_rdma_alloc_cmd(struct nvmet_rdma_device *ndev,
 	kfree(c->nvme_cmd);
 
 out:
-	return -ENOMEM;
+	return -ERR(ENOMEM);
 }
 
 static void nvmet_rdma_free_cmd(struct nvmet_rdma_device *ndev,
@@ -369,7 +369,7 @@ nvmet_rdma_alloc_cmds(struct nvmet_rdma_device *ndev,
 		int nr_cmds, bool admin)
 {
 	struct nvmet_rdma_cmd *cmds;
-	int ret = -EINVAL, i;
+	int ret = -ERR(EINVAL), i;
 
 	cmds = kcalloc(nr_cmds, sizeof(struct nvmet_rdma_cmd), GFP_KERNEL);
 	if (!cmds)
@@ -435,7 +435,7 @@ static int nvmet_rdma_alloc_rsp(struct nvmet_rdma_device *ndev,
 out_free_rsp:
 	kfree(r->req.cqe);
 out:
-	return -ENOMEM;
+	return -ERR(ENOMEM);
 }
 
 static void nvmet_rdma_free_rsp(struct nvmet_rdma_device *ndev,
@@ -451,7 +451,7 @@ nvmet_rdma_alloc_rsps(struct nvmet_rdma_queue *queue)
 {
 	struct nvmet_rdma_device *ndev = queue->dev;
 	int nr_rsps = queue->recv_queue_size * 2;
-	int ret = -EINVAL, i;
+	int ret = -ERR(EINVAL), i;
 
 	queue->rsps = kcalloc(nr_rsps, sizeof(struct nvmet_rdma_rsp),
 			GFP_KERNEL);
@@ -1093,7 +1093,7 @@ nvmet_rdma_init_srq(struct nvmet_rdma_device *ndev)
 
 	nsrq = kzalloc(sizeof(*nsrq), GFP_KERNEL);
 	if (!nsrq)
-		return ERR_PTR(-ENOMEM);
+		return ERR_PTR(-ERR(ENOMEM));
 
 	srq_attr.attr.max_wr = srq_size;
 	srq_attr.attr.max_sge = 1 + ndev->inline_page_count;
@@ -1152,7 +1152,7 @@ static int nvmet_rdma_init_srqs(struct nvmet_rdma_device *ndev)
 
 	ndev->srqs = kcalloc(ndev->srq_count, sizeof(*ndev->srqs), GFP_KERNEL);
 	if (!ndev->srqs)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	for (i = 0; i < ndev->srq_count; i++) {
 		ndev->srqs[i] = nvmet_rdma_init_srq(ndev);
@@ -1537,7 +1537,7 @@ static int nvmet_rdma_cm_accept(struct rdma_cm_id *cm_id,
 {
 	struct rdma_conn_param  param = { };
 	struct nvme_rdma_cm_rep priv = { };
-	int ret = -ENOMEM;
+	int ret = -ERR(ENOMEM);
 
 	param.rnr_retry_count = 7;
 	param.flow_control = 1;
@@ -1560,17 +1560,17 @@ static int nvmet_rdma_queue_connect(struct rdma_cm_id *cm_id,
 {
 	struct nvmet_rdma_device *ndev;
 	struct nvmet_rdma_queue *queue;
-	int ret = -EINVAL;
+	int ret = -ERR(EINVAL);
 
 	ndev = nvmet_rdma_find_get_device(cm_id);
 	if (!ndev) {
 		nvmet_rdma_cm_reject(cm_id, NVME_RDMA_CM_NO_RSC);
-		return -ECONNREFUSED;
+		return -ERR(ECONNREFUSED);
 	}
 
 	queue = nvmet_rdma_alloc_queue(ndev, cm_id, event);
 	if (!queue) {
-		ret = -ENOMEM;
+		ret = -ERR(ENOMEM);
 		goto put_device;
 	}
 
@@ -1848,7 +1848,7 @@ static int nvmet_rdma_enable_port(struct nvmet_rdma_port *port)
 	    !(cm_id->device->attrs.device_cap_flags &
 	      IB_DEVICE_INTEGRITY_HANDOVER)) {
 		pr_err("T10-PI is not supported for %pISpcs\n", addr);
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto out_destroy_id;
 	}
 
@@ -1880,7 +1880,7 @@ static int nvmet_rdma_add_port(struct nvmet_port *nport)
 
 	port = kzalloc(sizeof(*port), GFP_KERNEL);
 	if (!port)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	nport->priv = port;
 	port->nport = nport;
@@ -1896,7 +1896,7 @@ static int nvmet_rdma_add_port(struct nvmet_port *nport)
 	default:
 		pr_err("address family %d not supported\n",
 			nport->disc_addr.adrfam);
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto out_free_port;
 	}
 
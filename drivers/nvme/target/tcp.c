@@ -244,7 +244,7 @@ static int nvmet_tcp_verify_hdgst(struct nvmet_tcp_queue *queue,
 	if (unlikely(!(hdr->flags & NVME_TCP_F_HDGST))) {
 		pr_err("queue %d: header digest enabled but no header digest\n",
 			queue->idx);
-		return -EPROTO;
+		return -ERR(EPROTO);
 	}
 
 	recv_digest = *(__le32 *)(pdu + hdr->hlen);
@@ -254,7 +254,7 @@ static int nvmet_tcp_verify_hdgst(struct nvmet_tcp_queue *queue,
 		pr_err("queue %d: header digest error: recv %#x expected %#x\n",
 			queue->idx, le32_to_cpu(recv_digest),
 			le32_to_cpu(exp_digest));
-		return -EPROTO;
+		return -ERR(EPROTO);
 	}
 
 	return 0;
@@ -271,7 +271,7 @@ static int nvmet_tcp_check_ddgst(struct nvmet_tcp_queue *queue, void *pdu)
 
 	if (unlikely(len && !(hdr->flags & NVME_TCP_F_DDGST))) {
 		pr_err("queue %d: data digest flag is cleared\n", queue->idx);
-		return -EPROTO;
+		return -ERR(EPROTO);
 	}
 
 	return 0;
@@ -526,7 +526,7 @@ static int nvmet_try_send_data_pdu(struct nvmet_tcp_cmd *cmd)
 	left -= ret;
 
 	if (left)
-		return -EAGAIN;
+		return -ERR(EAGAIN);
 
 	cmd->state = NVMET_TCP_SEND_DATA;
 	cmd->offset  = 0;
@@ -605,7 +605,7 @@ static int nvmet_try_send_response(struct nvmet_tcp_cmd *cmd,
 	left -= ret;
 
 	if (left)
-		return -EAGAIN;
+		return -ERR(EAGAIN);
 
 	kfree(cmd->iov);
 	sgl_free(cmd->req.sg);
@@ -634,7 +634,7 @@ static int nvmet_try_send_r2t(struct nvmet_tcp_cmd *cmd, bool last_in_batch)
 	left -= ret;
 
 	if (left)
-		return -EAGAIN;
+		return -ERR(EAGAIN);
 
 	cmd->queue->snd_cmd = NULL;
 	return 1;
@@ -778,7 +778,7 @@ static int nvmet_tcp_alloc_crypto(struct nvmet_tcp_queue *queue)
 	ahash_request_free(queue->snd_hash);
 free_tfm:
 	crypto_free_ahash(tfm);
-	return -ENOMEM;
+	return -ERR(ENOMEM);
 }
 
 
@@ -798,13 +798,13 @@ static int nvmet_tcp_handle_icreq(struct nvmet_tcp_queue *queue)
 
 	if (icreq->pfv != NVME_TCP_PFV_1_0) {
 		pr_err("queue %d: bad pfv %d\n", queue->idx, icreq->pfv);
-		return -EPROTO;
+		return -ERR(EPROTO);
 	}
 
 	if (icreq->hpda != 0) {
 		pr_err("queue %d: unsupported hpda %d\n", queue->idx,
 			icreq->hpda);
-		return -EPROTO;
+		return -ERR(EPROTO);
 	}
 
 	queue->hdr_digest = !!(icreq->digest & NVME_TCP_HDR_DIGEST_ENABLE);
@@ -881,7 +881,7 @@ static int nvmet_tcp_handle_h2c_data_pdu(struct nvmet_tcp_queue *queue)
 		/* FIXME: use path and transport errors */
 		nvmet_req_complete(&cmd->req,
 			NVME_SC_INVALID_FIELD | NVME_SC_DNR);
-		return -EPROTO;
+		return -ERR(EPROTO);
 	}
 
 	cmd->pdu_len = le32_to_cpu(data->data_length);
@@ -905,7 +905,7 @@ static int nvmet_tcp_done_recv_pdu(struct nvmet_tcp_queue *queue)
 			pr_err("unexpected pdu type (%d) before icreq\n",
 				hdr->type);
 			nvmet_tcp_fatal_error(queue);
-			return -EPROTO;
+			return -ERR(EPROTO);
 		}
 		return nvmet_tcp_handle_icreq(queue);
 	}
@@ -924,7 +924,7 @@ static int nvmet_tcp_done_recv_pdu(struct nvmet_tcp_queue *queue)
 			queue->idx, queue->nr_cmds, queue->send_list_len,
 			nvme_cmd->common.opcode);
 		nvmet_tcp_fatal_error(queue);
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	}
 
 	req = &queue->cmd->req;
@@ -938,7 +938,7 @@ static int nvmet_tcp_done_recv_pdu(struct nvmet_tcp_queue *queue)
 			le32_to_cpu(req->cmd->common.dptr.sgl.length));
 
 		nvmet_tcp_handle_req_failure(queue, queue->cmd, req);
-		return -EAGAIN;
+		return -ERR(EAGAIN);
 	}
 
 	ret = nvmet_tcp_map_data(queue->cmd);
@@ -948,7 +948,7 @@ static int nvmet_tcp_done_recv_pdu(struct nvmet_tcp_queue *queue)
 			nvmet_tcp_fatal_error(queue);
 		else
 			nvmet_req_complete(req, ret);
-		ret = -EAGAIN;
+		ret = -ERR(EAGAIN);
 		goto out;
 	}
 
@@ -1015,7 +1015,7 @@ static int nvmet_tcp_try_recv_pdu(struct nvmet_tcp_queue *queue)
 	queue->offset += len;
 	queue->left -= len;
 	if (queue->left)
-		return -EAGAIN;
+		return -ERR(EAGAIN);
 
 	if (queue->offset == sizeof(struct nvme_tcp_hdr)) {
 		u8 hdgst = nvmet_tcp_hdgst_len(queue);
@@ -1023,12 +1023,12 @@ static int nvmet_tcp_try_recv_pdu(struct nvmet_tcp_queue *queue)
 		if (unlikely(!nvmet_tcp_pdu_valid(hdr->type))) {
 			pr_err("unexpected pdu type %d\n", hdr->type);
 			nvmet_tcp_fatal_error(queue);
-			return -EIO;
+			return -ERR(EIO);
 		}
 
 		if (unlikely(hdr->hlen != nvmet_tcp_pdu_size(hdr->type))) {
 			pr_err("pdu %d bad hlen %d\n", hdr->type, hdr->hlen);
-			return -EIO;
+			return -ERR(EIO);
 		}
 
 		queue->left = hdr->hlen - queue->offset + hdgst;
@@ -1038,13 +1038,13 @@ static int nvmet_tcp_try_recv_pdu(struct nvmet_tcp_queue *queue)
 	if (queue->hdr_digest &&
 	    nvmet_tcp_verify_hdgst(queue, &queue->pdu, queue->offset)) {
 		nvmet_tcp_fatal_error(queue); /* fatal */
-		return -EPROTO;
+		return -ERR(EPROTO);
 	}
 
 	if (queue->data_digest &&
 	    nvmet_tcp_check_ddgst(queue, &queue->pdu)) {
 		nvmet_tcp_fatal_error(queue); /* fatal */
-		return -EPROTO;
+		return -ERR(EPROTO);
 	}
 
 	return nvmet_tcp_done_recv_pdu(queue);
@@ -1108,7 +1108,7 @@ static int nvmet_tcp_try_recv_ddgst(struct nvmet_tcp_queue *queue)
 	queue->offset += ret;
 	queue->left -= ret;
 	if (queue->left)
-		return -EAGAIN;
+		return -ERR(EAGAIN);
 
 	if (queue->data_digest && cmd->exp_ddgst != cmd->recv_ddgst) {
 		pr_err("queue %d: cmd %d pdu (%d) data digest error: recv %#x expected %#x\n",
@@ -1117,7 +1117,7 @@ static int nvmet_tcp_try_recv_ddgst(struct nvmet_tcp_queue *queue)
 			le32_to_cpu(cmd->exp_ddgst));
 		nvmet_tcp_finish_cmd(cmd);
 		nvmet_tcp_fatal_error(queue);
-		ret = -EPROTO;
+		ret = -ERR(EPROTO);
 		goto out;
 	}
 
@@ -1235,7 +1235,7 @@ static int nvmet_tcp_alloc_cmd(struct nvmet_tcp_queue *queue,
 	c->cmd_pdu = page_frag_alloc(&queue->pf_cache,
 			sizeof(*c->cmd_pdu) + hdgst, GFP_KERNEL | __GFP_ZERO);
 	if (!c->cmd_pdu)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 	c->req.cmd = &c->cmd_pdu->cmd;
 
 	c->rsp_pdu = page_frag_alloc(&queue->pf_cache,
@@ -1265,7 +1265,7 @@ static int nvmet_tcp_alloc_cmd(struct nvmet_tcp_queue *queue,
 	page_frag_free(c->rsp_pdu);
 out_free_cmd:
 	page_frag_free(c->cmd_pdu);
-	return -ENOMEM;
+	return -ERR(ENOMEM);
 }
 
 static void nvmet_tcp_free_cmd(struct nvmet_tcp_cmd *c)
@@ -1483,7 +1483,7 @@ static int nvmet_tcp_alloc_queue(struct nvmet_tcp_port *port,
 
 	queue = kzalloc(sizeof(*queue), GFP_KERNEL);
 	if (!queue)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	INIT_WORK(&queue->release_work, nvmet_tcp_release_queue_work);
 	INIT_WORK(&queue->io_work, nvmet_tcp_io_work);
@@ -1585,7 +1585,7 @@ static int nvmet_tcp_add_port(struct nvmet_port *nport)
 
 	port = kzalloc(sizeof(*port), GFP_KERNEL);
 	if (!port)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	switch (nport->disc_addr.adrfam) {
 	case NVMF_ADDR_FAMILY_IP4:
@@ -1597,7 +1597,7 @@ static int nvmet_tcp_add_port(struct nvmet_port *nport)
 	default:
 		pr_err("address family %d not supported\n",
 				nport->disc_addr.adrfam);
-		ret = -EINVAL;
+		ret = -ERR(EINVAL);
 		goto err_port;
 	}
 
@@ -1732,7 +1732,7 @@ static int __init nvmet_tcp_init(void)
 
 	nvmet_tcp_wq = alloc_workqueue("nvmet_tcp_wq", WQ_HIGHPRI, 0);
 	if (!nvmet_tcp_wq)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	ret = nvmet_register_transport(&nvmet_tcp_ops);
 	if (ret)
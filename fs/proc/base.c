@@ -3136,19 +3136,55 @@ static int proc_stack_depth(struct seq_file *m, struct pid_namespace *ns,
 }
 #endif /* CONFIG_STACKLEAK_METRICS */
 
+#ifdef CONFIG_TRACE_ERROR
 static int proc_pid_last_err(struct seq_file *m, struct pid_namespace *ns,
 				struct pid *pid, struct task_struct *task)
 {
-	if (task->last_err.file && task->last_err.errno) {
-		seq_printf(m, "%s:%d %d\n",
-			   task->last_err.file,
-			   task->last_err.line,
-			   task->last_err.errno);
-	} else {
+	u64 last = READ_ONCE(task->last_err.last);
+
+	if (seq_print_err_site(m, last_err_site(last)) &&
+	    IS_ENABLED(CONFIG_TRACE_ERROR_SYSCALL_SCOPED))
+		seq_printf(m, " %d", last_err_nr(last));
+	seq_printf(m, "\n");
+	return 0;
+}
+
+static int proc_pid_error_history(struct seq_file *m, struct pid_namespace *ns,
+				  struct pid *pid, struct task_struct *task)
+{
+	struct last_err *last_err = &task->last_err;
+	unsigned int head = READ_ONCE(last_err->head);
+	unsigned int start = READ_ONCE(last_err->start);
+	unsigned int i;
+
+	/* Older records of a long chain have been overwritten. */
+	if (head - start > TRACE_ERROR_HISTORY)
+		start = head - TRACE_ERROR_HISTORY;
+
+	/* Pairs with the smp_wmb() of last_err_record(). */
+	smp_rmb();
+
+	for (i = start; i != head; i++) {
+		struct err_record *record;
+		unsigned int site;
+		u64 time;
+
+		record = &last_err->history[i & (TRACE_ERROR_HISTORY - 1)];
+		time = READ_ONCE(record->time);
+		site = READ_ONCE(record->site);
+
+		/* Skip a record the task has started to overwrite. */
+		smp_rmb();
+		if (READ_ONCE(last_err->head) - i >= TRACE_ERROR_HISTORY)
+			continue;
+
+		seq_printf(m, "%llu ", time);
+		seq_print_err_site(m, site);
 		seq_printf(m, "\n");
 	}
 	return 0;
 }
+#endif /* CONFIG_TRACE_ERROR */
 
 /*
  * Thread groups
@@ -3265,6 +3301,7 @@ static const struct pid_entry tgid_base_stuff[] = {
 #endif
 #ifdef CONFIG_TRACE_ERROR
 	ONE("last_error",  S_IRUGO, proc_pid_last_err),
+	ONE("error_history", S_IRUGO, proc_pid_error_history),
 #endif
 };
 
@@ -3595,6 +3632,10 @@ static const struct pid_entry tid_base_stuff[] = {
 #ifdef CONFIG_PROC_PID_ARCH_STATUS
 	ONE("arch_status", S_IRUGO, proc_pid_arch_status),
 #endif
+#ifdef CONFIG_TRACE_ERROR
+	ONE("last_error",  S_IRUGO, proc_pid_last_err),
+	ONE("error_history", S_IRUGO, proc_pid_error_history),
+#endif
 };
 
 static int proc_tid_base_readdir(struct file *file, struct dir_context *ctx)
@@ -218,6 +218,15 @@
 #define TRACEPOINT_STR()
 #endif
 
+#ifdef CONFIG_TRACE_ERROR
+#define ERR_SITES()	. = ALIGN(8);					\
+			__start___err_sites = .;			\
+			KEEP(*(__err_sites))				\
+			__stop___err_sites = .;
+#else
+#define ERR_SITES()
+#endif
+
 #ifdef CONFIG_FTRACE_SYSCALLS
 #define TRACE_SYSCALLS() . = ALIGN(8);					\
 			 __start_syscalls_metadata = .;			\
@@ -323,6 +332,7 @@
 	__start___verbose = .;						\
 	KEEP(*(__verbose))                                              \
 	__stop___verbose = .;						\
+	ERR_SITES()							\
 	LIKELY_PROFILE()		       				\
 	BRANCH_PROFILE()						\
 	TRACE_PRINTKS()							\
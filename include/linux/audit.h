@@ -532,6 +532,7 @@ static inline void audit_log_nfcfg(const char *name, u8 af,
 
 extern int audit_n_rules;
 extern int audit_signals;
+extern int audit_err_site_rules;
 #else /* CONFIG_AUDITSYSCALL */
 static inline int audit_alloc(struct task_struct *task)
 {
@@ -670,6 +671,7 @@ static inline void audit_log_nfcfg(const char *name, u8 af,
 
 #define audit_n_rules 0
 #define audit_signals 0
+#define audit_err_site_rules 0
 #endif /* CONFIG_AUDITSYSCALL */
 
 static inline bool audit_loginuid_set(struct task_struct *tsk)
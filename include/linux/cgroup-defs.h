@@ -285,6 +285,17 @@ struct cgroup_base_stat {
 	struct task_cputime cputime;
 };
 
+#ifdef CONFIG_TRACE_ERROR_CGROUP
+#define CGROUP_ERR_STAT_CPU_SLOTS	16
+#define CGROUP_ERR_STAT_SLOTS		32
+
+/* hits of an ERR() site, see <linux/trace_error.h> */
+struct cgroup_err_stat {
+	unsigned int site;
+	u64 count;
+};
+#endif
+
 /*
  * rstat - cgroup scalable recursive statistics.  Accounting is done
  * per-cpu in cgroup_rstat_cpu which is then lazily propagated up the
@@ -319,6 +330,20 @@ struct cgroup_rstat_cpu {
 	 */
 	struct cgroup_base_stat last_bstat;
 
+#ifdef CONFIG_TRACE_ERROR_CGROUP
+	/*
+	 * Error site hits on this cpu, updated only by the cpu itself
+	 * under ->err_seq.  ->last_err_stat is the matching snapshot at
+	 * the last flush, written only by the flusher.  A slot is reused
+	 * for another site only once all of its hits have been flushed.
+	 */
+	seqcount_t err_seq;
+	struct cgroup_err_stat err_stat[CGROUP_ERR_STAT_CPU_SLOTS];
+	u64 err_dropped;
+	struct cgroup_err_stat last_err_stat[CGROUP_ERR_STAT_CPU_SLOTS];
+	u64 last_err_dropped;
+#endif
+
 	/*
 	 * Child cgroups with stat updates on this cpu since the last read
 	 * are linked on the parent's ->updated_children through
@@ -457,6 +482,12 @@ struct cgroup {
 	struct cgroup_base_stat bstat;
 	struct prev_cputime prev_cputime;	/* for printing out cputime */
 
+#ifdef CONFIG_TRACE_ERROR_CGROUP
+	/* most frequent error sites of the subtree, see errors.stat */
+	struct cgroup_err_stat err_stat[CGROUP_ERR_STAT_SLOTS];
+	u64 err_dropped;
+#endif
+
 	/*
 	 * list of pidlists, up to two for each namespace (one for procs, one
 	 * for tasks); created on demand.
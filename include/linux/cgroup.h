@@ -800,6 +800,23 @@ static inline void cgroup_account_cputime_field(struct task_struct *task,
 	rcu_read_unlock();
 }
 
+#ifdef CONFIG_TRACE_ERROR_CGROUP
+void __cgroup_account_error(struct cgroup *cgrp, unsigned int site);
+
+static inline void cgroup_account_error(unsigned int site)
+{
+	struct cgroup *cgrp;
+
+	rcu_read_lock();
+	cgrp = task_dfl_cgroup(current);
+	if (cgroup_parent(cgrp))
+		__cgroup_account_error(cgrp, site);
+	rcu_read_unlock();
+}
+#else
+static inline void cgroup_account_error(unsigned int site) {}
+#endif
+
 #else	/* CONFIG_CGROUPS */
 
 static inline void cgroup_account_cputime(struct task_struct *task,
@@ -807,6 +824,7 @@ static inline void cgroup_account_cputime(struct task_struct *task,
 static inline void cgroup_account_cputime_field(struct task_struct *task,
 						enum cpu_usage_stat index,
 						u64 delta_exec) {}
+static inline void cgroup_account_error(unsigned int site) {}
 
 #endif	/* CONFIG_CGROUPS */
 
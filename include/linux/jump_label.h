@@ -229,6 +229,9 @@ extern void static_key_enable(struct static_key *key);
 extern void static_key_disable(struct static_key *key);
 extern void static_key_enable_cpuslocked(struct static_key *key);
 extern void static_key_disable_cpuslocked(struct static_key *key);
+extern void static_key_batch_begin(void);
+extern void static_key_batch_set(struct static_key *key, bool enable);
+extern void static_key_batch_end(void);
 
 /*
  * We should be using ATOMIC_INIT() for initializing .enabled, but
@@ -326,6 +329,17 @@ static inline void static_key_disable(struct static_key *key)
 #define static_key_enable_cpuslocked(k)		static_key_enable((k))
 #define static_key_disable_cpuslocked(k)	static_key_disable((k))
 
+static inline void static_key_batch_begin(void) {}
+static inline void static_key_batch_end(void) {}
+
+static inline void static_key_batch_set(struct static_key *key, bool enable)
+{
+	if (enable)
+		static_key_enable(key);
+	else
+		static_key_disable(key);
+}
+
 #define STATIC_KEY_INIT_TRUE	{ .enabled = ATOMIC_INIT(1) }
 #define STATIC_KEY_INIT_FALSE	{ .enabled = ATOMIC_INIT(0) }
 
@@ -477,6 +477,10 @@ struct module {
 	struct jump_entry *jump_entries;
 	unsigned int num_jump_entries;
 #endif
+#ifdef CONFIG_TRACE_ERROR
+	struct err_site *err_sites;
+	unsigned int num_err_sites;
+#endif
 #ifdef CONFIG_TRACING
 	unsigned int num_trace_bprintk_fmt;
 	const char **trace_bprintk_fmt_start;
@@ -2040,6 +2040,101 @@ static inline void rseq_syscall(struct pt_regs *regs)
 
 #endif
 
+#ifdef CONFIG_TRACE_ERROR
+
+/*
+ * Drop errors recorded outside of the syscall, and make the next one
+ * start a new chain in the error history.
+ */
+static inline void trace_error_syscall_enter(void)
+{
+	if (trace_error_enabled())
+		current->last_err.pending_errno = 0;
+}
+
+/*
+ * Errors handled inside the kernel, such as a retried -EAGAIN, never
+ * reach user space. Only publish the pending error if the syscall returns
+ * it, and discard it otherwise.
+ */
+static inline void trace_error_syscall_exit(long ret, int nr)
+{
+	struct last_err *last_err = &current->last_err;
+	unsigned int site = 0;
+
+	/* Don't leave the site of a syscall from before recording stopped */
+	if (!trace_error_enabled()) {
+		if (unlikely(last_err->ret_site))
+			WRITE_ONCE(last_err->ret_site, 0);
+		return;
+	}
+
+	if (last_err->pending_errno && ret == -last_err->pending_errno) {
+		site = last_err->pending;
+		WRITE_ONCE(last_err->last, LAST_ERR_PACK(site, nr));
+	}
+	WRITE_ONCE(last_err->ret_site, site);
+	last_err->pending_errno = 0;
+}
+
+/*
+ * The error site returned by the last syscall of @task, for tracers
+ * stopped at or after its exit. Zero if none was recorded, or if
+ * recording is off and @task has not exited a syscall since.
+ */
+static inline unsigned int trace_error_syscall_site(struct task_struct *task)
+{
+	if (!trace_error_enabled())
+		return 0;
+	return READ_ONCE(task->last_err.ret_site);
+}
+
+/*
+ * Also store the errors of current in @cap, on behalf of the task that
+ * submitted the work. @cap must stay valid until the matching
+ * trace_error_capture_end(), which is passed the returned slot.
+ */
+static inline struct err_capture *
+trace_error_capture_begin(struct err_capture *cap)
+{
+	struct err_capture *prev = current->last_err.capture;
+
+	current->last_err.capture = cap;
+	return prev;
+}
+
+static inline void trace_error_capture_end(struct err_capture *prev)
+{
+	current->last_err.capture = prev;
+}
+
+#else
+
+static inline void trace_error_syscall_enter(void)
+{
+}
+
+static inline void trace_error_syscall_exit(long ret, int nr)
+{
+}
+
+static inline unsigned int trace_error_syscall_site(struct task_struct *task)
+{
+	return 0;
+}
+
+static inline struct err_capture *
+trace_error_capture_begin(struct err_capture *cap)
+{
+	return NULL;
+}
+
+static inline void trace_error_capture_end(struct err_capture *prev)
+{
+}
+
+#endif
+
 const struct sched_avg *sched_trace_cfs_rq_avg(struct cfs_rq *cfs_rq);
 char *sched_trace_cfs_rq_path(struct cfs_rq *cfs_rq, char *str, int len);
 int sched_trace_cfs_rq_cpu(struct cfs_rq *cfs_rq);
@@ -62,6 +62,9 @@ struct rpc_task {
 	} u;
 
 	int			tk_rpc_status;	/* Result of last RPC operation */
+#ifdef CONFIG_TRACE_ERROR
+	struct err_capture	tk_err;		/* Last error of async steps */
+#endif
 
 	/*
 	 * RPC call state
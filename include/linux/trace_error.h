@@ -5,20 +5,181 @@
 #ifdef CONFIG_TRACE_ERROR
 #ifndef __ASSEMBLY__
 
-struct last_err {
+#include <linux/jump_label.h>
+
+struct ctl_table;
+struct seq_file;
+
+/*
+ * One descriptor per ERR() site, collected in the __err_sites section.
+ * @id is assigned when the table is registered, at boot for vmlinux and
+ * at load time for modules. Zero means no site. @sampler is non-zero
+ * when the site is sampled, see <debugfs>/trace_error/sampling, which is
+ * the default for noisy errnos, see __err_noisy(). @key
+ * is set while the site is switched on, see <debugfs>/trace_error/control.
+ */
+struct err_site {
 	const char	*file;
+	const char	*function;
 	unsigned int	line;
-	int 		errno;
+	int		errno;
+	unsigned int	id;
+	unsigned int	sampler;
+#ifdef CONFIG_TRACE_ERROR_SITE_KEYS
+	struct static_key key;
+#endif
+} __aligned(8);
+
+#define TRACE_ERROR_HISTORY	(1U << CONFIG_TRACE_ERROR_HISTORY_SHIFT)
+
+struct err_record {
+	u64		time;
+	unsigned int	site;
+};
+
+/*
+ * Provenance slot for work done on behalf of another task, embedded in
+ * the request. A worker stores its errors in the slot while it is
+ * captured, see trace_error_capture_begin(), and the submitter takes the
+ * last one over with trace_error_propagate() on completion.
+ */
+struct err_capture {
+	unsigned int	site;
 };
 
-extern void set_last_err(const char *file, unsigned int line, int errno);
+/*
+ * @pending is the latest error of the running syscall. It becomes @last,
+ * packed with the syscall number that returned it, only if the syscall
+ * returns its errno; see trace_error_syscall_exit(). Other tasks read
+ * @last locklessly, and a single word cannot be seen half updated.
+ * @ret_site is the same for the most recent syscall only, and is zero if
+ * it returned no recorded error.
+ *
+ * @history is a ring written only by the task itself. @head counts the
+ * records ever written and @start is the first record of the current
+ * chain, which is restarted by the first error of each syscall with
+ * CONFIG_TRACE_ERROR_SYSCALL_SCOPED, and stays zero otherwise. A reader
+ * checks @head again after reading a record, to tell whether the task
+ * has started overwriting it meanwhile.
+ *
+ * @capture, if set, also receives every error of the task.
+ */
+struct last_err {
+	u64			last;
+	unsigned int		ret_site;
+	unsigned int		pending;
+	int			pending_errno;
+	unsigned int		head;
+	unsigned int		start;
+	struct err_capture	*capture;
+	struct err_record	history[TRACE_ERROR_HISTORY];
+};
+
+#define LAST_ERR_PACK(site, nr)	((u64)(u32)(nr) << 32 | (u32)(site))
+
+static inline unsigned int last_err_site(u64 last)
+{
+	return (u32)last;
+}
+
+static inline int last_err_nr(u64 last)
+{
+	return (s32)(last >> 32);
+}
+
+/*
+ * This header is pulled in by <linux/errno.h>, possibly from within
+ * <linux/jump_label.h> itself, so the keys are declared by hand rather than
+ * with DECLARE_STATIC_KEY_FALSE().
+ */
+extern struct static_key_false trace_error_key;
+extern struct static_key_false trace_error_record_key;
+
+extern void __cold set_last_err(const struct err_site *site);
+extern void trace_error_propagate(const struct err_capture *cap, int status);
+
+extern const struct err_site *err_site_find(unsigned int id);
+extern bool seq_print_err_site(struct seq_file *m, unsigned int id);
 
-#define ERR(errno) ({					\
-	set_last_err(__FILE__, __LINE__, errno);	\
-	errno;						\
+#ifdef CONFIG_TRACE_ERROR_STATS
+extern void trace_error_count(unsigned int site);
+#else
+static inline void trace_error_count(unsigned int site) { }
+#endif
+
+extern int trace_error_sysctl(struct ctl_table *table, int write,
+			      void *buffer, size_t *lenp, loff_t *ppos);
+
+#define trace_error_enabled()	static_branch_unlikely(&trace_error_record_key)
+
+/*
+ * Errnos that fire often and say little, such as ENOMEM from allocation
+ * retries or EFAULT from user copies, are sampled by default: their sites
+ * start out pointing to the shared ERR_SAMPLER_NOISY slot, which records
+ * one evaluation in CONFIG_TRACE_ERROR_NOISY_SAMPLE.
+ */
+#define ERR_SAMPLER_NOISY	1
+#define __err_noisy(e)		((e) == ENOMEM || (e) == EFAULT)
+
+/*
+ * A site switched off through the control file jumps over the call. The
+ * key is a bare struct static_key, for the same reason as above, so it is
+ * tested with static_key_true() rather than static_branch_likely().
+ */
+#ifdef CONFIG_TRACE_ERROR_SITE_KEYS
+#define __ERR_SITE_KEY_INIT	.key = STATIC_KEY_INIT_TRUE,
+#define __err_site_on(site)	static_key_true(&(site)->key)
+#else
+#define __ERR_SITE_KEY_INIT
+#define __err_site_on(site)	true
+#endif
+
+/*
+ * When provenance is disabled and the error_set tracepoint is unused, the
+ * call is patched out and ERR() costs a single NOP. Otherwise the only
+ * argument is the address of the site descriptor, which also holds the
+ * errno, so every expansion is the same NOP, address load and call.
+ */
+#define ERR(e) ({							\
+	static struct err_site __aligned(8)				\
+	__attribute__((section("__err_sites"))) __err_site = {		\
+		.file = __FILE__,					\
+		.function = __func__,					\
+		.line = __LINE__,					\
+		.errno = (e),						\
+		.sampler = __err_noisy(e) ? ERR_SAMPLER_NOISY : 0,	\
+		__ERR_SITE_KEY_INIT					\
+	};								\
+	if (static_branch_unlikely(&trace_error_key) &&		\
+	    __err_site_on(&__err_site))					\
+		set_last_err(&__err_site);				\
+	(e);								\
 })
 
 #endif /* __ASSEMBLY__ */
+#else /* !CONFIG_TRACE_ERROR */
+
+/*
+ * Without provenance, which includes every 32-bit build, an error
+ * constant is just itself and nothing is recorded.
+ */
+#define ERR(e)	(e)
+
+#ifndef __ASSEMBLY__
+struct err_capture;
+
+#define trace_error_enabled()	false
+
+static inline void trace_error_count(unsigned int site)
+{
+}
+
+static inline void trace_error_propagate(const struct err_capture *cap,
+					 int status)
+{
+}
+#endif /* __ASSEMBLY__ */
+
 #endif /* CONFIG_TRACE_ERROR */
 
 #endif
@@ -77,6 +77,7 @@ struct uprobe_task {
 	unsigned long			xol_vaddr;
 
 	struct return_instance		*return_instances;
+	struct return_instance		*ri_pool;	/* free, for reuse */
 	unsigned int			depth;
 };
 
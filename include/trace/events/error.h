@@ -0,0 +1,57 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+#undef TRACE_SYSTEM
+#define TRACE_SYSTEM error
+
+#if !defined(_TRACE_ERROR_H) || defined(TRACE_HEADER_MULTI_READ)
+#define _TRACE_ERROR_H
+
+#include <linux/sched.h>
+#include <linux/tracepoint.h>
+#include <linux/trace_error.h>
+#include <asm/syscall.h>
+
+/*
+ * kernel/trace_error.c
+ */
+extern int trace_error_set_reg(void);
+extern void trace_error_set_unreg(void);
+
+/*
+ * An ERR() site was evaluated. @nr is the syscall being run by the
+ * current task, or -1 outside of task context.
+ */
+TRACE_EVENT_FN(error_set,
+
+	TP_PROTO(const struct err_site *site),
+
+	TP_ARGS(site),
+
+	TP_STRUCT__entry(
+		__field(	unsigned int,	site		)
+		__field(	int,		errno		)
+		__field(	int,		nr		)
+		__field(	unsigned int,	line		)
+		__string(	file,		site->file	)
+	),
+
+	TP_fast_assign(
+		__entry->site	= site->id;
+		__entry->errno	= site->errno;
+		__entry->nr	= in_task() && !(current->flags & PF_KTHREAD) ?
+				  syscall_get_nr(current, task_pt_regs(current)) : -1;
+		__entry->line	= site->line;
+		__assign_str(file, site->file);
+	),
+
+	TP_printk("%s:%u errno=%d site=%u nr=%d",
+		  __get_str(file), __entry->line, __entry->errno,
+		  __entry->site, __entry->nr),
+
+	trace_error_set_reg,
+	trace_error_set_unreg
+);
+
+#endif /* _TRACE_ERROR_H */
+
+/* This part must be outside protection */
+#include <trace/define_trace.h>
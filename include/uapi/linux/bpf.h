@@ -3253,6 +3253,20 @@ union bpf_attr {
  * 		case of **BPF_CSUM_LEVEL_QUERY**, the current skb->csum_level
  * 		is returned or the error code -EACCES in case the skb is not
  * 		subject to CHECKSUM_UNNECESSARY.
+ *
+ * long bpf_get_last_err(struct bpf_last_err *err, u32 size)
+ * 	Description
+ * 		Get the provenance of the last error that a system call of
+ * 		the current task returned: the kernel file and line of the
+ * 		**ERR**\ () site, its errno and the system call number.
+ * 		*size* must be **sizeof**\ (struct bpf_last_err). The file
+ * 		name is truncated to fit and always NUL-terminated.
+ *
+ * 		This helper is only available on kernels built with
+ * 		**CONFIG_TRACE_ERROR**.
+ * 	Return
+ * 		0 on success, or a negative error in case of failure.
+ * 		**-ENOENT** if the task has no recorded error.
  */
 #define __BPF_FUNC_MAPPER(FN)		\
 	FN(unspec),			\
@@ -3390,7 +3404,8 @@ union bpf_attr {
 	FN(ringbuf_submit),		\
 	FN(ringbuf_discard),		\
 	FN(ringbuf_query),		\
-	FN(csum_level),
+	FN(csum_level),			\
+	FN(get_last_err),
 
 /* integer value in 'imm' field of BPF_CALL instruction selects which helper
  * function eBPF program intends to call
@@ -4261,4 +4276,13 @@ struct bpf_pidns_info {
 	__u32 pid;
 	__u32 tgid;
 };
+
+/* User bpf_last_err struct to fill by bpf_get_last_err() */
+struct bpf_last_err {
+	__u32 site;
+	__s32 error;
+	__u32 line;
+	__s32 syscall_nr;
+	char file[64];
+};
 #endif /* _UAPI__LINUX_BPF_H__ */
@@ -92,15 +92,24 @@ struct ptrace_syscall_info {
 		struct {
 			__s64 rval;
 			__u8 is_error;
+			__u32 err_site;	/* see below */
 		} exit;
 		struct {
 			__u64 nr;
 			__u64 args[6];
 			__u32 ret_data;
+			__u32 prev_err_site;
 		} seccomp;
 	};
 };
 
+/*
+ * exit.err_site is the /proc/err_sites id of the kernel site that produced
+ * the error returned by the syscall, or 0 if unknown. A seccomp stop
+ * happens before the syscall runs, so seccomp.prev_err_site is the same
+ * for the previous syscall of the tracee.
+ */
+
 /*
  * These values are stored in task->ptrace_message
  * by tracehook_report_syscall_* to describe the current syscall-stop.
@@ -0,0 +1,21 @@
+/* SPDX-License-Identifier: GPL-2.0 WITH Linux-syscall-note */
+#ifndef _UAPI_LINUX_TRACE_ERROR_H
+#define _UAPI_LINUX_TRACE_ERROR_H
+
+#include <linux/types.h>
+
+/*
+ * Record format of /proc/last_errors_raw, one per task with a recorded
+ * error. @site resolves through /proc/err_sites, @error is the positive
+ * errno and @nr the syscall that returned it.
+ */
+struct last_error_record {
+	__s32	tgid;
+	__s32	tid;
+	__u32	site;
+	__s32	error;
+	__s32	nr;
+	__u32	__reserved;
+};
+
+#endif /* _UAPI_LINUX_TRACE_ERROR_H */
@@ -0,0 +1,57 @@
+/* SPDX-License-Identifier: GPL-2.0 WITH Linux-syscall-note */
+#ifndef _UAPI_TRACE_MMAP_H_
+#define _UAPI_TRACE_MMAP_H_
+
+#include <linux/types.h>
+
+/**
+ * struct trace_buffer_meta - Ring-buffer meta-page description.
+ * @meta_page_size:	Size of this meta-page.
+ * @meta_struct_len:	Size of this structure.
+ * @subbuf_size:	Size of each sub-buffer.
+ * @nr_subbufs:		Number of sub-buffers in the ring-buffer, including
+ *			the reader.
+ * @reader.lost_events:	Number of events lost before the reader sub-buffer.
+ * @reader.id:		ID of the sub-buffer currently owned by the reader.
+ * @reader.read:	Offset in the sub-buffer data of the first event handed
+ *			out by the last TRACE_MMAP_IOCTL_GET_READER.
+ * @reader.commit:	Offset in the sub-buffer data past the last event
+ *			handed out by the last TRACE_MMAP_IOCTL_GET_READER.
+ * @entries:		Number of entries in the ring-buffer.
+ * @overrun:		Number of entries lost in the ring-buffer.
+ * @read:		Number of entries that have been read.
+ *
+ * The meta-page is the first page of the mapping, and sub-buffer ID n
+ * follows it at page offset n + 1. Each sub-buffer starts with the
+ * header described in events/header_page.
+ */
+struct trace_buffer_meta {
+	__u32		meta_page_size;
+	__u32		meta_struct_len;
+
+	__u32		subbuf_size;
+	__u32		nr_subbufs;
+
+	struct {
+		__u64	lost_events;
+		__u32	id;
+		__u32	read;
+		__u32	commit;
+		__u32	__reserved;
+	} reader;
+
+	__u64	entries;
+	__u64	overrun;
+	__u64	read;
+};
+
+/*
+ * Hand the events committed since the previous call over to user space,
+ * as [reader.read, reader.commit) in sub-buffer reader.id, and consume
+ * them in the kernel. The range handed out by the previous call may be
+ * overwritten by the writer once this returns. Blocks until there is data
+ * unless the file was opened O_NONBLOCK.
+ */
+#define TRACE_MMAP_IOCTL_GET_READER	_IO('R', 0x20)
+
+#endif /* _UAPI_TRACE_MMAP_H_ */
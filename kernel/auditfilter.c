@@ -229,6 +229,22 @@ static int audit_match_signal(struct audit_entry *entry)
 		return 1;
 	}
 }
+
+/*
+ * Rules on the error site only apply to failing syscalls, and need
+ * nothing collected during the syscall. They are left out of
+ * audit_n_rules so that they do not turn on full syscall auditing; see
+ * __audit_syscall_exit().
+ */
+static int audit_match_err_site(struct audit_entry *entry)
+{
+	int i;
+
+	for (i = 0; i < entry->rule.field_count; i++)
+		if (entry->rule.fields[i].type == AUDIT_ERR_SITE)
+			return 1;
+	return 0;
+}
 #endif
 
 /* Common user-space to kernel rule translation. */
@@ -332,6 +348,12 @@ static int audit_field_valid(struct audit_entry *entry, struct audit_field *f)
 		if (entry->rule.listnr != AUDIT_FILTER_FS)
 			return -ERR(EINVAL);
 		break;
+	case AUDIT_ERR_SITE:
+		/* The site returned by a syscall is only known where scoped */
+		if (entry->rule.listnr != AUDIT_FILTER_EXIT ||
+		    !IS_ENABLED(CONFIG_TRACE_ERROR_SYSCALL_SCOPED))
+			return -ERR(EINVAL);
+		break;
 	}
 
 	switch (entry->rule.listnr) {
@@ -399,6 +421,7 @@ static int audit_field_valid(struct audit_entry *entry, struct audit_field *f)
 	case AUDIT_FILETYPE:
 	case AUDIT_FIELD_COMPARE:
 	case AUDIT_EXE:
+	case AUDIT_ERR_SITE:
 		/* only equal and not equal valid ops */
 		if (f->op != Audit_not_equal && f->op != Audit_equal)
 			return -ERR(EINVAL);
@@ -430,6 +453,11 @@ static int audit_field_valid(struct audit_entry *entry, struct audit_field *f)
 		if (f->val >= AF_MAX)
 			return -ERR(EINVAL);
 		break;
+	case AUDIT_ERR_SITE:
+		/* "not any site" would never match a failing syscall */
+		if (f->op == Audit_not_equal && !f->val)
+			return -ERR(EINVAL);
+		break;
 	default:
 		break;
 	}
@@ -437,6 +465,40 @@ static int audit_field_valid(struct audit_entry *entry, struct audit_field *f)
 	return 0;
 }
 
+/*
+ * Rules on the error site are left out of audit_n_rules, so no names are
+ * collected during the syscalls they see. Refuse the fields that are
+ * matched against names instead of letting such rules never match.
+ */
+static int audit_err_site_valid(struct audit_krule *rule)
+{
+	bool err_site = false, names = false;
+	int i;
+
+	for (i = 0; i < rule->field_count; i++) {
+		switch (rule->fields[i].type) {
+		case AUDIT_ERR_SITE:
+			err_site = true;
+			break;
+		case AUDIT_WATCH:
+		case AUDIT_DIR:
+		case AUDIT_INODE:
+		case AUDIT_PERM:
+		case AUDIT_FILETYPE:
+		case AUDIT_DEVMAJOR:
+		case AUDIT_DEVMINOR:
+		case AUDIT_OBJ_UID:
+		case AUDIT_OBJ_GID:
+			names = true;
+			break;
+		}
+	}
+
+	if (err_site && names)
+		return -ERR(EINVAL);
+	return 0;
+}
+
 /* Translate struct audit_rule_data to kernel's rule representation. */
 static struct audit_entry *audit_data_to_entry(struct audit_rule_data *data,
 					       size_t datasz)
@@ -596,6 +658,10 @@ static struct audit_entry *audit_data_to_entry(struct audit_rule_data *data,
 		}
 	}
 
+	err = audit_err_site_valid(&entry->rule);
+	if (err)
+		goto exit_free;
+
 	if (entry->rule.inode_f && entry->rule.inode_f->op == Audit_not_equal)
 		entry->rule.inode_f = NULL;
 
@@ -944,6 +1010,8 @@ static inline int audit_add_rule(struct audit_entry *entry)
 	case AUDIT_FILTER_FS:
 		dont_count = 1;
 	}
+	if (audit_match_err_site(entry))
+		dont_count = 1;
 #endif
 
 	mutex_lock(&audit_filter_mutex);
@@ -1000,6 +1068,8 @@ static inline int audit_add_rule(struct audit_entry *entry)
 #ifdef CONFIG_AUDITSYSCALL
 	if (!dont_count)
 		audit_n_rules++;
+	else if (audit_match_err_site(entry))
+		audit_err_site_rules++;
 
 	if (!audit_match_signal(entry))
 		audit_signals++;
@@ -1026,6 +1096,8 @@ int audit_del_rule(struct audit_entry *entry)
 	case AUDIT_FILTER_FS:
 		dont_count = 1;
 	}
+	if (audit_match_err_site(entry))
+		dont_count = 1;
 #endif
 
 	mutex_lock(&audit_filter_mutex);
@@ -1047,6 +1119,8 @@ int audit_del_rule(struct audit_entry *entry)
 #ifdef CONFIG_AUDITSYSCALL
 	if (!dont_count)
 		audit_n_rules--;
+	else if (audit_match_err_site(entry))
+		audit_err_site_rules--;
 
 	if (!audit_match_signal(entry))
 		audit_signals--;
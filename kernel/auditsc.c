@@ -96,6 +96,9 @@ int audit_n_rules;
 /* determines whether we collect data for signals sent */
 int audit_signals;
 
+/* number of rules on the error site, evaluated for failing syscalls only */
+int audit_err_site_rules;
+
 struct audit_aux_data {
 	struct audit_aux_data	*next;
 	int			type;
@@ -457,6 +460,7 @@ static int audit_filter_rules(struct task_struct *tsk,
 	int i, need_sid = 1;
 	u32 sid;
 	unsigned int sessionid;
+	unsigned int err_site = 0;
 
 	cred = rcu_dereference_check(tsk->cred, tsk == current || task_creation);
 
@@ -639,6 +643,13 @@ static int audit_filter_rules(struct task_struct *tsk,
 				result = audit_comparator(ctx->sockaddr->ss_family,
 							  f->op, f->val);
 			break;
+		case AUDIT_ERR_SITE:
+			if (ctx && ctx->return_valid == AUDITSC_FAILURE)
+				err_site = trace_error_syscall_site(tsk);
+			if (err_site)
+				result = !f->val ||
+					 audit_comparator(err_site, f->op, f->val);
+			break;
 		case AUDIT_SUBJ_USER:
 		case AUDIT_SUBJ_ROLE:
 		case AUDIT_SUBJ_TYPE:
@@ -731,6 +742,8 @@ static int audit_filter_rules(struct task_struct *tsk,
 			kfree(ctx->filterkey);
 			ctx->filterkey = kstrdup(rule->filterkey, GFP_ATOMIC);
 		}
+		if (err_site)
+			ctx->err_site = err_site;
 		ctx->prio = rule->prio;
 	}
 	switch (rule->action) {
@@ -1452,6 +1465,32 @@ static void audit_log_proctitle(void)
 	audit_log_end(ab);
 }
 
+#ifdef CONFIG_TRACE_ERROR
+static void audit_log_err_origin(struct audit_context *context)
+{
+	const struct err_site *site;
+	struct audit_buffer *ab;
+
+	ab = audit_log_start(context, GFP_KERNEL, AUDIT_ERR_ORIGIN);
+	if (!ab)
+		return;
+
+	audit_log_format(ab, "site=%u", context->err_site);
+	rcu_read_lock();
+	site = err_site_find(context->err_site);
+	if (site)
+		audit_log_format(ab, " file=%s line=%u func=%s errno=%d",
+				 site->file, site->line, site->function,
+				 site->errno);
+	rcu_read_unlock();
+	audit_log_end(ab);
+}
+#else
+static inline void audit_log_err_origin(struct audit_context *context)
+{
+}
+#endif
+
 static void audit_log_exit(void)
 {
 	int i, call_panic = 0;
@@ -1486,6 +1525,9 @@ static void audit_log_exit(void)
 	audit_log_key(ab, context->filterkey);
 	audit_log_end(ab);
 
+	if (context->err_site)
+		audit_log_err_origin(context);
+
 	for (aux = context->aux; aux; aux = aux->next) {
 
 		ab = audit_log_start(context, GFP_KERNEL, aux->type);
@@ -1693,7 +1735,12 @@ void __audit_syscall_exit(int success, long return_code)
 	if (!list_empty(&context->killed_trees))
 		audit_kill_trees(context);
 
-	if (!context->dummy && context->in_syscall) {
+	/*
+	 * A dummy context collected nothing during the syscall, which is
+	 * all the rules on the error site need to look at a failure.
+	 */
+	if (context->in_syscall &&
+	    (!context->dummy || (!success && audit_err_site_rules))) {
 		if (success)
 			context->return_valid = AUDITSC_SUCCESS;
 		else
@@ -1738,6 +1785,7 @@ void __audit_syscall_exit(int success, long return_code)
 	context->sockaddr_len = 0;
 	context->type = 0;
 	context->fds[0] = -1;
+	context->err_site = 0;
 	if (context->state != AUDIT_RECORD_CONTEXT) {
 		kfree(context->filterkey);
 		context->filterkey = NULL;
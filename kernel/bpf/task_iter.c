@@ -69,12 +69,21 @@ static void *task_seq_next(struct seq_file *seq, void *v, loff_t *pos)
 	return task;
 }
 
+/* @last_err is the site of the task's last error, or NULL if it has none. */
 struct bpf_iter__task {
 	__bpf_md_ptr(struct bpf_iter_meta *, meta);
 	__bpf_md_ptr(struct task_struct *, task);
+#ifdef CONFIG_TRACE_ERROR
+	__bpf_md_ptr(struct err_site *, last_err);
+#endif
 };
 
+#ifdef CONFIG_TRACE_ERROR
+DEFINE_BPF_ITER_FUNC(task, struct bpf_iter_meta *meta, struct task_struct *task,
+		     struct err_site *last_err)
+#else
 DEFINE_BPF_ITER_FUNC(task, struct bpf_iter_meta *meta, struct task_struct *task)
+#endif
 
 static int __task_seq_show(struct seq_file *seq, struct task_struct *task,
 			   bool in_stop)
@@ -82,6 +91,7 @@ static int __task_seq_show(struct seq_file *seq, struct task_struct *task,
 	struct bpf_iter_meta meta;
 	struct bpf_iter__task ctx;
 	struct bpf_prog *prog;
+	int ret;
 
 	meta.seq = seq;
 	prog = bpf_iter_get_info(&meta, in_stop);
@@ -91,7 +101,17 @@ static int __task_seq_show(struct seq_file *seq, struct task_struct *task,
 	meta.seq = seq;
 	ctx.meta = &meta;
 	ctx.task = task;
-	return bpf_iter_run_prog(prog, &ctx);
+
+	/* Keeps a module's site alive while the program reads it. */
+	rcu_read_lock();
+#ifdef CONFIG_TRACE_ERROR
+	ctx.last_err = task ? (struct err_site *)
+		err_site_find(last_err_site(READ_ONCE(task->last_err.last))) : NULL;
+#endif
+	ret = bpf_iter_run_prog(prog, &ctx);
+	rcu_read_unlock();
+
+	return ret;
 }
 
 static int task_seq_show(struct seq_file *seq, void *v)
@@ -318,10 +338,18 @@ static const struct bpf_iter_reg task_reg_info = {
 	.init_seq_private	= init_seq_pidns,
 	.fini_seq_private	= fini_seq_pidns,
 	.seq_priv_size		= sizeof(struct bpf_iter_seq_task_info),
+#ifdef CONFIG_TRACE_ERROR
+	.ctx_arg_info_size	= 2,
+#else
 	.ctx_arg_info_size	= 1,
+#endif
 	.ctx_arg_info		= {
 		{ offsetof(struct bpf_iter__task, task),
 		  PTR_TO_BTF_ID_OR_NULL },
+#ifdef CONFIG_TRACE_ERROR
+		{ offsetof(struct bpf_iter__task, last_err),
+		  PTR_TO_BTF_ID_OR_NULL },
+#endif
 	},
 };
 
@@ -3540,6 +3540,14 @@ static int cpu_stat_show(struct seq_file *seq, void *v)
 	return ret;
 }
 
+#ifdef CONFIG_TRACE_ERROR_CGROUP
+static int errors_stat_show(struct seq_file *seq, void *v)
+{
+	cgroup_err_stat_show(seq);
+	return 0;
+}
+#endif
+
 #ifdef CONFIG_PSI
 static int cgroup_io_pressure_show(struct seq_file *seq, void *v)
 {
@@ -4876,6 +4884,13 @@ static struct cftype cgroup_base_files[] = {
 		.name = "cpu.stat",
 		.seq_show = cpu_stat_show,
 	},
+#ifdef CONFIG_TRACE_ERROR_CGROUP
+	{
+		.name = "errors.stat",
+		.flags = CFTYPE_NOT_ON_ROOT,
+		.seq_show = errors_stat_show,
+	},
+#endif
 #ifdef CONFIG_PSI
 	{
 		.name = "io.pressure",
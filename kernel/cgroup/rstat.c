@@ -2,11 +2,14 @@
 #include "cgroup-internal.h"
 
 #include <linux/sched/cputime.h>
+#include <linux/trace_error.h>
+#include <linux/sort.h>
 
 static DEFINE_SPINLOCK(cgroup_rstat_lock);
 static DEFINE_PER_CPU(raw_spinlock_t, cgroup_rstat_cpu_lock);
 
 static void cgroup_base_stat_flush(struct cgroup *cgrp, int cpu);
+static void cgroup_err_stat_flush(struct cgroup *cgrp, int cpu);
 
 static struct cgroup_rstat_cpu *cgroup_rstat_cpu(struct cgroup *cgrp, int cpu)
 {
@@ -156,6 +159,7 @@ static void cgroup_rstat_flush_locked(struct cgroup *cgrp, bool may_sleep)
 			struct cgroup_subsys_state *css;
 
 			cgroup_base_stat_flush(pos, cpu);
+			cgroup_err_stat_flush(pos, cpu);
 
 			rcu_read_lock();
 			list_for_each_entry_rcu(css, &pos->rstat_css_list,
@@ -256,6 +260,9 @@ int cgroup_rstat_init(struct cgroup *cgrp)
 
 		rstatc->updated_children = cgrp;
 		u64_stats_init(&rstatc->bsync);
+#ifdef CONFIG_TRACE_ERROR_CGROUP
+		seqcount_init(&rstatc->err_seq);
+#endif
 	}
 
 	return 0;
@@ -455,3 +462,162 @@ void cgroup_base_stat_cputime_show(struct seq_file *seq)
 		   "system_usec %llu\n",
 		   usage, utime, stime);
 }
+
+#ifdef CONFIG_TRACE_ERROR_CGROUP
+/*
+ * Error site accounting implemented on top of rstat.  Each cpu counts the
+ * sites hit by a cgroup's tasks in a small per-cpu table, and flushing
+ * folds the deltas into ->err_stat of the cgroup and all its ancestors.
+ *
+ * ->err_stat keeps the most frequent sites with the space-saving
+ * algorithm: a site missing from a full table takes over the least
+ * frequent slot and inherits its count.  Counts may thus be overestimated
+ * but a frequent site is never missed.
+ */
+static struct cgroup_err_stat *
+cgroup_err_stat_slot(struct cgroup_rstat_cpu *rstatc, unsigned int site)
+{
+	struct cgroup_err_stat *free = NULL;
+	int i;
+
+	for (i = 0; i < CGROUP_ERR_STAT_CPU_SLOTS; i++) {
+		struct cgroup_err_stat *stat = &rstatc->err_stat[i];
+		struct cgroup_err_stat *last = &rstatc->last_err_stat[i];
+
+		if (stat->site == site)
+			return stat;
+		if (free)
+			continue;
+		/* pairs with smp_store_release() in cgroup_err_stat_flush() */
+		if (!stat->site ||
+		    (smp_load_acquire(&last->site) == stat->site &&
+		     READ_ONCE(last->count) == stat->count))
+			free = stat;
+	}
+
+	if (free) {
+		free->site = site;
+		free->count = 0;
+	}
+	return free;
+}
+
+void __cgroup_account_error(struct cgroup *cgrp, unsigned int site)
+{
+	struct cgroup_rstat_cpu *rstatc;
+	struct cgroup_err_stat *stat;
+	int cpu;
+
+	cpu = get_cpu();
+	rstatc = cgroup_rstat_cpu(cgrp, cpu);
+
+	write_seqcount_begin(&rstatc->err_seq);
+	stat = cgroup_err_stat_slot(rstatc, site);
+	if (stat)
+		stat->count++;
+	else
+		rstatc->err_dropped++;
+	write_seqcount_end(&rstatc->err_seq);
+
+	cgroup_rstat_updated(cgrp, cpu);
+	put_cpu();
+}
+
+static void cgroup_err_stat_add(struct cgroup *cgrp, unsigned int site,
+				u64 delta)
+{
+	struct cgroup_err_stat *min = NULL;
+	int i;
+
+	for (i = 0; i < CGROUP_ERR_STAT_SLOTS; i++) {
+		struct cgroup_err_stat *stat = &cgrp->err_stat[i];
+
+		if (stat->site == site) {
+			stat->count += delta;
+			return;
+		}
+		if (!min || stat->count < min->count)
+			min = stat;
+	}
+
+	min->site = site;
+	min->count += delta;
+}
+
+static void cgroup_err_stat_flush(struct cgroup *cgrp, int cpu)
+{
+	struct cgroup_rstat_cpu *rstatc = cgroup_rstat_cpu(cgrp, cpu);
+	struct cgroup_err_stat cur[CGROUP_ERR_STAT_CPU_SLOTS];
+	struct cgroup *pos;
+	u64 dropped, delta;
+	unsigned int seq;
+	int i;
+
+	do {
+		seq = read_seqcount_begin(&rstatc->err_seq);
+		memcpy(cur, rstatc->err_stat, sizeof(cur));
+		dropped = rstatc->err_dropped;
+	} while (read_seqcount_retry(&rstatc->err_seq, seq));
+
+	for (i = 0; i < CGROUP_ERR_STAT_CPU_SLOTS; i++) {
+		struct cgroup_err_stat *last = &rstatc->last_err_stat[i];
+
+		if (!cur[i].site)
+			continue;
+
+		delta = cur[i].count;
+		if (last->site == cur[i].site)
+			delta -= last->count;
+
+		/* the slot may be reused once both match */
+		WRITE_ONCE(last->count, cur[i].count);
+		smp_store_release(&last->site, cur[i].site);
+
+		if (!delta)
+			continue;
+		for (pos = cgrp; cgroup_parent(pos); pos = cgroup_parent(pos))
+			cgroup_err_stat_add(pos, cur[i].site, delta);
+	}
+
+	delta = dropped - rstatc->last_err_dropped;
+	rstatc->last_err_dropped = dropped;
+	for (pos = cgrp; cgroup_parent(pos); pos = cgroup_parent(pos))
+		pos->err_dropped += delta;
+}
+
+static int cgroup_err_stat_cmp(const void *a, const void *b)
+{
+	const struct cgroup_err_stat *x = a, *y = b;
+
+	if (x->count != y->count)
+		return x->count > y->count ? -1 : 1;
+	return 0;
+}
+
+void cgroup_err_stat_show(struct seq_file *seq)
+{
+	struct cgroup *cgrp = seq_css(seq)->cgroup;
+	struct cgroup_err_stat stats[CGROUP_ERR_STAT_SLOTS];
+	u64 dropped;
+	int i;
+
+	cgroup_rstat_flush_hold(cgrp);
+	memcpy(stats, cgrp->err_stat, sizeof(stats));
+	dropped = cgrp->err_dropped;
+	cgroup_rstat_flush_release();
+
+	sort(stats, CGROUP_ERR_STAT_SLOTS, sizeof(stats[0]),
+	     cgroup_err_stat_cmp, NULL);
+
+	for (i = 0; i < CGROUP_ERR_STAT_SLOTS && stats[i].site; i++) {
+		if (!seq_print_err_site(seq, stats[i].site))
+			seq_printf(seq, "site:%u", stats[i].site);
+		seq_printf(seq, " %llu\n", stats[i].count);
+	}
+	seq_printf(seq, "dropped %llu\n", dropped);
+}
+#else
+static void cgroup_err_stat_flush(struct cgroup *cgrp, int cpu)
+{
+}
+#endif
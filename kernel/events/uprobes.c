@@ -27,6 +27,7 @@
 #include <linux/task_work.h>
 #include <linux/shmem_fs.h>
 #include <linux/khugepaged.h>
+#include <linux/srcu.h>
 
 #include <linux/uprobes.h>
 
@@ -41,6 +42,14 @@ static struct rb_root uprobes_tree = RB_ROOT;
 #define no_uprobe_events()	RB_EMPTY_ROOT(&uprobes_tree)
 
 static DEFINE_SPINLOCK(uprobes_treelock);	/* serialize rbtree access */
+static seqcount_t uprobes_seqcount = SEQCNT_ZERO(uprobes_seqcount);
+
+/*
+ * Breakpoint hits look up and run uprobes under uprobes_srcu without
+ * taking uprobes_treelock or a reference; a uprobe is freed only after
+ * an SRCU grace period following its last put_uprobe().
+ */
+DEFINE_STATIC_SRCU(uprobes_srcu);
 
 #define UPROBES_HASH_SZ	13
 /* serialize uprobe->pending_list */
@@ -75,6 +84,7 @@ struct uprobe {
 	 *		line, copied to xol_area by xol_get_insn_slot().
 	 */
 	struct arch_uprobe	arch;
+	struct rcu_head		rcu;
 };
 
 struct delayed_uprobe {
@@ -598,6 +608,22 @@ static struct uprobe *get_uprobe(struct uprobe *uprobe)
 	return uprobe;
 }
 
+/*
+ * For a uprobe found under uprobes_srcu, which may already have dropped
+ * its last reference.
+ */
+static struct uprobe *try_get_uprobe(struct uprobe *uprobe)
+{
+	if (refcount_inc_not_zero(&uprobe->ref))
+		return uprobe;
+	return NULL;
+}
+
+static void uprobe_free_srcu(struct rcu_head *rcu)
+{
+	kfree(container_of(rcu, struct uprobe, rcu));
+}
+
 static void put_uprobe(struct uprobe *uprobe)
 {
 	if (refcount_dec_and_test(&uprobe->ref)) {
@@ -609,7 +635,7 @@ static void put_uprobe(struct uprobe *uprobe)
 		mutex_lock(&delayed_uprobe_lock);
 		delayed_uprobe_remove(uprobe, NULL);
 		mutex_unlock(&delayed_uprobe_lock);
-		kfree(uprobe);
+		call_srcu(&uprobes_srcu, &uprobe->rcu, uprobe_free_srcu);
 	}
 }
 
@@ -666,6 +692,41 @@ static struct uprobe *find_uprobe(struct inode *inode, loff_t offset)
 	return uprobe;
 }
 
+/*
+ * Find a uprobe corresponding to a given inode:offset without taking
+ * uprobes_treelock or a reference; the caller must hold uprobes_srcu.
+ *
+ * The walk can race with a rebalance and miss a uprobe that is in the
+ * tree, but never loops or leaves it; a miss is only trusted if no
+ * insertion or removal happened during the walk.
+ */
+static struct uprobe *find_uprobe_srcu(struct inode *inode, loff_t offset)
+{
+	struct uprobe u = { .inode = inode, .offset = offset };
+	struct uprobe *uprobe;
+	struct rb_node *n;
+	unsigned int seq;
+	int match;
+
+	do {
+		seq = read_seqcount_begin(&uprobes_seqcount);
+		n = rcu_dereference_raw(uprobes_tree.rb_node);
+		while (n) {
+			uprobe = rb_entry(n, struct uprobe, rb_node);
+			match = match_uprobe(&u, uprobe);
+			if (!match)
+				return uprobe;
+
+			if (match < 0)
+				n = rcu_dereference_raw(n->rb_left);
+			else
+				n = rcu_dereference_raw(n->rb_right);
+		}
+	} while (read_seqcount_retry(&uprobes_seqcount, seq));
+
+	return NULL;
+}
+
 static struct uprobe *__insert_uprobe(struct uprobe *uprobe)
 {
 	struct rb_node **p = &uprobes_tree.rb_node;
@@ -688,10 +749,10 @@ static struct uprobe *__insert_uprobe(struct uprobe *uprobe)
 	}
 
 	u = NULL;
-	rb_link_node(&uprobe->rb_node, parent, p);
-	rb_insert_color(&uprobe->rb_node, &uprobes_tree);
 	/* get access + creation ref */
 	refcount_set(&uprobe->ref, 2);
+	rb_link_node_rcu(&uprobe->rb_node, parent, p);
+	rb_insert_color(&uprobe->rb_node, &uprobes_tree);
 
 	return u;
 }
@@ -709,7 +770,9 @@ static struct uprobe *insert_uprobe(struct uprobe *uprobe)
 	struct uprobe *u;
 
 	spin_lock(&uprobes_treelock);
+	write_seqcount_begin(&uprobes_seqcount);
 	u = __insert_uprobe(uprobe);
+	write_seqcount_end(&uprobes_seqcount);
 	spin_unlock(&uprobes_treelock);
 
 	return u;
@@ -943,7 +1006,9 @@ static void delete_uprobe(struct uprobe *uprobe)
 		return;
 
 	spin_lock(&uprobes_treelock);
+	write_seqcount_begin(&uprobes_seqcount);
 	rb_erase(&uprobe->rb_node, &uprobes_tree);
+	write_seqcount_end(&uprobes_seqcount);
 	spin_unlock(&uprobes_treelock);
 	RB_CLEAR_NODE(&uprobe->rb_node); /* for uprobe_is_active() */
 	put_uprobe(uprobe);
@@ -1702,11 +1767,35 @@ unsigned long uprobe_get_trap_addr(struct pt_regs *regs)
 	return instruction_pointer(regs);
 }
 
-static struct return_instance *free_ret_instance(struct return_instance *ri)
+/*
+ * Return instances are recycled through a per-task pool, which never
+ * holds more than the deepest nesting the task has reached, so that
+ * hitting a uretprobe does not go to the allocator.
+ */
+static struct return_instance *alloc_ret_instance(struct uprobe_task *utask)
+{
+	struct return_instance *ri = utask->ri_pool;
+
+	if (likely(ri)) {
+		utask->ri_pool = ri->next;
+		return ri;
+	}
+	return kmalloc(sizeof(struct return_instance), GFP_KERNEL);
+}
+
+static void recycle_ret_instance(struct uprobe_task *utask,
+				 struct return_instance *ri)
+{
+	ri->next = utask->ri_pool;
+	utask->ri_pool = ri;
+}
+
+static struct return_instance *free_ret_instance(struct uprobe_task *utask,
+						 struct return_instance *ri)
 {
 	struct return_instance *next = ri->next;
 	put_uprobe(ri->uprobe);
-	kfree(ri);
+	recycle_ret_instance(utask, ri);
 	return next;
 }
 
@@ -1727,7 +1816,12 @@ void uprobe_free_utask(struct task_struct *t)
 
 	ri = utask->return_instances;
 	while (ri)
-		ri = free_ret_instance(ri);
+		ri = free_ret_instance(utask, ri);
+
+	while ((ri = utask->ri_pool)) {
+		utask->ri_pool = ri->next;
+		kfree(ri);
+	}
 
 	xol_free_insn_slot(t);
 	kfree(utask);
@@ -1852,7 +1946,7 @@ static void cleanup_return_instances(struct uprobe_task *utask, bool chained,
 	enum rp_check ctx = chained ? RP_CHECK_CHAIN_CALL : RP_CHECK_CALL;
 
 	while (ri && !arch_uretprobe_is_alive(ri, ctx, regs)) {
-		ri = free_ret_instance(ri);
+		ri = free_ret_instance(utask, ri);
 		utask->depth--;
 	}
 	utask->return_instances = ri;
@@ -1879,7 +1973,7 @@ static void prepare_uretprobe(struct uprobe *uprobe, struct pt_regs *regs)
 		return;
 	}
 
-	ri = kmalloc(sizeof(struct return_instance), GFP_KERNEL);
+	ri = alloc_ret_instance(utask);
 	if (!ri)
 		return;
 
@@ -1909,6 +2003,7 @@ static void prepare_uretprobe(struct uprobe *uprobe, struct pt_regs *regs)
 		orig_ret_vaddr = utask->return_instances->orig_ret_vaddr;
 	}
 
+	/* Safe under ->register_rwsem, a uprobe with consumers is in the tree */
 	ri->uprobe = get_uprobe(uprobe);
 	ri->func = instruction_pointer(regs);
 	ri->stack = user_stack_pointer(regs);
@@ -1921,7 +2016,7 @@ static void prepare_uretprobe(struct uprobe *uprobe, struct pt_regs *regs)
 
 	return;
  fail:
-	kfree(ri);
+	recycle_ret_instance(utask, ri);
 }
 
 /* Prepare to single-step probed instruction out of line. */
@@ -2041,6 +2136,10 @@ static int is_trap_at_addr(struct mm_struct *mm, unsigned long vaddr)
 	return is_trap_insn(&opcode);
 }
 
+/*
+ * Called under uprobes_srcu; the returned uprobe is not referenced and
+ * is only valid until srcu_read_unlock().
+ */
 static struct uprobe *find_active_uprobe(unsigned long bp_vaddr, int *is_swbp)
 {
 	struct mm_struct *mm = current->mm;
@@ -2054,7 +2153,7 @@ static struct uprobe *find_active_uprobe(unsigned long bp_vaddr, int *is_swbp)
 			struct inode *inode = file_inode(vma->vm_file);
 			loff_t offset = vaddr_to_offset(vma, bp_vaddr);
 
-			uprobe = find_uprobe(inode, offset);
+			uprobe = find_uprobe_srcu(inode, offset);
 		}
 
 		if (!uprobe)
@@ -2156,7 +2255,7 @@ static void handle_trampoline(struct pt_regs *regs)
 		do {
 			if (valid)
 				handle_uretprobe_chain(ri, regs);
-			ri = free_ret_instance(ri);
+			ri = free_ret_instance(utask, ri);
 			utask->depth--;
 		} while (ri != next);
 	} while (!valid);
@@ -2190,11 +2289,14 @@ static void handle_swbp(struct pt_regs *regs)
 	struct uprobe *uprobe;
 	unsigned long bp_vaddr;
 	int uninitialized_var(is_swbp);
+	int srcu_idx;
 
 	bp_vaddr = uprobe_get_swbp_addr(regs);
 	if (bp_vaddr == get_trampoline_vaddr())
 		return handle_trampoline(regs);
 
+	srcu_idx = srcu_read_lock(&uprobes_srcu);
+
 	uprobe = find_active_uprobe(bp_vaddr, &is_swbp);
 	if (!uprobe) {
 		if (is_swbp > 0) {
@@ -2211,7 +2313,7 @@ static void handle_swbp(struct pt_regs *regs)
 			 */
 			instruction_pointer_set(regs, bp_vaddr);
 		}
-		return;
+		goto out;
 	}
 
 	/* change it in advance for ->handler() and restart */
@@ -2246,12 +2348,16 @@ static void handle_swbp(struct pt_regs *regs)
 	if (arch_uprobe_skip_sstep(&uprobe->arch, regs))
 		goto out;
 
-	if (!pre_ssout(uprobe, regs, bp_vaddr))
-		return;
+	/* ->active_uprobe outlives the SRCU section, pin it */
+	if (!try_get_uprobe(uprobe))
+		goto out;
+
+	if (pre_ssout(uprobe, regs, bp_vaddr))
+		put_uprobe(uprobe);
 
 	/* arch_uprobe_skip_sstep() succeeded, or restart if can't singlestep */
 out:
-	put_uprobe(uprobe);
+	srcu_read_unlock(&uprobes_srcu, srcu_idx);
 }
 
 /*
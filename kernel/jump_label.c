@@ -22,6 +22,12 @@
 /* mutex to protect coming/going of the the jump_label table */
 static DEFINE_MUTEX(jump_label_mutex);
 
+/* set between static_key_batch_begin() and static_key_batch_end() */
+static bool jump_label_batching;
+#ifdef HAVE_JUMP_LABEL_BATCH
+static void jump_label_batch_apply(void);
+#endif
+
 void jump_label_lock(void)
 {
 	mutex_lock(&jump_label_mutex);
@@ -217,6 +223,59 @@ void static_key_disable(struct static_key *key)
 }
 EXPORT_SYMBOL_GPL(static_key_disable);
 
+/*
+ * Switch many keys at once.  The jump sites of all keys set with
+ * static_key_batch_set() between static_key_batch_begin() and
+ * static_key_batch_end() are collected, sorted by address and queued
+ * together by static_key_batch_end().  The arch queue must be filled in
+ * address order (x86 flushes it whenever the order breaks), so the text
+ * is then patched, and all CPUs synchronized, once per full arch queue
+ * (256 sites on x86) rather than once per key.  Without
+ * HAVE_JUMP_LABEL_BATCH every site is still patched on its own.
+ *
+ * The new state of a key is visible before its text is patched, so this
+ * is only meant for keys that are switched with static_key_enable() and
+ * static_key_disable(), never counted.
+ */
+void static_key_batch_begin(void)
+{
+	cpus_read_lock();
+	jump_label_lock();
+	jump_label_batching = true;
+}
+EXPORT_SYMBOL_GPL(static_key_batch_begin);
+
+void static_key_batch_set(struct static_key *key, bool enable)
+{
+	STATIC_KEY_CHECK_USE(key);
+	lockdep_assert_held(&jump_label_mutex);
+
+	if (enable) {
+		if (atomic_read(&key->enabled) != 0) {
+			WARN_ON_ONCE(atomic_read(&key->enabled) != 1);
+			return;
+		}
+		atomic_set(&key->enabled, -1);
+		jump_label_update(key);
+		atomic_set_release(&key->enabled, 1);
+	} else {
+		if (atomic_cmpxchg(&key->enabled, 1, 0) == 1)
+			jump_label_update(key);
+	}
+}
+EXPORT_SYMBOL_GPL(static_key_batch_set);
+
+void static_key_batch_end(void)
+{
+	jump_label_batching = false;
+#ifdef HAVE_JUMP_LABEL_BATCH
+	jump_label_batch_apply();
+#endif
+	jump_label_unlock();
+	cpus_read_unlock();
+}
+EXPORT_SYMBOL_GPL(static_key_batch_end);
+
 static bool static_key_slow_try_dec(struct static_key *key)
 {
 	int val;
@@ -428,6 +487,80 @@ static void __jump_label_update(struct static_key *key,
 	}
 }
 #else
+/*
+ * Entries of the keys switched in a static_key_batch_begin() section,
+ * to be queued in address order by jump_label_batch_apply(). The state
+ * of their key is only read when they are queued.
+ */
+static struct jump_entry **jump_label_batch;
+static unsigned int jump_label_batch_nr, jump_label_batch_size;
+
+static bool jump_label_batch_add(struct jump_entry *entry)
+{
+	struct jump_entry **batch;
+	unsigned int size;
+
+	if (jump_label_batch_nr == jump_label_batch_size) {
+		size = max(2 * jump_label_batch_size, 256U);
+		batch = krealloc(jump_label_batch, size * sizeof(*batch),
+				 GFP_KERNEL);
+		/* Queue it right away; only the order of the batch suffers */
+		if (!batch)
+			return false;
+		jump_label_batch = batch;
+		jump_label_batch_size = size;
+	}
+	jump_label_batch[jump_label_batch_nr++] = entry;
+	return true;
+}
+
+static int jump_label_batch_cmp(const void *a, const void *b)
+{
+	unsigned long x = jump_entry_code(*(struct jump_entry **)a);
+	unsigned long y = jump_entry_code(*(struct jump_entry **)b);
+
+	if (x < y)
+		return -1;
+	if (x > y)
+		return 1;
+	return 0;
+}
+
+static void jump_label_queue(struct jump_entry *entry)
+{
+	if (!arch_jump_label_transform_queue(entry, jump_label_type(entry))) {
+		/*
+		 * Queue is full: Apply the current queue and try again.
+		 */
+		arch_jump_label_transform_apply();
+		BUG_ON(!arch_jump_label_transform_queue(entry, jump_label_type(entry)));
+	}
+}
+
+static void jump_label_batch_apply(void)
+{
+	struct jump_entry *prev = NULL;
+	unsigned int i;
+
+	lockdep_assert_held(&jump_label_mutex);
+
+	sort(jump_label_batch, jump_label_batch_nr, sizeof(*jump_label_batch),
+	     jump_label_batch_cmp, NULL);
+
+	for (i = 0; i < jump_label_batch_nr; i++) {
+		/* A key switched more than once in the batch */
+		if (jump_label_batch[i] == prev)
+			continue;
+		prev = jump_label_batch[i];
+		jump_label_queue(prev);
+	}
+	arch_jump_label_transform_apply();
+
+	kfree(jump_label_batch);
+	jump_label_batch = NULL;
+	jump_label_batch_nr = jump_label_batch_size = 0;
+}
+
 static void __jump_label_update(struct static_key *key,
 				struct jump_entry *entry,
 				struct jump_entry *stop,
@@ -438,15 +571,14 @@ static void __jump_label_update(struct static_key *key,
 		if (!jump_label_can_update(entry, init))
 			continue;
 
-		if (!arch_jump_label_transform_queue(entry, jump_label_type(entry))) {
-			/*
-			 * Queue is full: Apply the current queue and try again.
-			 */
-			arch_jump_label_transform_apply();
-			BUG_ON(!arch_jump_label_transform_queue(entry, jump_label_type(entry)));
-		}
+		/* static_key_batch_end() queues and applies these */
+		if (jump_label_batching && jump_label_batch_add(entry))
+			continue;
+
+		jump_label_queue(entry);
 	}
-	arch_jump_label_transform_apply();
+	if (!jump_label_batching)
+		arch_jump_label_transform_apply();
 }
 #endif
 
@@ -3200,6 +3200,11 @@ static int find_module_sections(struct module *mod, struct load_info *info)
 					sizeof(*mod->jump_entries),
 					&mod->num_jump_entries);
 #endif
+#ifdef CONFIG_TRACE_ERROR
+	mod->err_sites = section_objs(info, "__err_sites",
+				      sizeof(*mod->err_sites),
+				      &mod->num_err_sites);
+#endif
 #ifdef CONFIG_EVENT_TRACING
 	mod->trace_events = section_objs(info, "_ftrace_events",
 					 sizeof(*mod->trace_events),
@@ -936,9 +936,13 @@ ptrace_get_syscall_info_seccomp(struct task_struct *child, struct pt_regs *regs,
 	ptrace_get_syscall_info_entry(child, regs, info);
 	info->op = PTRACE_SYSCALL_INFO_SECCOMP;
 	info->seccomp.ret_data = child->ptrace_message;
+	info->seccomp.prev_err_site = trace_error_syscall_site(child);
 
-	/* ret_data is the last field in struct ptrace_syscall_info.seccomp */
-	return offsetofend(struct ptrace_syscall_info, seccomp.ret_data);
+	/*
+	 * prev_err_site is the last field in
+	 * struct ptrace_syscall_info.seccomp
+	 */
+	return offsetofend(struct ptrace_syscall_info, seccomp.prev_err_site);
 }
 
 static unsigned long
@@ -950,9 +954,11 @@ ptrace_get_syscall_info_exit(struct task_struct *child, struct pt_regs *regs,
 	info->exit.is_error = !!info->exit.rval;
 	if (!info->exit.is_error)
 		info->exit.rval = syscall_get_return_value(child, regs);
+	else
+		info->exit.err_site = trace_error_syscall_site(child);
 
-	/* is_error is the last field in struct ptrace_syscall_info.exit */
-	return offsetofend(struct ptrace_syscall_info, exit.is_error);
+	/* err_site is the last field in struct ptrace_syscall_info.exit */
+	return offsetofend(struct ptrace_syscall_info, exit.err_site);
 }
 
 static int
@@ -1054,6 +1054,47 @@ static const struct bpf_func_proto bpf_send_signal_thread_proto = {
 	.arg1_type	= ARG_ANYTHING,
 };
 
+#ifdef CONFIG_TRACE_ERROR
+BPF_CALL_2(bpf_get_last_err, struct bpf_last_err *, err, u32, size)
+{
+	u64 last = READ_ONCE(current->last_err.last);
+	const struct err_site *site;
+	int ret = 0;
+
+	if (unlikely(size != sizeof(*err))) {
+		ret = -ERR(EINVAL);
+		goto err_clear;
+	}
+
+	rcu_read_lock();
+	site = err_site_find(last_err_site(last));
+	if (site) {
+		err->site = site->id;
+		err->error = site->errno;
+		err->line = site->line;
+		err->syscall_nr = last_err_nr(last);
+		strscpy(err->file, site->file, sizeof(err->file));
+	} else {
+		ret = -ERR(ENOENT);
+	}
+	rcu_read_unlock();
+
+	if (!ret)
+		return 0;
+err_clear:
+	memset(err, 0, size);
+	return ret;
+}
+
+static const struct bpf_func_proto bpf_get_last_err_proto = {
+	.func		= bpf_get_last_err,
+	.gpl_only	= false,
+	.ret_type	= RET_INTEGER,
+	.arg1_type	= ARG_PTR_TO_UNINIT_MEM,
+	.arg2_type	= ARG_CONST_SIZE,
+};
+#endif /* CONFIG_TRACE_ERROR */
+
 const struct bpf_func_proto *
 bpf_tracing_func_proto(enum bpf_func_id func_id, const struct bpf_prog *prog)
 {
@@ -1120,6 +1161,10 @@ bpf_tracing_func_proto(enum bpf_func_id func_id, const struct bpf_prog *prog)
 		return &bpf_send_signal_proto;
 	case BPF_FUNC_send_signal_thread:
 		return &bpf_send_signal_thread_proto;
+#ifdef CONFIG_TRACE_ERROR
+	case BPF_FUNC_get_last_err:
+		return &bpf_get_last_err_proto;
+#endif
 	case BPF_FUNC_perf_event_read_value:
 		return &bpf_perf_event_read_value_proto;
 	case BPF_FUNC_get_ns_current_pid_tgid:
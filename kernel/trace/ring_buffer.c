@@ -7,6 +7,7 @@
 #include <linux/trace_events.h>
 #include <linux/ring_buffer.h>
 #include <linux/trace_clock.h>
+#include <linux/trace_mmap.h>
 #include <linux/sched/clock.h>
 #include <linux/trace_seq.h>
 #include <linux/spinlock.h>
@@ -25,7 +26,9 @@
 #include <linux/list.h>
 #include <linux/cpu.h>
 #include <linux/oom.h>
+#include <linux/mm.h>
 
+#include <asm/cacheflush.h>
 #include <asm/local.h>
 
 static void update_pages_handler(struct work_struct *work);
@@ -318,6 +321,7 @@ struct buffer_page {
 	struct list_head list;		/* list of buffer pages */
 	local_t		 write;		/* index for next write */
 	unsigned	 read;		/* index for next read */
+	unsigned	 id;		/* index in the user space mapping */
 	local_t		 entries;	/* entries on this page */
 	unsigned long	 real_end;	/* real end of data */
 	struct buffer_data_page *page;	/* Actual data page */
@@ -479,6 +483,12 @@ struct ring_buffer_per_cpu {
 	struct completion		update_done;
 
 	struct rb_irq_work		irq_work;
+
+	/* user space mapping, see ring_buffer_map() */
+	struct mutex			mapping_lock;
+	unsigned long			*subbuf_ids;	/* ID to page address */
+	struct trace_buffer_meta	*meta_page;
+	int				mapped;
 };
 
 struct trace_buffer {
@@ -1307,6 +1317,7 @@ rb_allocate_cpu_buffer(struct trace_buffer *buffer, long nr_pages, int cpu)
 	init_irq_work(&cpu_buffer->irq_work.work, rb_wake_up_waiters);
 	init_waitqueue_head(&cpu_buffer->irq_work.waiters);
 	init_waitqueue_head(&cpu_buffer->irq_work.full_waiters);
+	mutex_init(&cpu_buffer->mapping_lock);
 
 	bpage = kzalloc_node(ALIGN(sizeof(*bpage), cache_line_size()),
 			    GFP_KERNEL, cpu_to_node(cpu));
@@ -4438,6 +4449,8 @@ unsigned long ring_buffer_size(struct trace_buffer *buffer, int cpu)
 }
 EXPORT_SYMBOL_GPL(ring_buffer_size);
 
+static void rb_update_meta_page(struct ring_buffer_per_cpu *cpu_buffer);
+
 static void
 rb_reset_cpu(struct ring_buffer_per_cpu *cpu_buffer)
 {
@@ -4481,6 +4494,12 @@ rb_reset_cpu(struct ring_buffer_per_cpu *cpu_buffer)
 	cpu_buffer->lost_events = 0;
 	cpu_buffer->last_overrun = 0;
 
+	if (cpu_buffer->mapped) {
+		cpu_buffer->meta_page->reader.read = 0;
+		cpu_buffer->meta_page->reader.commit = 0;
+		rb_update_meta_page(cpu_buffer);
+	}
+
 	rb_head_page_activate(cpu_buffer);
 }
 
@@ -4620,6 +4639,11 @@ int ring_buffer_swap_cpu(struct trace_buffer *buffer_a,
 	if (cpu_buffer_a->nr_pages != cpu_buffer_b->nr_pages)
 		goto out;
 
+	/* A mapped buffer must keep its pages where user space sees them */
+	ret = -ERR(EBUSY);
+	if (READ_ONCE(cpu_buffer_a->mapped) || READ_ONCE(cpu_buffer_b->mapped))
+		goto out;
+
 	ret = -ERR(EAGAIN);
 
 	if (atomic_read(&buffer_a->record_disabled))
@@ -4787,7 +4811,7 @@ EXPORT_SYMBOL_GPL(ring_buffer_free_read_page);
  *
  * Returns:
  *  >=0 if data has been transferred, returns the offset of consumed data.
- *  <0 if no data has been transferred.
+ *  <0 if no data has been transferred, -EBUSY if the buffer is mapped.
  */
 int ring_buffer_read_page(struct trace_buffer *buffer,
 			  void **data_page, size_t len, int cpu, int full)
@@ -4824,6 +4848,12 @@ int ring_buffer_read_page(struct trace_buffer *buffer,
 
 	raw_spin_lock_irqsave(&cpu_buffer->reader_lock, flags);
 
+	/* Swapping pages would pull them from under the user mapping */
+	if (cpu_buffer->mapped) {
+		ret = -ERR(EBUSY);
+		goto out_unlock;
+	}
+
 	reader = rb_get_reader_page(cpu_buffer);
 	if (!reader)
 		goto out_unlock;
@@ -4953,6 +4983,307 @@ int ring_buffer_read_page(struct trace_buffer *buffer,
 }
 EXPORT_SYMBOL_GPL(ring_buffer_read_page);
 
+/*
+ * Publish the position of the reader and the counters to user space.
+ * Called with the reader_lock held.
+ */
+static void rb_update_meta_page(struct ring_buffer_per_cpu *cpu_buffer)
+{
+	struct trace_buffer_meta *meta = cpu_buffer->meta_page;
+
+	WRITE_ONCE(meta->reader.id, cpu_buffer->reader_page->id);
+	WRITE_ONCE(meta->entries, local_read(&cpu_buffer->entries));
+	WRITE_ONCE(meta->overrun, local_read(&cpu_buffer->overrun));
+	WRITE_ONCE(meta->read, cpu_buffer->read);
+
+	/* Some archs do not have data cache coherency with user space */
+	flush_dcache_page(virt_to_page(meta));
+}
+
+/*
+ * Give every page of the buffer, including the reader page, the ID under
+ * which user space finds it. Pages move between the ring and the reader
+ * slot, but never leave the buffer while it is mapped, so IDs are stable.
+ * Called with the reader_lock held.
+ */
+static void rb_setup_ids_meta_page(struct ring_buffer_per_cpu *cpu_buffer,
+				   unsigned long *subbuf_ids)
+{
+	struct trace_buffer_meta *meta = cpu_buffer->meta_page;
+	unsigned int nr_subbufs = cpu_buffer->nr_pages + 1;
+	struct buffer_page *first, *bpage;
+	unsigned int id = 0;
+
+	subbuf_ids[id] = (unsigned long)cpu_buffer->reader_page->page;
+	cpu_buffer->reader_page->id = id++;
+
+	first = bpage = list_entry(cpu_buffer->pages, struct buffer_page, list);
+	do {
+		if (RB_WARN_ON(cpu_buffer, id >= nr_subbufs))
+			break;
+
+		subbuf_ids[id] = (unsigned long)bpage->page;
+		bpage->id = id++;
+
+		rb_inc_page(cpu_buffer, &bpage);
+	} while (bpage != first);
+
+	cpu_buffer->subbuf_ids = subbuf_ids;
+
+	meta->meta_page_size = PAGE_SIZE;
+	meta->meta_struct_len = sizeof(*meta);
+	meta->subbuf_size = PAGE_SIZE;
+	meta->nr_subbufs = nr_subbufs;
+	meta->reader.read = cpu_buffer->reader_page->read;
+	meta->reader.commit = cpu_buffer->reader_page->read;
+
+	rb_update_meta_page(cpu_buffer);
+}
+
+static int __rb_map_vma(struct ring_buffer_per_cpu *cpu_buffer,
+			struct vm_area_struct *vma)
+{
+	unsigned long nr_pages = cpu_buffer->nr_pages + 2; /* meta, reader */
+	unsigned long pgoff = vma->vm_pgoff;
+	unsigned long i;
+	int err;
+
+	if (vma->vm_flags & (VM_WRITE | VM_EXEC))
+		return -ERR(EPERM);
+
+	if (pgoff >= nr_pages || vma_pages(vma) > nr_pages - pgoff)
+		return -ERR(EINVAL);
+
+	/* The pages belong to the ring buffer: no write, fork or core dump */
+	vma->vm_flags |= VM_DONTCOPY | VM_DONTEXPAND | VM_DONTDUMP;
+	vma->vm_flags &= ~VM_MAYWRITE;
+
+	for (i = 0; i < vma_pages(vma); i++) {
+		void *addr;
+
+		if (pgoff + i)
+			addr = (void *)cpu_buffer->subbuf_ids[pgoff + i - 1];
+		else
+			addr = cpu_buffer->meta_page;
+
+		err = vm_insert_page(vma, vma->vm_start + i * PAGE_SIZE,
+				     virt_to_page(addr));
+		if (err)
+			return err;
+	}
+
+	return 0;
+}
+
+/**
+ * ring_buffer_map - map a per CPU buffer into user space
+ * @buffer: The ring buffer
+ * @cpu: The CPU buffer to map
+ * @vma: The vma to map the buffer into, read-only
+ *
+ * The mapping starts with a struct trace_buffer_meta page, followed by
+ * every page of the CPU buffer in ID order. Events are handed over to
+ * user space with ring_buffer_map_get_reader(). While the buffer is
+ * mapped, it cannot be resized, swapped or read with
+ * ring_buffer_read_page().
+ *
+ * Returns 0 on success, or a negative errno.
+ */
+int ring_buffer_map(struct trace_buffer *buffer, int cpu,
+		    struct vm_area_struct *vma)
+{
+	struct ring_buffer_per_cpu *cpu_buffer;
+	unsigned long *subbuf_ids;
+	unsigned long flags;
+	void *meta;
+	int err;
+
+	if (!cpumask_test_cpu(cpu, buffer->cpumask))
+		return -ERR(EINVAL);
+
+	cpu_buffer = buffer->buffers[cpu];
+
+	mutex_lock(&cpu_buffer->mapping_lock);
+
+	if (cpu_buffer->mapped) {
+		err = __rb_map_vma(cpu_buffer, vma);
+		if (!err)
+			cpu_buffer->mapped++;
+		goto unlock;
+	}
+
+	/* Taken under buffer->mutex to wait for a resize in progress */
+	mutex_lock(&buffer->mutex);
+	atomic_inc(&cpu_buffer->resize_disabled);
+	mutex_unlock(&buffer->mutex);
+
+	err = -ENOMEM;
+	subbuf_ids = kcalloc(cpu_buffer->nr_pages + 1, sizeof(*subbuf_ids),
+			     GFP_KERNEL);
+	if (!subbuf_ids)
+		goto enable_resize;
+
+	meta = (void *)get_zeroed_page(GFP_KERNEL);
+	if (!meta)
+		goto free_ids;
+
+	raw_spin_lock_irqsave(&cpu_buffer->reader_lock, flags);
+	cpu_buffer->meta_page = meta;
+	rb_setup_ids_meta_page(cpu_buffer, subbuf_ids);
+	cpu_buffer->mapped = 1;
+	raw_spin_unlock_irqrestore(&cpu_buffer->reader_lock, flags);
+
+	err = __rb_map_vma(cpu_buffer, vma);
+	if (!err)
+		goto unlock;
+
+	raw_spin_lock_irqsave(&cpu_buffer->reader_lock, flags);
+	cpu_buffer->mapped = 0;
+	cpu_buffer->meta_page = NULL;
+	cpu_buffer->subbuf_ids = NULL;
+	raw_spin_unlock_irqrestore(&cpu_buffer->reader_lock, flags);
+
+	free_page((unsigned long)meta);
+ free_ids:
+	kfree(subbuf_ids);
+ enable_resize:
+	atomic_dec(&cpu_buffer->resize_disabled);
+ unlock:
+	mutex_unlock(&cpu_buffer->mapping_lock);
+
+	return err;
+}
+EXPORT_SYMBOL_GPL(ring_buffer_map);
+
+/**
+ * ring_buffer_map_dup - count a copy of a user space mapping
+ * @buffer: The ring buffer
+ * @cpu: The CPU buffer that was mapped with ring_buffer_map()
+ *
+ * A vma moved by mremap() or copied by fork() is closed on its own, so
+ * it must hold a reference of its own.
+ */
+void ring_buffer_map_dup(struct trace_buffer *buffer, int cpu)
+{
+	struct ring_buffer_per_cpu *cpu_buffer;
+
+	if (WARN_ON(!cpumask_test_cpu(cpu, buffer->cpumask)))
+		return;
+
+	cpu_buffer = buffer->buffers[cpu];
+
+	mutex_lock(&cpu_buffer->mapping_lock);
+	if (!WARN_ON(!cpu_buffer->mapped))
+		cpu_buffer->mapped++;
+	mutex_unlock(&cpu_buffer->mapping_lock);
+}
+EXPORT_SYMBOL_GPL(ring_buffer_map_dup);
+
+/**
+ * ring_buffer_unmap - drop a user space mapping of a per CPU buffer
+ * @buffer: The ring buffer
+ * @cpu: The CPU buffer that was mapped with ring_buffer_map()
+ */
+int ring_buffer_unmap(struct trace_buffer *buffer, int cpu)
+{
+	struct ring_buffer_per_cpu *cpu_buffer;
+	unsigned long *subbuf_ids;
+	unsigned long flags;
+	void *meta;
+	int err = 0;
+
+	if (!cpumask_test_cpu(cpu, buffer->cpumask))
+		return -ERR(EINVAL);
+
+	cpu_buffer = buffer->buffers[cpu];
+
+	mutex_lock(&cpu_buffer->mapping_lock);
+
+	if (!cpu_buffer->mapped) {
+		err = -ERR(ENODEV);
+		goto unlock;
+	}
+
+	if (--cpu_buffer->mapped)
+		goto unlock;
+
+	raw_spin_lock_irqsave(&cpu_buffer->reader_lock, flags);
+	meta = cpu_buffer->meta_page;
+	subbuf_ids = cpu_buffer->subbuf_ids;
+	cpu_buffer->meta_page = NULL;
+	cpu_buffer->subbuf_ids = NULL;
+	raw_spin_unlock_irqrestore(&cpu_buffer->reader_lock, flags);
+
+	free_page((unsigned long)meta);
+	kfree(subbuf_ids);
+
+	atomic_dec(&cpu_buffer->resize_disabled);
+ unlock:
+	mutex_unlock(&cpu_buffer->mapping_lock);
+
+	return err;
+}
+EXPORT_SYMBOL_GPL(ring_buffer_unmap);
+
+/**
+ * ring_buffer_map_get_reader - hand the next events to user space
+ * @buffer: The ring buffer
+ * @cpu: The mapped CPU buffer
+ *
+ * Swap in a new reader page if the current one has been consumed, then
+ * consume every event committed on it so far and publish their range,
+ * the reader page ID and the events lost since the last call in the
+ * meta page. The range is empty if there was nothing to read.
+ *
+ * Returns 0 on success, or -ENODEV if the buffer is not mapped.
+ */
+int ring_buffer_map_get_reader(struct trace_buffer *buffer, int cpu)
+{
+	struct ring_buffer_per_cpu *cpu_buffer;
+	struct trace_buffer_meta *meta;
+	struct buffer_page *reader;
+	unsigned long flags;
+	unsigned int commit;
+
+	if (!cpumask_test_cpu(cpu, buffer->cpumask))
+		return -ERR(EINVAL);
+
+	cpu_buffer = buffer->buffers[cpu];
+
+	raw_spin_lock_irqsave(&cpu_buffer->reader_lock, flags);
+
+	if (!cpu_buffer->mapped) {
+		raw_spin_unlock_irqrestore(&cpu_buffer->reader_lock, flags);
+		return -ERR(ENODEV);
+	}
+
+	meta = cpu_buffer->meta_page;
+
+	reader = rb_get_reader_page(cpu_buffer);
+	if (reader) {
+		/* The writer may still be adding events to this page */
+		commit = rb_page_size(reader);
+		WRITE_ONCE(meta->reader.read, reader->read);
+		while (reader->read < commit)
+			rb_advance_reader(cpu_buffer);
+		WRITE_ONCE(meta->reader.commit, commit);
+		flush_dcache_page(virt_to_page(reader->page));
+	} else {
+		WRITE_ONCE(meta->reader.read, cpu_buffer->reader_page->read);
+		WRITE_ONCE(meta->reader.commit, cpu_buffer->reader_page->read);
+	}
+
+	WRITE_ONCE(meta->reader.lost_events, cpu_buffer->lost_events);
+	cpu_buffer->lost_events = 0;
+
+	rb_update_meta_page(cpu_buffer);
+
+	raw_spin_unlock_irqrestore(&cpu_buffer->reader_lock, flags);
+
+	return 0;
+}
+EXPORT_SYMBOL_GPL(ring_buffer_map_get_reader);
+
 /*
  * We only allocate new buffers, never free them if the CPU goes down.
  * If we were to free the buffer, then the user would lose any trace that was in
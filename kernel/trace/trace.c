@@ -47,6 +47,7 @@
 #include <linux/sched/rt.h>
 #include <linux/fsnotify.h>
 #include <linux/irq_work.h>
+#include <linux/trace_mmap.h>
 #include <linux/workqueue.h>
 
 #include "trace.h"
@@ -1069,7 +1070,17 @@ int tracing_alloc_snapshot_instance(struct trace_array *tr)
 		if (ret < 0)
 			return ret;
 
+		/* A mapped array_buffer can't be swapped with the snapshot */
+		spin_lock(&tr->snapshot_map_lock);
+		if (tr->mapped) {
+			spin_unlock(&tr->snapshot_map_lock);
+			ring_buffer_resize(tr->max_buffer.buffer, 1,
+					   RING_BUFFER_ALL_CPUS);
+			set_buffer_entries(&tr->max_buffer, 1);
+			return -ERR(EBUSY);
+		}
 		tr->allocated_snapshot = true;
+		spin_unlock(&tr->snapshot_map_lock);
 	}
 
 	return 0;
@@ -7486,6 +7497,10 @@ tracing_buffers_read(struct file *filp, char __user *ubuf,
 				    iter->cpu_file, 0);
 	trace_access_unlock(iter->cpu_file);
 
+	/* The buffer is consumed through its user space mapping */
+	if (ret == -EBUSY)
+		return ret;
+
 	if (ret < 0) {
 		if (trace_empty(iter)) {
 			if ((filp->f_flags & O_NONBLOCK))
@@ -7662,6 +7677,8 @@ tracing_buffers_splice_read(struct file *file, loff_t *ppos,
 			ring_buffer_free_read_page(ref->buffer, ref->cpu,
 						   ref->page);
 			kfree(ref);
+			if (r == -EBUSY)
+				ret = r;
 			break;
 		}
 
@@ -7703,12 +7720,118 @@ tracing_buffers_splice_read(struct file *file, loff_t *ppos,
 	return ret;
 }
 
+static long tracing_buffers_ioctl(struct file *file, unsigned int cmd,
+				  unsigned long arg)
+{
+	struct ftrace_buffer_info *info = file->private_data;
+	struct trace_iterator *iter = &info->iter;
+	int ret;
+
+	if (cmd != TRACE_MMAP_IOCTL_GET_READER)
+		return -ERR(ENOTTY);
+
+	if (!(file->f_flags & O_NONBLOCK)) {
+		ret = wait_on_pipe(iter, iter->tr->buffer_percent);
+		if (ret)
+			return ret;
+	}
+
+	return ring_buffer_map_get_reader(iter->array_buffer->buffer,
+					  iter->cpu_file);
+}
+
+#ifdef CONFIG_TRACER_MAX_TRACE
+static int get_snapshot_map(struct trace_array *tr)
+{
+	int ret = 0;
+
+	spin_lock(&tr->snapshot_map_lock);
+	if (tr->allocated_snapshot)
+		ret = -ERR(EBUSY);
+	else
+		tr->mapped++;
+	spin_unlock(&tr->snapshot_map_lock);
+
+	return ret;
+}
+
+static void put_snapshot_map(struct trace_array *tr)
+{
+	spin_lock(&tr->snapshot_map_lock);
+	if (!WARN_ON(!tr->mapped))
+		tr->mapped--;
+	spin_unlock(&tr->snapshot_map_lock);
+}
+#else
+static inline int get_snapshot_map(struct trace_array *tr) { return 0; }
+static inline void put_snapshot_map(struct trace_array *tr) { }
+#endif
+
+static void tracing_buffers_mmap_open(struct vm_area_struct *vma)
+{
+	struct ftrace_buffer_info *info = vma->vm_file->private_data;
+	struct trace_iterator *iter = &info->iter;
+
+	/* The snapshot cannot have been allocated while the buffer is mapped */
+	WARN_ON(get_snapshot_map(iter->tr));
+	ring_buffer_map_dup(iter->array_buffer->buffer, iter->cpu_file);
+}
+
+static void tracing_buffers_mmap_close(struct vm_area_struct *vma)
+{
+	struct ftrace_buffer_info *info = vma->vm_file->private_data;
+	struct trace_iterator *iter = &info->iter;
+
+	WARN_ON(ring_buffer_unmap(iter->array_buffer->buffer, iter->cpu_file));
+	put_snapshot_map(iter->tr);
+}
+
+/* Mappings are counted per vma, so they must not be split. */
+static int tracing_buffers_mmap_split(struct vm_area_struct *vma,
+				      unsigned long addr)
+{
+	return -ERR(EINVAL);
+}
+
+static const struct vm_operations_struct tracing_buffers_vmops = {
+	.open		= tracing_buffers_mmap_open,
+	.close		= tracing_buffers_mmap_close,
+	.split		= tracing_buffers_mmap_split,
+};
+
+static int tracing_buffers_mmap(struct file *filp, struct vm_area_struct *vma)
+{
+	struct ftrace_buffer_info *info = filp->private_data;
+	struct trace_iterator *iter = &info->iter;
+	int ret;
+
+	if (iter->snapshot)
+		return -ERR(EBUSY);
+
+	ret = get_snapshot_map(iter->tr);
+	if (ret)
+		return ret;
+
+	ret = ring_buffer_map(iter->array_buffer->buffer, iter->cpu_file, vma);
+	if (ret) {
+		put_snapshot_map(iter->tr);
+		return ret;
+	}
+
+	vma->vm_ops = &tracing_buffers_vmops;
+
+	return 0;
+}
+
 static const struct file_operations tracing_buffers_fops = {
 	.open		= tracing_buffers_open,
 	.read		= tracing_buffers_read,
 	.poll		= tracing_buffers_poll,
 	.release	= tracing_buffers_release,
 	.splice_read	= tracing_buffers_splice_read,
+	.unlocked_ioctl	= tracing_buffers_ioctl,
+	.compat_ioctl	= tracing_buffers_ioctl,
+	.mmap		= tracing_buffers_mmap,
 	.llseek		= no_llseek,
 };
 
@@ -8619,6 +8742,9 @@ static struct trace_array *trace_array_create(const char *name)
 	cpumask_copy(tr->tracing_cpumask, cpu_all_mask);
 
 	raw_spin_lock_init(&tr->start_lock);
+#ifdef CONFIG_TRACER_MAX_TRACE
+	spin_lock_init(&tr->snapshot_map_lock);
+#endif
 
 	tr->max_lock = (arch_spinlock_t)__ARCH_SPIN_LOCK_UNLOCKED;
 
@@ -9419,6 +9545,9 @@ __init static int tracer_alloc_buffers(void)
 	cpumask_copy(global_trace.tracing_cpumask, cpu_all_mask);
 
 	raw_spin_lock_init(&global_trace.start_lock);
+#ifdef CONFIG_TRACER_MAX_TRACE
+	spin_lock_init(&global_trace.snapshot_map_lock);
+#endif
 
 	/*
 	 * The prepare callbacks allocates some memory for the ring buffer. We
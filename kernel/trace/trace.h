@@ -302,6 +302,14 @@ struct trace_array {
 	 */
 	struct array_buffer	max_buffer;
 	bool			allocated_snapshot;
+	/*
+	 * Number of user space mappings of the array_buffer, which must not
+	 * be swapped with the max_buffer while mapped. Protected by
+	 * snapshot_map_lock, which unlike trace_types_lock can be taken
+	 * under mmap_lock.
+	 */
+	unsigned int		mapped;
+	spinlock_t		snapshot_map_lock;
 #endif
 #if defined(CONFIG_TRACER_MAX_TRACE) || defined(CONFIG_HWLAT_TRACER)
 	unsigned long		max_latency;
@@ -1410,6 +1418,7 @@ struct prog_entry;
 
 struct event_filter {
 	struct prog_entry __rcu	*prog;
+	struct bpf_prog		*bpf_prog;	/* prog compiled by the BPF JIT */
 	char			*filter_string;
 };
 
@@ -0,0 +1,205 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * Per-CPU hit counts of ERR() sites, reported in tracefs as error_sites.
+ *
+ * Each CPU owns a small open-addressed table keyed by site id, updated
+ * with plain adds from task context with preemption disabled. Reading
+ * merges the tables of all CPUs and sorts the sites by hit count.
+ * Opening the file with O_TRUNC bumps a generation number, and each CPU
+ * clears its own table on its next hit, so no CPU ever writes another
+ * CPU's table.
+ */
+#include <linux/trace_error.h>
+#include <linux/security.h>
+#include <linux/seq_file.h>
+#include <linux/percpu.h>
+#include <linux/kernel.h>
+#include <linux/string.h>
+#include <linux/mutex.h>
+#include <linux/hash.h>
+#include <linux/sort.h>
+#include <linux/slab.h>
+#include <linux/mm.h>
+
+#include "trace.h"
+
+#define ERR_STATS_BITS		10
+#define ERR_STATS_SIZE		(1 << ERR_STATS_BITS)
+#define ERR_STATS_MAX_PROBE	16
+
+struct err_stat {
+	unsigned int	site;
+	unsigned long	count;
+};
+
+struct err_stats {
+	unsigned int	gen;
+	unsigned long	dropped;
+	struct err_stat	entries[ERR_STATS_SIZE];
+};
+
+static struct err_stats __percpu *err_stats;
+static unsigned int err_stats_gen;
+static DEFINE_MUTEX(err_stats_mutex);
+
+void trace_error_count(unsigned int site)
+{
+	struct err_stats *stats;
+	unsigned int i, n;
+
+	if (!err_stats || !site)
+		return;
+
+	stats = get_cpu_ptr(err_stats);
+
+	if (unlikely(stats->gen != READ_ONCE(err_stats_gen))) {
+		memset(stats->entries, 0, sizeof(stats->entries));
+		stats->dropped = 0;
+		stats->gen = READ_ONCE(err_stats_gen);
+	}
+
+	i = hash_32(site, ERR_STATS_BITS);
+	for (n = 0; n < ERR_STATS_MAX_PROBE; n++) {
+		struct err_stat *stat = &stats->entries[i];
+
+		if (stat->site == site) {
+			stat->count++;
+			goto out;
+		}
+		if (!stat->site) {
+			stat->count = 1;
+			WRITE_ONCE(stat->site, site);
+			goto out;
+		}
+		i = (i + 1) & (ERR_STATS_SIZE - 1);
+	}
+	stats->dropped++;
+out:
+	put_cpu_ptr(err_stats);
+}
+
+static int err_stat_cmp_site(const void *a, const void *b)
+{
+	const struct err_stat *x = a, *y = b;
+
+	if (x->site != y->site)
+		return x->site < y->site ? -1 : 1;
+	return 0;
+}
+
+static int err_stat_cmp_count(const void *a, const void *b)
+{
+	const struct err_stat *x = a, *y = b;
+
+	if (x->count != y->count)
+		return x->count > y->count ? -1 : 1;
+	return err_stat_cmp_site(a, b);
+}
+
+static int error_sites_show(struct seq_file *m, void *v)
+{
+	unsigned int gen = READ_ONCE(err_stats_gen);
+	unsigned long dropped = 0;
+	struct err_stat *all;
+	size_t nr = 0, i, j;
+	int cpu;
+
+	all = kvmalloc_array(num_possible_cpus() * ERR_STATS_SIZE,
+			     sizeof(*all), GFP_KERNEL);
+	if (!all)
+		return -ENOMEM;
+
+	for_each_possible_cpu(cpu) {
+		struct err_stats *stats = per_cpu_ptr(err_stats, cpu);
+
+		/* A stale generation is cleared on that CPU's next hit. */
+		if (READ_ONCE(stats->gen) != gen)
+			continue;
+
+		for (i = 0; i < ERR_STATS_SIZE; i++) {
+			unsigned int site = READ_ONCE(stats->entries[i].site);
+
+			if (!site)
+				continue;
+			all[nr].site = site;
+			all[nr].count = READ_ONCE(stats->entries[i].count);
+			nr++;
+		}
+		dropped += READ_ONCE(stats->dropped);
+	}
+
+	/* Merge the per-CPU counts of each site, then rank by count. */
+	sort(all, nr, sizeof(*all), err_stat_cmp_site, NULL);
+	for (i = 0, j = 0; i < nr; i++) {
+		if (j && all[j - 1].site == all[i].site)
+			all[j - 1].count += all[i].count;
+		else
+			all[j++] = all[i];
+	}
+	nr = j;
+	sort(all, nr, sizeof(*all), err_stat_cmp_count, NULL);
+
+	seq_puts(m, "# count file:line errno\n");
+	for (i = 0; i < nr; i++) {
+		seq_printf(m, "%lu ", all[i].count);
+		if (!seq_print_err_site(m, all[i].site))
+			seq_printf(m, "site:%u", all[i].site);
+		seq_putc(m, '\n');
+	}
+	if (dropped)
+		seq_printf(m, "# dropped %lu\n", dropped);
+
+	kvfree(all);
+	return 0;
+}
+
+static int error_sites_open(struct inode *inode, struct file *file)
+{
+	int ret;
+
+	ret = security_locked_down(LOCKDOWN_TRACEFS);
+	if (ret)
+		return ret;
+
+	if ((file->f_mode & FMODE_WRITE) && (file->f_flags & O_TRUNC)) {
+		mutex_lock(&err_stats_mutex);
+		WRITE_ONCE(err_stats_gen, err_stats_gen + 1);
+		mutex_unlock(&err_stats_mutex);
+	}
+
+	return single_open(file, error_sites_show, NULL);
+}
+
+static ssize_t error_sites_write(struct file *file, const char __user *ubuf,
+				 size_t cnt, loff_t *ppos)
+{
+	return cnt;
+}
+
+static const struct file_operations error_sites_fops = {
+	.open		= error_sites_open,
+	.read		= seq_read,
+	.write		= error_sites_write,
+	.llseek		= seq_lseek,
+	.release	= single_release,
+};
+
+static __init int init_trace_error_stats(void)
+{
+	struct dentry *d_tracer;
+
+	err_stats = alloc_percpu(struct err_stats);
+	if (!err_stats)
+		return -ENOMEM;
+
+	d_tracer = tracing_init_dentry();
+	if (IS_ERR(d_tracer))
+		return 0;
+
+	trace_create_file("error_sites", 0644, d_tracer,
+			  NULL, &error_sites_fops);
+
+	return 0;
+}
+
+fs_initcall(init_trace_error_stats);
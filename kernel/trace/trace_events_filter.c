@@ -9,6 +9,7 @@
 #include <linux/ctype.h>
 #include <linux/mutex.h>
 #include <linux/perf_event.h>
+#include <linux/filter.h>
 #include <linux/slab.h>
 
 #include "trace.h"
@@ -907,6 +908,11 @@ int filter_match_preds(struct event_filter *filter, void *rec)
 	if (!prog)
 		return 1;
 
+#ifdef CONFIG_BPF_JIT
+	if (filter->bpf_prog)
+		return BPF_PROG_RUN(filter->bpf_prog, rec);
+#endif
+
 	for (i = 0; prog[i].pred; i++) {
 		struct filter_pred *pred = prog[i].pred;
 		int match = pred->fn(pred, rec);
@@ -1003,11 +1009,22 @@ void print_subsystem_event_filter(struct event_subsystem *system,
 	mutex_unlock(&event_mutex);
 }
 
+static void filter_free_bpf(struct event_filter *filter)
+{
+#ifdef CONFIG_BPF_JIT
+	if (filter->bpf_prog)
+		bpf_prog_free(filter->bpf_prog);
+#endif
+	filter->bpf_prog = NULL;
+}
+
 static void free_prog(struct event_filter *filter)
 {
 	struct prog_entry *prog;
 	int i;
 
+	filter_free_bpf(filter);
+
 	prog = rcu_access_pointer(filter->prog);
 	if (!prog)
 		return;
@@ -1502,6 +1519,177 @@ static int calc_stack(const char *str, int *parens, int *preds, int *err)
 	return 0;
 }
 
+#ifdef CONFIG_BPF_JIT
+/*
+ * Filters made only of numeric field comparisons are also compiled into
+ * a BPF program and run by the BPF JIT, which replaces the indirect call
+ * per predicate of filter_match_preds() with straight-line code.  Other
+ * filters, and all filters when the JIT is disabled, keep being
+ * interpreted from the prog_entry array.
+ */
+
+static const u8 filter_bpf_size[] = {
+	[1] = BPF_B, [2] = BPF_H, [4] = BPF_W, [8] = BPF_DW,
+};
+
+static bool filter_pred_compilable(struct filter_pred *pred)
+{
+	struct ftrace_event_field *field = pred->field;
+
+	if (!field || is_string_field(field) || is_function_field(field) ||
+	    field->filter_type == FILTER_CPU)
+		return false;
+
+	if (pred->offset < 0 || pred->offset > S16_MAX)
+		return false;
+
+	return pred->fn && pred->fn == select_comparison_fn(pred->op,
+							    field->size,
+							    field->is_signed);
+}
+
+/*
+ * Emit the code of a predicate at @pc, branching to @target when its
+ * result equals @when_to_branch like filter_match_preds() does.  The
+ * event is in R1.  With a NULL @insn, only count the instructions.
+ */
+static int filter_emit_pred(struct bpf_insn *insn, int pc, int target,
+			    struct filter_pred *pred, int when_to_branch)
+{
+	struct ftrace_event_field *field = pred->field;
+	int shift = 64 - field->size * 8;
+	bool is_signed = field->is_signed;
+	struct bpf_insn jmp;
+	u64 val = pred->val;
+	int n = 0;
+	u8 op;
+
+#define EMIT(x)	do { if (insn) insn[n] = (x); n++; } while (0)
+
+	switch (pred->op) {
+	case OP_EQ:
+	case OP_NE:
+		op = pred->not ? BPF_JNE : BPF_JEQ;
+		is_signed = false;
+		break;
+	case OP_BAND:
+		op = BPF_JSET;
+		is_signed = false;
+		break;
+	case OP_LT:
+		op = is_signed ? BPF_JSLT : BPF_JLT;
+		break;
+	case OP_LE:
+		op = is_signed ? BPF_JSLE : BPF_JLE;
+		break;
+	case OP_GT:
+		op = is_signed ? BPF_JSGT : BPF_JGT;
+		break;
+	case OP_GE:
+		op = is_signed ? BPF_JSGE : BPF_JGE;
+		break;
+	default:
+		return -ERR(EINVAL);
+	}
+
+	/* Truncate the value to the field, like the interpreter's casts */
+	if (shift) {
+		val <<= shift;
+		val = is_signed ? (u64)((s64)val >> shift) : val >> shift;
+	}
+
+	EMIT(BPF_LDX_MEM(filter_bpf_size[field->size], BPF_REG_2, BPF_REG_1,
+			 pred->offset));
+	if (is_signed && shift) {
+		EMIT(BPF_ALU64_IMM(BPF_LSH, BPF_REG_2, shift));
+		EMIT(BPF_ALU64_IMM(BPF_ARSH, BPF_REG_2, shift));
+	}
+
+	if ((s64)val == (s32)val) {
+		jmp = BPF_JMP_IMM(op, BPF_REG_2, (s32)val, 0);
+	} else {
+		struct bpf_insn ld[] = { BPF_LD_IMM64(BPF_REG_3, val) };
+
+		EMIT(ld[0]);
+		EMIT(ld[1]);
+		jmp = BPF_JMP_REG(op, BPF_REG_2, BPF_REG_3, 0);
+	}
+
+	if (when_to_branch) {
+		jmp.off = target - (pc + n + 1);
+		EMIT(jmp);
+	} else {
+		jmp.off = 1;
+		EMIT(jmp);
+		EMIT(BPF_JMP_A(target - (pc + n + 1)));
+	}
+#undef EMIT
+
+	return n;
+}
+
+static void filter_compile(struct event_filter *filter)
+{
+	struct prog_entry *prog = rcu_access_pointer(filter->prog);
+	struct bpf_prog *fp;
+	int i, n, len, err;
+	int *start;
+
+	for (n = 0; prog[n].pred; n++) {
+		if (!filter_pred_compilable(prog[n].pred))
+			return;
+	}
+
+	/* The start of each entry, including the TRUE and FALSE returns */
+	start = kmalloc_array(n + 2, sizeof(*start), GFP_KERNEL);
+	if (!start)
+		return;
+
+	for (i = 0, len = 0; i < n; i++) {
+		start[i] = len;
+		err = filter_emit_pred(NULL, 0, 0, prog[i].pred,
+				       prog[i].when_to_branch);
+		if (err < 0)
+			goto out;
+		len += err;
+	}
+	start[n] = len;
+	start[n + 1] = len + 2;
+	len += 4;
+
+	if (len > BPF_MAXINSNS)
+		goto out;
+
+	fp = bpf_prog_alloc(bpf_prog_size(len), 0);
+	if (!fp)
+		goto out;
+
+	for (i = 0; i < n; i++)
+		filter_emit_pred(&fp->insnsi[start[i]], start[i],
+				 start[prog[i].target + 1], prog[i].pred,
+				 prog[i].when_to_branch);
+
+	for (i = n; i < n + 2; i++) {
+		fp->insnsi[start[i]] = BPF_MOV64_IMM(BPF_REG_0, prog[i].target);
+		fp->insnsi[start[i] + 1] = BPF_EXIT_INSN();
+	}
+	fp->len = len;
+
+	/* The interpreter is no faster than walking the prog_entry array */
+	fp = bpf_prog_select_runtime(fp, &err);
+	if (err || !fp->jited) {
+		bpf_prog_free(fp);
+		goto out;
+	}
+
+	filter->bpf_prog = fp;
+ out:
+	kfree(start);
+}
+#else
+static inline void filter_compile(struct event_filter *filter) { }
+#endif /* CONFIG_BPF_JIT */
+
 static int process_preds(struct trace_event_call *call,
 			 const char *filter_string,
 			 struct event_filter *filter,
@@ -1537,6 +1725,7 @@ static int process_preds(struct trace_event_call *call,
 		return PTR_ERR(prog);
 
 	rcu_assign_pointer(filter->prog, prog);
+	filter_compile(filter);
 	return 0;
 }
 
@@ -2124,6 +2313,11 @@ static struct test_filter_data_t {
 	DATA_REC(NO,  0, 1, 1, 1, 1, 1, 1, 1, "bcdefgh"),
 	DATA_REC(NO,  1, 1, 1, 1, 1, 1, 1, 0, ""),
 #undef FILTER
+#define FILTER "(a < 0 && b >= -2) || (c > 1 && d != 3)"
+	DATA_REC(YES, -1, -2, 0, 0, 0, 0, 0, 0, "cd"),
+	DATA_REC(NO,  -1, -3, 1, 3, 0, 0, 0, 0, "d"),
+	DATA_REC(YES,  1,  0, 2, 4, 0, 0, 0, 0, "b"),
+#undef FILTER
 #define FILTER "a == 1 || b == 1 || c == 1 || d == 1 || " \
 	       "e == 1 || f == 1 || g == 1 || h == 1"
 	DATA_REC(NO,  0, 0, 0, 0, 0, 0, 0, 0, ""),
@@ -2210,6 +2404,56 @@ static void update_pred_fn(struct event_filter *filter, char *fields)
 	}
 }
 
+#define FILTER_BENCH_LOOPS	100000
+
+/*
+ * Report the cost of the last, most nested, test filter, both interpreted
+ * and compiled when the BPF JIT is enabled.
+ */
+static __init void ftrace_test_event_filter_bench(void)
+{
+	struct test_filter_data_t *d = &test_filter_data[DATA_CNT - 1];
+	struct event_filter *filter = NULL;
+	u64 interp, jit = 0, start;
+	struct bpf_prog *bpf_prog;
+	int i;
+
+	if (create_filter(NULL, &event_ftrace_test_filter, d->filter, false,
+			  &filter)) {
+		__free_filter(filter);
+		return;
+	}
+
+	mutex_lock(&event_mutex);
+	preempt_disable();
+
+	bpf_prog = filter->bpf_prog;
+	if (bpf_prog) {
+		start = local_clock();
+		for (i = 0; i < FILTER_BENCH_LOOPS; i++)
+			filter_match_preds(filter, &d->rec);
+		jit = local_clock() - start;
+	}
+
+	filter->bpf_prog = NULL;
+	start = local_clock();
+	for (i = 0; i < FILTER_BENCH_LOOPS; i++)
+		filter_match_preds(filter, &d->rec);
+	interp = local_clock() - start;
+	filter->bpf_prog = bpf_prog;
+
+	preempt_enable();
+	mutex_unlock(&event_mutex);
+
+	__free_filter(filter);
+
+	printk(KERN_INFO "ftrace filter: %d events in %llu ns interpreted",
+	       FILTER_BENCH_LOOPS, interp);
+	if (bpf_prog)
+		printk(KERN_CONT ", %llu ns compiled", jit);
+	printk(KERN_CONT "\n");
+}
+
 static __init int ftrace_test_event_filter(void)
 {
 	int i;
@@ -2231,6 +2475,23 @@ static __init int ftrace_test_event_filter(void)
 			break;
 		}
 
+		/* Check the compiled filter, then test the interpreter alone */
+		if (filter->bpf_prog) {
+			preempt_disable();
+			err = filter_match_preds(filter, &d->rec);
+			preempt_enable();
+
+			filter_free_bpf(filter);
+
+			if (err != d->match) {
+				printk(KERN_INFO
+				       "Failed to match compiled filter '%s', expected %d\n",
+				       d->filter, d->match);
+				__free_filter(filter);
+				break;
+			}
+		}
+
 		/* Needed to dereference filter->prog */
 		mutex_lock(&event_mutex);
 		/*
@@ -2264,8 +2525,10 @@ static __init int ftrace_test_event_filter(void)
 		}
 	}
 
-	if (i == DATA_CNT)
+	if (i == DATA_CNT) {
 		printk(KERN_CONT "OK\n");
+		ftrace_test_event_filter_bench();
+	}
 
 	return 0;
 }
@@ -38,6 +38,9 @@ static int trace_kprobe_create(int argc, const char **argv);
 static int trace_kprobe_show(struct seq_file *m, struct dyn_event *ev);
 static int trace_kprobe_release(struct dyn_event *ev);
 static bool trace_kprobe_is_busy(struct dyn_event *ev);
+#ifdef CONFIG_BPF_JIT
+u64 kprobe_fetch_read(u64 dest, u64 size, u64 src, u64 r4, u64 r5);
+#endif
 static bool trace_kprobe_match(const char *system, const char *event,
 			int argc, const char **argv, struct dyn_event *ev);
 
@@ -866,6 +869,8 @@ static int trace_kprobe_create(int argc, const char *argv[])
 	if (ret < 0)
 		goto error;
 
+	trace_probe_compile(&tk->tp, kprobe_fetch_read);
+
 	ret = register_trace_kprobe(tk);
 	if (ret) {
 		trace_probe_log_set_index(1);
@@ -1303,6 +1308,15 @@ probe_mem_read(void *dest, void *src, size_t size)
 	return copy_from_kernel_nofault(dest, src, size);
 }
 
+#ifdef CONFIG_BPF_JIT
+/* Memory reads of the compiled fetch programs, see trace_probe_compile() */
+BPF_CALL_3(kprobe_fetch_read, void *, dest, u32, size, void *, src)
+{
+	return probe_mem_read(dest, src, size);
+}
+NOKPROBE_SYMBOL(kprobe_fetch_read);
+#endif
+
 /* Note that we don't verify it, since the code does not come from user space */
 static int
 process_fetch_insn(struct fetch_insn *code, struct pt_regs *regs, void *dest,
@@ -2093,4 +2107,147 @@ static __init int kprobe_trace_self_tests_init(void)
 
 late_initcall(kprobe_trace_self_tests_init);
 
+#ifdef CONFIG_BPF_JIT
+/*
+ * Words the args of the fetch program test read: w[1] and w[4] chain
+ * two dereferences back to w[0], and w[5] is a NULL pointer so that the
+ * dereferences through it fault.
+ */
+static unsigned long fetch_test_words[6] __initdata;
+
+/* Each %s is the address of one of fetch_test_words[] */
+static const char * const fetch_test_args[] __initconst = {
+	"%s",				/* register, see below */
+	"%s:u8",
+	"@%s",				/* memory store */
+	"@%s:u16",
+	"+0(+8(@%s))",			/* chain of dereferences */
+	"@%s:b5@3/32",			/* bitfields */
+	"+3(@%s):b12@4/16",
+	"@%s:s8",
+	"+0(@%s)",			/* faulting store */
+	"+0(+0(@%s))",			/* faulting dereference */
+	"+0(+0(+8(@%s)))",		/* fault in the middle of a chain */
+};
+
+static const int fetch_test_word[] __initconst = {
+	-1, -1, 0, 0, 1, 2, 1, 2, 5, 5, 1,
+};
+
+#define FETCH_TEST_LOOPS	100000
+
+static __init u64 kprobe_fetch_bpf_time(struct trace_kprobe *tk, void *data,
+					struct pt_regs *regs)
+{
+	u64 start = ktime_get_ns();
+	int i;
+
+	for (i = 0; i < FETCH_TEST_LOOPS; i++)
+		store_trace_args(data, &tk->tp, regs, 0, 0);
+
+	return (ktime_get_ns() - start) / FETCH_TEST_LOOPS;
+}
+
+/*
+ * Store the args of a kprobe once with process_fetch_insn() and once with
+ * the program trace_probe_compile() made of them, from the same registers
+ * and memory, and check that both entries are the same byte for byte.
+ * Unwritten bytes, where a dereference faults, must match too.
+ */
+static __init int kprobe_fetch_bpf_self_tests_init(void)
+{
+	static struct pt_regs regs __initdata;
+	unsigned long *w = fetch_test_words;
+	struct trace_kprobe *tk;
+	struct bpf_prog *prog;
+	void *interp, *jited;
+	char reg[16], arg[64];
+	u64 interp_ns, jited_ns;
+	int i, ret = -ENOMEM;
+
+	BUILD_BUG_ON(ARRAY_SIZE(fetch_test_args) != ARRAY_SIZE(fetch_test_word));
+
+	w[0] = 0x0123456789abcdefUL;
+	w[1] = (unsigned long)&w[3];
+	w[2] = 0xfedcba9876543210UL;
+	w[3] = 0x1122334455667788UL;
+	w[4] = (unsigned long)&w[0];
+	w[5] = 0;
+	for (i = 0; i < sizeof(regs) / sizeof(long); i++)
+		((unsigned long *)&regs)[i] = 0x8040201008040201UL * (i + 1);
+	snprintf(reg, sizeof(reg), "%%%s", regs_query_register_name(0));
+
+	tk = alloc_trace_kprobe(KPROBE_EVENT_SYSTEM, "fetchtest", NULL,
+				"kprobe_trace_selftest_target", 0, 0,
+				ARRAY_SIZE(fetch_test_args), false);
+	if (IS_ERR(tk))
+		return PTR_ERR(tk);
+
+	for (i = 0; i < ARRAY_SIZE(fetch_test_args); i++) {
+		char addr[24];
+
+		snprintf(addr, sizeof(addr), "0x%lx",
+			 (unsigned long)&w[max(fetch_test_word[i], 0)]);
+		snprintf(arg, sizeof(arg), fetch_test_args[i],
+			 fetch_test_word[i] < 0 ? reg : addr);
+		ret = traceprobe_parse_probe_arg(&tk->tp, i, arg,
+						 TPARG_FL_KERNEL);
+		if (ret)
+			goto free;
+	}
+
+	ret = traceprobe_set_print_fmt(&tk->tp, false);
+	if (ret < 0)
+		goto free;
+
+	trace_probe_compile(&tk->tp, kprobe_fetch_read);
+	prog = tk->tp.bpf_prog;
+	if (!prog) {
+		pr_info("Testing kprobe fetch programs: skipped, no JIT\n");
+		ret = 0;
+		goto free;
+	}
+
+	ret = -ENOMEM;
+	interp = kmalloc(tk->tp.size, GFP_KERNEL);
+	jited = kmalloc(tk->tp.size, GFP_KERNEL);
+	if (!interp || !jited)
+		goto free_data;
+
+	memset(interp, 0x5a, tk->tp.size);
+	memset(jited, 0x5a, tk->tp.size);
+
+	tk->tp.bpf_prog = NULL;
+	interp_ns = kprobe_fetch_bpf_time(tk, interp, &regs);
+	tk->tp.bpf_prog = prog;
+	jited_ns = kprobe_fetch_bpf_time(tk, jited, &regs);
+
+	ret = 0;
+	for (i = 0; i < tk->tp.nr_args; i++) {
+		struct probe_arg *parg = &tk->tp.args[i];
+
+		if (memcmp(interp + parg->offset, jited + parg->offset,
+			   parg->type->size)) {
+			pr_warn("fetch program differs on %s\n", parg->comm);
+			ret = -EINVAL;
+		}
+	}
+
+	if (WARN_ON_ONCE(ret))
+		pr_info("Testing kprobe fetch programs: NG\n");
+	else
+		pr_info("Testing kprobe fetch programs: OK, %llu ns interpreted, %llu ns compiled per hit\n",
+			interp_ns, jited_ns);
+
+ free_data:
+	kfree(interp);
+	kfree(jited);
+ free:
+	free_trace_kprobe(tk);
+	return ret;
+}
+
+late_initcall(kprobe_fetch_bpf_self_tests_init);
+#endif /* CONFIG_BPF_JIT */
+
 #endif
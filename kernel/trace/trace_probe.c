@@ -974,10 +974,191 @@ void trace_probe_unlink(struct trace_probe *tp)
 	tp->event = NULL;
 }
 
+#ifdef CONFIG_BPF_JIT
+/*
+ * The fetch_insns of the args of a probe can be compiled into a single
+ * BPF program and run by the BPF JIT instead of being interpreted by
+ * process_fetch_insn() for each arg on every hit.  Only register and
+ * immediate values, dereferences, raw or memory stores and bitfields are
+ * compiled; a probe with any other arg, such as a string, an array or
+ * an arch-specific $arg, $retval or $stack, stays interpreted.
+ */
+
+static int fetch_bpf_size(unsigned int size)
+{
+	switch (size) {
+	case 1:
+		return BPF_B;
+	case 2:
+		return BPF_H;
+	case 4:
+		return BPF_W;
+	case 8:
+		return BPF_DW;
+	}
+	return -ERR(EINVAL);
+}
+
+/*
+ * Emit the code of @arg at @insn, with R6 holding the pt_regs and R7 the
+ * entry data.  With a NULL @insn, only count the instructions.  Returns
+ * the number of instructions, or -EINVAL if @arg can't be compiled.
+ */
+static int fetch_emit_arg(struct bpf_insn *insn, struct probe_arg *arg,
+			  fetch_bpf_read_t read)
+{
+	struct fetch_insn *code = arg->code;
+	int fails[FETCH_INSN_MAX];
+	int n = 0, nr_fails = 0;
+	int i, size, bits;
+
+#define EMIT(x)	do { if (insn) insn[n] = (x); n++; } while (0)
+
+	if (arg->dynamic || arg->offset > S16_MAX)
+		return -ERR(EINVAL);
+
+	/* 1st stage: get the value into R0 */
+	switch (code->op) {
+	case FETCH_OP_REG:
+		if (code->param > S16_MAX)
+			return -ERR(EINVAL);
+		EMIT(BPF_LDX_MEM(BPF_DW, BPF_REG_0, BPF_REG_6, code->param));
+		break;
+	case FETCH_OP_IMM: {
+		struct bpf_insn ld[] = { BPF_LD_IMM64(BPF_REG_0, code->immediate) };
+
+		EMIT(ld[0]);
+		EMIT(ld[1]);
+		break;
+	}
+	default:
+		return -ERR(EINVAL);
+	}
+	code++;
+
+	/* 2nd stage: dereference through a stack slot, skip the arg on fault */
+	for (; code->op == FETCH_OP_DEREF; code++) {
+		EMIT(BPF_MOV64_REG(BPF_REG_3, BPF_REG_0));
+		EMIT(BPF_ALU64_IMM(BPF_ADD, BPF_REG_3, code->offset));
+		EMIT(BPF_MOV64_REG(BPF_REG_1, BPF_REG_10));
+		EMIT(BPF_ALU64_IMM(BPF_ADD, BPF_REG_1, -8));
+		EMIT(BPF_MOV64_IMM(BPF_REG_2, 8));
+		EMIT(BPF_EMIT_CALL(read));
+		fails[nr_fails++] = n;
+		EMIT(BPF_JMP_IMM(BPF_JNE, BPF_REG_0, 0, 0));
+		EMIT(BPF_LDX_MEM(BPF_DW, BPF_REG_0, BPF_REG_10, -8));
+	}
+
+	/* 3rd stage: store the value into the entry */
+	switch (code->op) {
+	case FETCH_OP_ST_RAW:
+		size = fetch_bpf_size(code->size);
+		if (size < 0)
+			return size;
+		EMIT(BPF_STX_MEM(size, BPF_REG_7, BPF_REG_0, arg->offset));
+		break;
+	case FETCH_OP_ST_MEM:
+		EMIT(BPF_MOV64_REG(BPF_REG_3, BPF_REG_0));
+		EMIT(BPF_ALU64_IMM(BPF_ADD, BPF_REG_3, code->offset));
+		EMIT(BPF_MOV64_REG(BPF_REG_1, BPF_REG_7));
+		EMIT(BPF_ALU64_IMM(BPF_ADD, BPF_REG_1, arg->offset));
+		EMIT(BPF_MOV64_IMM(BPF_REG_2, code->size));
+		EMIT(BPF_EMIT_CALL(read));
+		break;
+	default:
+		return -ERR(EINVAL);
+	}
+	code++;
+
+	/* 4th stage: shift the bitfield in place, as fetch_apply_bitfield() */
+	if (code->op == FETCH_OP_MOD_BF) {
+		size = fetch_bpf_size(code->basesize);
+		if (size < 0)
+			return size;
+		bits = code->basesize * 8;
+		EMIT(BPF_LDX_MEM(size, BPF_REG_0, BPF_REG_7, arg->offset));
+		EMIT(BPF_ALU64_IMM(BPF_LSH, BPF_REG_0, 64 - bits + code->lshift));
+		EMIT(BPF_ALU64_IMM(BPF_RSH, BPF_REG_0, 64 - bits + code->rshift));
+		EMIT(BPF_STX_MEM(size, BPF_REG_7, BPF_REG_0, arg->offset));
+		code++;
+	}
+
+	if (code->op != FETCH_OP_END)
+		return -ERR(EINVAL);
+
+	for (i = 0; insn && i < nr_fails; i++)
+		insn[fails[i]].off = n - (fails[i] + 1);
+#undef EMIT
+
+	return n;
+}
+
+/**
+ * trace_probe_compile - compile the args of a probe for the BPF JIT
+ * @tp: The probe, with all its args parsed
+ * @read: The helper that dereferences memory for this kind of probe
+ *
+ * Sets tp->bpf_prog if every arg of @tp can be compiled and the BPF JIT
+ * is enabled; otherwise the args keep being interpreted.
+ */
+void trace_probe_compile(struct trace_probe *tp, fetch_bpf_read_t read)
+{
+	struct bpf_prog *fp;
+	int i, len, ret, err;
+
+	/* Registers and dereferenced values are loaded as 64-bit words */
+	if (!IS_ENABLED(CONFIG_64BIT) || !tp->nr_args || tp->bpf_prog)
+		return;
+
+	len = 2;	/* load the context */
+	for (i = 0; i < tp->nr_args; i++) {
+		ret = fetch_emit_arg(NULL, &tp->args[i], read);
+		if (ret < 0)
+			return;
+		len += ret;
+	}
+	len += 2;	/* return */
+
+	if (len > BPF_MAXINSNS)
+		return;
+
+	fp = bpf_prog_alloc(bpf_prog_size(len), 0);
+	if (!fp)
+		return;
+
+	len = 0;
+	fp->insnsi[len++] = BPF_LDX_MEM(BPF_DW, BPF_REG_6, BPF_REG_1,
+					offsetof(struct fetch_bpf_ctx, regs));
+	fp->insnsi[len++] = BPF_LDX_MEM(BPF_DW, BPF_REG_7, BPF_REG_1,
+					offsetof(struct fetch_bpf_ctx, data));
+	for (i = 0; i < tp->nr_args; i++)
+		len += fetch_emit_arg(&fp->insnsi[len], &tp->args[i], read);
+	fp->insnsi[len++] = BPF_MOV64_IMM(BPF_REG_0, 0);
+	fp->insnsi[len++] = BPF_EXIT_INSN();
+	fp->len = len;
+	/* The stack slot of the dereferences */
+	fp->aux->stack_depth = 8;
+
+	fp = bpf_prog_select_runtime(fp, &err);
+	if (err || !fp->jited) {
+		bpf_prog_free(fp);
+		return;
+	}
+
+	tp->bpf_prog = fp;
+}
+#endif /* CONFIG_BPF_JIT */
+
 void trace_probe_cleanup(struct trace_probe *tp)
 {
 	int i;
 
+#ifdef CONFIG_BPF_JIT
+	if (tp->bpf_prog)
+		bpf_prog_free(tp->bpf_prog);
+	tp->bpf_prog = NULL;
+#endif
+
 	for (i = 0; i < tp->nr_args; i++)
 		traceprobe_free_probe_arg(&tp->args[i]);
 
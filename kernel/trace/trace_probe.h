@@ -24,6 +24,7 @@
 #include <linux/limits.h>
 #include <linux/uaccess.h>
 #include <linux/bitops.h>
+#include <linux/filter.h>
 #include <asm/bitsperlong.h>
 
 #include "trace.h"
@@ -242,11 +243,21 @@ struct trace_probe_event {
 struct trace_probe {
 	struct list_head		list;
 	struct trace_probe_event	*event;
+	struct bpf_prog			*bpf_prog; /* compiled fetch_insns */
 	ssize_t				size;	/* trace entry size */
 	unsigned int			nr_args;
 	struct probe_arg		args[];
 };
 
+/* Context of the BPF program compiled from the args of a trace_probe */
+struct fetch_bpf_ctx {
+	struct pt_regs			*regs;
+	void				*data;
+};
+
+/* BPF helper reading @size bytes at @src into @dest, 0 or -errno */
+typedef u64 (*fetch_bpf_read_t)(u64 dest, u64 size, u64 src, u64, u64);
+
 struct event_file_link {
 	struct trace_event_file		*file;
 	struct list_head		list;
@@ -331,6 +342,11 @@ static inline bool trace_probe_has_single_file(struct trace_probe *tp)
 int trace_probe_init(struct trace_probe *tp, const char *event,
 		     const char *group, bool alloc_filter);
 void trace_probe_cleanup(struct trace_probe *tp);
+#ifdef CONFIG_BPF_JIT
+void trace_probe_compile(struct trace_probe *tp, fetch_bpf_read_t read);
+#else
+#define trace_probe_compile(tp, read)	do { } while (0)
+#endif
 int trace_probe_append(struct trace_probe *tp, struct trace_probe *to);
 void trace_probe_unlink(struct trace_probe *tp);
 int trace_probe_register_event_call(struct trace_probe *tp);
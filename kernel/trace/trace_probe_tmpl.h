@@ -197,6 +197,21 @@ store_trace_args(void *data, struct trace_probe *tp, struct pt_regs *regs,
 	u32 *dl;	/* Data location */
 	int ret, i;
 
+#ifdef CONFIG_BPF_JIT
+	if (tp->bpf_prog) {
+		struct fetch_bpf_ctx ctx = { .regs = regs, .data = data };
+
+		/*
+		 * The program uses neither maps nor per-CPU data, so it is
+		 * called directly, without the run-time stats of
+		 * BPF_PROG_RUN() that need preemption disabled.
+		 */
+		bpf_dispatcher_nop_func(&ctx, tp->bpf_prog->insnsi,
+					tp->bpf_prog->bpf_func);
+		return;
+	}
+#endif
+
 	for (i = 0; i < tp->nr_args; i++) {
 		arg = tp->args + i;
 		dl = data + arg->offset;
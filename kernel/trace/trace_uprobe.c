@@ -215,6 +215,14 @@ static unsigned long translate_user_vaddr(unsigned long file_offset)
 	return base_addr + file_offset;
 }
 
+#ifdef CONFIG_BPF_JIT
+/* Memory reads of the compiled fetch programs, see trace_probe_compile() */
+BPF_CALL_3(uprobe_fetch_read, void *, dest, u32, size, void *, src)
+{
+	return probe_mem_read(dest, src, size);
+}
+#endif
+
 /* Note that we don't verify it, since the code does not come from user space */
 static int
 process_fetch_insn(struct fetch_insn *code, struct pt_regs *regs, void *dest,
@@ -685,6 +693,8 @@ static int trace_uprobe_create(int argc, const char **argv)
 	if (ret < 0)
 		goto error;
 
+	trace_probe_compile(&tu->tp, uprobe_fetch_read);
+
 	ret = register_trace_uprobe(tu);
 	if (!ret)
 		goto out;
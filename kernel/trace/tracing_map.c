@@ -446,51 +446,62 @@ static struct tracing_map_elt *tracing_map_elt_alloc(struct tracing_map *map)
 	return ERR_PTR(err);
 }
 
-static struct tracing_map_elt *get_free_elt(struct tracing_map *map)
+static struct tracing_map_elt *get_free_elt(struct tracing_map *map,
+					    struct tracing_map_level *level)
 {
 	struct tracing_map_elt *elt = NULL;
 	int idx;
 
-	idx = atomic_inc_return(&map->next_elt);
-	if (idx < map->max_elts) {
-		elt = *(TRACING_MAP_ELT(map->elts, idx));
+	idx = atomic_inc_return(&level->next_elt);
+	if (idx < level->max_elts) {
+		elt = *(TRACING_MAP_ELT(level->elts, idx));
 		if (map->ops && map->ops->elt_init)
 			map->ops->elt_init(elt);
+
+		/*
+		 * Add the next level while half of the last one is still
+		 * free.  Every later insertion retries if that failed.
+		 */
+		if (idx >= level->max_elts / 2 && !atomic_read(&map->growing) &&
+		    level == map->levels[smp_load_acquire(&map->n_levels) - 1] &&
+		    !atomic_xchg(&map->growing, 1))
+			irq_work_queue(&map->grow_irq_work);
 	}
 
 	return elt;
 }
 
-static void tracing_map_free_elts(struct tracing_map *map)
+static void tracing_map_free_elts(struct tracing_map_level *level)
 {
 	unsigned int i;
 
-	if (!map->elts)
+	if (!level->elts)
 		return;
 
-	for (i = 0; i < map->max_elts; i++) {
-		tracing_map_elt_free(*(TRACING_MAP_ELT(map->elts, i)));
-		*(TRACING_MAP_ELT(map->elts, i)) = NULL;
+	for (i = 0; i < level->max_elts; i++) {
+		tracing_map_elt_free(*(TRACING_MAP_ELT(level->elts, i)));
+		*(TRACING_MAP_ELT(level->elts, i)) = NULL;
 	}
 
-	tracing_map_array_free(map->elts);
-	map->elts = NULL;
+	tracing_map_array_free(level->elts);
+	level->elts = NULL;
 }
 
-static int tracing_map_alloc_elts(struct tracing_map *map)
+static int tracing_map_alloc_elts(struct tracing_map *map,
+				  struct tracing_map_level *level)
 {
 	unsigned int i;
 
-	map->elts = tracing_map_array_alloc(map->max_elts,
-					    sizeof(struct tracing_map_elt *));
-	if (!map->elts)
+	level->elts = tracing_map_array_alloc(level->max_elts,
+					      sizeof(struct tracing_map_elt *));
+	if (!level->elts)
 		return -ENOMEM;
 
-	for (i = 0; i < map->max_elts; i++) {
-		*(TRACING_MAP_ELT(map->elts, i)) = tracing_map_elt_alloc(map);
-		if (IS_ERR(*(TRACING_MAP_ELT(map->elts, i)))) {
-			*(TRACING_MAP_ELT(map->elts, i)) = NULL;
-			tracing_map_free_elts(map);
+	for (i = 0; i < level->max_elts; i++) {
+		*(TRACING_MAP_ELT(level->elts, i)) = tracing_map_elt_alloc(map);
+		if (IS_ERR(*(TRACING_MAP_ELT(level->elts, i)))) {
+			*(TRACING_MAP_ELT(level->elts, i)) = NULL;
+			tracing_map_free_elts(level);
 
 			return -ENOMEM;
 		}
@@ -499,6 +510,83 @@ static int tracing_map_alloc_elts(struct tracing_map *map)
 	return 0;
 }
 
+static void tracing_map_level_free(struct tracing_map_level *level)
+{
+	if (!level)
+		return;
+
+	tracing_map_free_elts(level);
+	tracing_map_array_free(level->map);
+	kfree(level);
+}
+
+static struct tracing_map_level *tracing_map_level_alloc(unsigned int map_bits)
+{
+	struct tracing_map_level *level;
+
+	level = kzalloc(sizeof(*level), GFP_KERNEL);
+	if (!level)
+		return NULL;
+
+	level->map_bits = map_bits;
+	level->max_elts = (1 << map_bits);
+	atomic_set(&level->next_elt, -1);
+
+	level->map_size = (1 << (map_bits + 1));
+	level->map = tracing_map_array_alloc(level->map_size,
+					     sizeof(struct tracing_map_entry));
+	if (!level->map) {
+		kfree(level);
+		return NULL;
+	}
+
+	return level;
+}
+
+/*
+ * Append a level twice as large as the last one, unless the map would
+ * then hold more than 2 ** TRACING_MAP_BITS_MAX elements.  Inserters
+ * never allocate, so this runs from a workqueue, queued through an
+ * irq_work since inserters may run in any context, once the last level
+ * is half full.  @growing stays set once the map cannot grow any more.
+ */
+static void tracing_map_grow(struct work_struct *work)
+{
+	struct tracing_map *map = container_of(work, struct tracing_map,
+					       grow_work);
+	struct tracing_map_level *last, *level;
+	unsigned int n_levels = map->n_levels;
+
+	last = map->levels[n_levels - 1];
+	if (n_levels == TRACING_MAP_LEVELS_MAX ||
+	    map->max_elts + (2 << last->map_bits) > (1 << TRACING_MAP_BITS_MAX))
+		return;
+
+	level = tracing_map_level_alloc(last->map_bits + 1);
+	if (!level)
+		goto out;
+
+	if (tracing_map_alloc_elts(map, level)) {
+		tracing_map_level_free(level);
+		goto out;
+	}
+
+	map->max_elts += level->max_elts;
+	map->levels[n_levels] = level;
+	/* Pairs with smp_load_acquire() in inserters and readers */
+	smp_store_release(&map->n_levels, n_levels + 1);
+ out:
+	atomic_set(&map->growing, 0);
+}
+
+static void tracing_map_grow_irq_work(struct irq_work *work)
+{
+	struct tracing_map *map = container_of(work, struct tracing_map,
+					       grow_irq_work);
+
+	schedule_work(&map->grow_work);
+}
+
 static inline bool keys_match(void *key, void *test_key, unsigned key_size)
 {
 	bool match = true;
@@ -509,27 +597,49 @@ static inline bool keys_match(void *key, void *test_key, unsigned key_size)
 	return match;
 }
 
+/*
+ * The val of a slot that was claimed after the last element of its level
+ * was taken.  The slot stays claimed so that no probe sequence through it
+ * is cut short, but it holds no key: the insertion that claimed it moved
+ * on to the next level, and so will every other insertion of the same key.
+ */
+#define TRACING_MAP_TOMBSTONE	((struct tracing_map_elt *)1UL)
+
+/*
+ * Look up, and unless lookup_only insert, key in one level of the map.
+ * Returns the element, or NULL with *next set if the key is not in this
+ * level and the next one should be tried, or NULL alone if the key was
+ * dropped.
+ */
 static inline struct tracing_map_elt *
-__tracing_map_insert(struct tracing_map *map, void *key, bool lookup_only)
+tracing_map_level_insert(struct tracing_map *map,
+			 struct tracing_map_level *level,
+			 void *key, u32 key_hash, bool lookup_only, bool *next)
 {
-	u32 idx, key_hash, test_key;
+	u32 idx, test_key;
 	int dup_try = 0;
 	struct tracing_map_entry *entry;
 	struct tracing_map_elt *val;
+	bool full;
 
-	key_hash = jhash(key, map->key_size, 0);
-	if (key_hash == 0)
-		key_hash = 1;
-	idx = key_hash >> (32 - (map->map_bits + 1));
+	/*
+	 * An inserter claims its slot before taking an element, so once
+	 * the last element is seen taken, every key that got one is seen
+	 * in its slot and a full level can be skipped on an empty slot.
+	 */
+	full = atomic_read(&level->next_elt) >= (int)level->max_elts - 1;
+	smp_rmb();
+
+	idx = key_hash >> (32 - (level->map_bits + 1));
 
 	while (1) {
-		idx &= (map->map_size - 1);
-		entry = TRACING_MAP_ENTRY(map->map, idx);
+		idx &= (level->map_size - 1);
+		entry = TRACING_MAP_ENTRY(level->map, idx);
 		test_key = entry->key;
 
 		if (test_key && test_key == key_hash) {
 			val = READ_ONCE(entry->val);
-			if (val &&
+			if (val && val != TRACING_MAP_TOMBSTONE &&
 			    keys_match(key, val->key, map->key_size)) {
 				if (!lookup_only)
 					atomic64_inc(&map->hits);
@@ -548,25 +658,25 @@ __tracing_map_insert(struct tracing_map *map, void *key, bool lookup_only)
 				 */
 
 				dup_try++;
-				if (dup_try > map->map_size) {
+				if (dup_try > level->map_size) {
 					atomic64_inc(&map->drops);
-					break;
+					return NULL;
 				}
 				continue;
 			}
 		}
 
 		if (!test_key) {
-			if (lookup_only)
+			if (lookup_only || full)
 				break;
 
 			if (!cmpxchg(&entry->key, 0, key_hash)) {
 				struct tracing_map_elt *elt;
 
-				elt = get_free_elt(map);
+				elt = get_free_elt(map, level);
 				if (!elt) {
-					atomic64_inc(&map->drops);
-					entry->key = 0;
+					WRITE_ONCE(entry->val,
+						   TRACING_MAP_TOMBSTONE);
 					break;
 				}
 
@@ -588,6 +698,36 @@ __tracing_map_insert(struct tracing_map *map, void *key, bool lookup_only)
 		idx++;
 	}
 
+	*next = true;
+
+	return NULL;
+}
+
+static inline struct tracing_map_elt *
+__tracing_map_insert(struct tracing_map *map, void *key, bool lookup_only)
+{
+	unsigned int i, n_levels;
+	struct tracing_map_elt *val;
+	u32 key_hash;
+
+	key_hash = jhash(key, map->key_size, 0);
+	if (key_hash == 0)
+		key_hash = 1;
+
+	n_levels = smp_load_acquire(&map->n_levels);
+
+	for (i = 0; i < n_levels; i++) {
+		bool next = false;
+
+		val = tracing_map_level_insert(map, map->levels[i], key,
+					       key_hash, lookup_only, &next);
+		if (!next)
+			return val;
+	}
+
+	if (!lookup_only)
+		atomic64_inc(&map->drops);
+
 	return NULL;
 }
 
@@ -600,33 +740,34 @@ __tracing_map_insert(struct tracing_map *map, void *key, bool lookup_only)
  * tracing_map_elt for it, or if the key has already been inserted by
  * a previous call, returns the tracing_map_elt already associated
  * with it.  When the map was created, the number of elements to be
- * allocated for the map was specified (internally maintained as
- * 'max_elts' in struct tracing_map), and that number of
+ * allocated for the map was specified, and that number of
  * tracing_map_elts was created by tracing_map_init().  This is the
  * pre-allocated pool of tracing_map_elts that tracing_map_insert()
- * will allocate from when adding new keys.  Once that pool is
- * exhausted, tracing_map_insert() is useless and will return NULL to
- * signal that state.  There are two user-visible tracing_map
- * variables, 'hits' and 'drops', which are updated by this function.
- * Every time an element is either successfully inserted or retrieved,
- * the 'hits' value is incrememented.  Every time an element insertion
- * fails, the 'drops' value is incremented.
+ * will allocate from when adding new keys.  When half of that pool is
+ * in use, a new level with a pool twice as large is added to the map
+ * from a workqueue, and so on until the map holds 2 **
+ * TRACING_MAP_BITS_MAX elements.  Only once the last level is
+ * exhausted, or if keys arrive faster than levels can be added, does
+ * tracing_map_insert() return NULL.  There are two user-visible
+ * tracing_map variables, 'hits' and 'drops', which are updated by
+ * this function.  Every time an element is either successfully
+ * inserted or retrieved, the 'hits' value is incrememented.  Every
+ * time an element insertion fails, the 'drops' value is incremented.
  *
  * This is a lock-free tracing map insertion function implementing a
  * modified form of Cliff Click's basic insertion algorithm.  It
  * requires the table size be a power of two.  To prevent any
  * possibility of an infinite loop we always make the internal table
- * size double the size of the requested table size (max_elts * 2).
- * Likewise, we never reuse a slot or resize or delete elements - when
- * we've reached max_elts entries, we simply return NULL once we've
- * run out of entries.  Readers can at any point in time traverse the
- * tracing map and safely access the key/val pairs.
+ * size of each level double the size of its element pool.  Likewise,
+ * we never reuse a slot, move keys between levels or delete elements.
+ * Readers can at any point in time traverse the tracing map and
+ * safely access the key/val pairs.
  *
  * Return: the tracing_map_elt pointer val associated with the key.
  * If this was a newly inserted key, the val will be a newly allocated
  * and associated tracing_map_elt pointer val.  If the key wasn't
- * found and the pool of tracing_map_elts has been exhausted, NULL is
- * returned and no further insertions will succeed.
+ * found and no level has a free tracing_map_elt left, NULL is
+ * returned.
  */
 struct tracing_map_elt *tracing_map_insert(struct tracing_map *map, void *key)
 {
@@ -667,12 +808,17 @@ struct tracing_map_elt *tracing_map_lookup(struct tracing_map *map, void *key)
  */
 void tracing_map_destroy(struct tracing_map *map)
 {
+	unsigned int i;
+
 	if (!map)
 		return;
 
-	tracing_map_free_elts(map);
+	irq_work_sync(&map->grow_irq_work);
+	cancel_work_sync(&map->grow_work);
+
+	for (i = 0; i < map->n_levels; i++)
+		tracing_map_level_free(map->levels[i]);
 
-	tracing_map_array_free(map->map);
 	kfree(map);
 }
 
@@ -689,16 +835,22 @@ void tracing_map_destroy(struct tracing_map *map)
  */
 void tracing_map_clear(struct tracing_map *map)
 {
-	unsigned int i;
+	unsigned int i, j, n_levels;
 
-	atomic_set(&map->next_elt, -1);
 	atomic64_set(&map->hits, 0);
 	atomic64_set(&map->drops, 0);
 
-	tracing_map_array_clear(map->map);
+	n_levels = smp_load_acquire(&map->n_levels);
+
+	for (i = 0; i < n_levels; i++) {
+		struct tracing_map_level *level = map->levels[i];
 
-	for (i = 0; i < map->max_elts; i++)
-		tracing_map_elt_clear(*(TRACING_MAP_ELT(map->elts, i)));
+		atomic_set(&level->next_elt, -1);
+		tracing_map_array_clear(level->map);
+
+		for (j = 0; j < level->max_elts; j++)
+			tracing_map_elt_clear(*(TRACING_MAP_ELT(level->elts, j)));
+	}
 }
 
 static void set_sort_key(struct tracing_map *map,
@@ -714,9 +866,10 @@ static void set_sort_key(struct tracing_map *map,
  * @ops: Optional client-defined tracing_map_ops instance
  * @private_data: Client data associated with the map
  *
- * Creates and sets up a map to contain 2 ** map_bits number of
- * elements (internally maintained as 'max_elts' in struct
- * tracing_map).  Before using, map fields should be added to the map
+ * Creates and sets up a map to initially contain 2 ** map_bits number
+ * of elements (internally maintained as 'max_elts' in struct
+ * tracing_map).  The map grows as it fills up, see
+ * tracing_map_insert().  Before using, map fields should be added to the map
  * with tracing_map_add_sum_field() and tracing_map_add_key_field().
  * tracing_map_init() should then be called to allocate the array of
  * tracing_map_elts, in order to avoid allocating anything in the map
@@ -773,19 +926,19 @@ struct tracing_map *tracing_map_create(unsigned int map_bits,
 	if (!map)
 		return ERR_PTR(-ENOMEM);
 
+	init_irq_work(&map->grow_irq_work, tracing_map_grow_irq_work);
+	INIT_WORK(&map->grow_work, tracing_map_grow);
+
 	map->map_bits = map_bits;
 	map->max_elts = (1 << map_bits);
-	atomic_set(&map->next_elt, -1);
-
-	map->map_size = (1 << (map_bits + 1));
 	map->ops = ops;
 
 	map->private_data = private_data;
 
-	map->map = tracing_map_array_alloc(map->map_size,
-					   sizeof(struct tracing_map_entry));
-	if (!map->map)
+	map->levels[0] = tracing_map_level_alloc(map_bits);
+	if (!map->levels[0])
 		goto free;
+	map->n_levels = 1;
 
 	map->key_size = key_size;
 	for (i = 0; i < TRACING_MAP_KEYS_MAX; i++)
@@ -825,7 +978,7 @@ int tracing_map_init(struct tracing_map *map)
 	if (map->n_fields < 2)
 		return -ERR(EINVAL); /* need at least 1 key and 1 val */
 
-	err = tracing_map_alloc_elts(map);
+	err = tracing_map_alloc_elts(map, map->levels[0]);
 	if (err)
 		return err;
 
@@ -1064,25 +1217,36 @@ int tracing_map_sort_entries(struct tracing_map *map,
 	int (*cmp_entries_fn)(const struct tracing_map_sort_entry **,
 			      const struct tracing_map_sort_entry **);
 	struct tracing_map_sort_entry *sort_entry, **entries;
+	unsigned int l, n_levels, max_elts = 0;
 	int i, n_entries, ret;
 
-	entries = vmalloc(array_size(sizeof(sort_entry), map->max_elts));
+	n_levels = smp_load_acquire(&map->n_levels);
+	for (l = 0; l < n_levels; l++)
+		max_elts += map->levels[l]->max_elts;
+
+	entries = vmalloc(array_size(sizeof(sort_entry), max_elts));
 	if (!entries)
 		return -ENOMEM;
 
-	for (i = 0, n_entries = 0; i < map->map_size; i++) {
-		struct tracing_map_entry *entry;
+	for (l = 0, n_entries = 0; l < n_levels; l++) {
+		struct tracing_map_level *level = map->levels[l];
 
-		entry = TRACING_MAP_ENTRY(map->map, i);
+		for (i = 0; i < level->map_size; i++) {
+			struct tracing_map_entry *entry;
+			struct tracing_map_elt *val;
 
-		if (!entry->key || !entry->val)
-			continue;
+			entry = TRACING_MAP_ENTRY(level->map, i);
+			val = READ_ONCE(entry->val);
 
-		entries[n_entries] = create_sort_entry(entry->val->key,
-						       entry->val);
-		if (!entries[n_entries++]) {
-			ret = -ENOMEM;
-			goto free;
+			if (!entry->key || !val ||
+			    val == TRACING_MAP_TOMBSTONE)
+				continue;
+
+			entries[n_entries] = create_sort_entry(val->key, val);
+			if (!entries[n_entries++]) {
+				ret = -ENOMEM;
+				goto free;
+			}
 		}
 	}
 
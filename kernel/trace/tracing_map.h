@@ -2,9 +2,14 @@
 #ifndef __TRACING_MAP_H
 #define __TRACING_MAP_H
 
+#include <linux/irq_work.h>
+#include <linux/workqueue.h>
+
 #define TRACING_MAP_BITS_DEFAULT	11
 #define TRACING_MAP_BITS_MAX		17
 #define TRACING_MAP_BITS_MIN		7
+#define TRACING_MAP_LEVELS_MAX		(TRACING_MAP_BITS_MAX - \
+					 TRACING_MAP_BITS_MIN + 1)
 
 #define TRACING_MAP_KEYS_MAX		3
 #define TRACING_MAP_VALS_MAX		3
@@ -23,7 +28,7 @@ typedef int (*tracing_map_cmp_fn_t) (void *val_a, void *val_b);
  *
  * The central data structure of the tracing_map is an initially
  * zeroed array of struct tracing_map_entry (stored in the map field
- * of struct tracing_map).  tracing_map_entry is a very simple data
+ * of struct tracing_map_level).  tracing_map_entry is a very simple data
  * structure containing only two fields: a 32-bit unsigned 'key'
  * variable and a pointer named 'val'.  This array of struct
  * tracing_map_entry is essentially a hash table which will be
@@ -67,7 +72,17 @@ typedef int (*tracing_map_cmp_fn_t) (void *val_a, void *val_b);
  * the way the insertion algorithm works, the size of the allocated
  * tracing_map_entry array is always twice the maximum number of
  * elements (2 * max_elts).  This value is stored in the map_size
- * field of struct tracing_map.
+ * field of struct tracing_map_level.
+ *
+ * The tracing_map_entry array and its pool of max_elts elements form
+ * a struct tracing_map_level.  The map starts with a single level of
+ * the user-specified size, and when half of the elements of the last
+ * level are in use, a new level twice as large is allocated from a
+ * workqueue and appended to the levels array of struct tracing_map.
+ * Keys are never moved between levels: a key is looked up in every
+ * level in turn, and is inserted into the first level that still has
+ * free elements.  Levels are added until the map holds 2 **
+ * TRACING_MAP_BITS_MAX elements, the largest size a user can request.
  *
  * Because tracing_map_insert() needs to work from any context,
  * including from within the memory allocation functions themselves,
@@ -180,14 +195,24 @@ struct tracing_map_array {
 #define TRACING_MAP_ELT(array, idx)					\
 	((struct tracing_map_elt **)TRACING_MAP_ARRAY_ELT(array, idx))
 
-struct tracing_map {
-	unsigned int			key_size;
+struct tracing_map_level {
 	unsigned int			map_bits;
 	unsigned int			map_size;
 	unsigned int			max_elts;
 	atomic_t			next_elt;
 	struct tracing_map_array	*elts;
 	struct tracing_map_array	*map;
+};
+
+struct tracing_map {
+	unsigned int			key_size;
+	unsigned int			map_bits;
+	unsigned int			max_elts;
+	unsigned int			n_levels;
+	struct tracing_map_level	*levels[TRACING_MAP_LEVELS_MAX];
+	atomic_t			growing;
+	struct irq_work			grow_irq_work;
+	struct work_struct		grow_work;
 	const struct tracing_map_ops	*ops;
 	void				*private_data;
 	struct tracing_map_field	fields[TRACING_MAP_FIELDS_MAX];
@@ -217,7 +242,8 @@ struct tracing_map {
  *	allocate additional data and attach it to the element
  *	(tracing_map_elt->private_data is meant for that purpose).
  *	Element allocation occurs before tracing begins, when the
- *	tracing_map_init() call is made by client code.
+ *	tracing_map_init() call is made by client code, and from a
+ *	workqueue each time the map grows a new level.
  *
  * @elt_free: When a tracing_map_elt is freed, this function is called
  *	and allows client-allocated per-element data to be freed.
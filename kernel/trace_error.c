@@ -1,19 +1,1016 @@
 #include <linux/trace_error.h>
 #include <linux/sched.h>
+#include <linux/sched/clock.h>
+#include <linux/cgroup.h>
 #include <linux/preempt.h>
+#include <linux/percpu.h>
+#include <linux/jump_label.h>
+#include <linux/sysctl.h>
+#include <linux/kernel.h>
+#include <linux/init.h>
+#include <linux/list.h>
+#include <linux/module.h>
+#include <linux/mutex.h>
+#include <linux/rculist.h>
+#include <linux/seq_file.h>
+#include <linux/debugfs.h>
+#include <linux/string.h>
+#include <linux/parser.h>
+#include <linux/uaccess.h>
+#include <linux/slab.h>
+#include <linux/pid.h>
+#include <linux/pid_namespace.h>
+#include <linux/proc_fs.h>
+#include <uapi/linux/trace_error.h>
 
-void set_last_err(const char *file, unsigned int line, int errno)
+#define CREATE_TRACE_POINTS
+#include <trace/events/error.h>
+
+/*
+ * trace_error_key enables the ERR() sites and counts their users:
+ * recording into the task, and the error_set tracepoint.
+ * trace_error_record_key only gates recording into the task.
+ */
+DEFINE_STATIC_KEY_FALSE(trace_error_key);
+EXPORT_SYMBOL(trace_error_key);
+DEFINE_STATIC_KEY_FALSE(trace_error_record_key);
+EXPORT_SYMBOL(trace_error_record_key);
+static DEFINE_MUTEX(trace_error_record_mutex);
+
+static bool trace_error_boot __initdata =
+	IS_ENABLED(CONFIG_TRACE_ERROR_DEFAULT_ON);
+
+extern struct err_site __start___err_sites[];
+extern struct err_site __stop___err_sites[];
+
+/*
+ * Site ids are handed out in contiguous ranges, one per table, and are
+ * never reused. A task may still refer to a site of an unloaded module;
+ * such ids simply fail to resolve.
+ */
+struct err_site_table {
+	struct list_head	list;
+	struct module		*mod;
+	struct err_site		*sites;
+	unsigned int		num_sites;
+	unsigned int		base;
+};
+
+static struct err_site_table core_err_sites;
+static LIST_HEAD(err_site_tables);
+static DEFINE_MUTEX(err_sites_mutex);
+static unsigned int err_site_next_id = 1;
+
+/*
+ * Hot sites can be sampled so that recording them has a bounded cost.
+ * A sampled site points to one of the slots below through its
+ * ->sampler index, and each CPU keeps its own state for every slot.
+ * Slot 0 is never used, so a zero index means the site is not sampled.
+ * Slot ERR_SAMPLER_NOISY is shared by all the sites of noisy errnos that
+ * have no rule of their own, see __err_noisy().
+ */
+#define ERR_SAMPLERS		256
+#define ERR_SAMPLERS_FIRST	(ERR_SAMPLER_NOISY + 1)
+
+enum err_sample_mode {
+	ERR_SAMPLE_ONE_IN,	/* record one evaluation in @value */
+	ERR_SAMPLE_RATE,	/* record at most @value per second per CPU */
+};
+
+struct err_sampler {
+	unsigned int		site;
+	enum err_sample_mode	mode;
+	unsigned int		value;
+};
+
+struct err_sample_state {
+	unsigned long	count;
+	u64		begin;
+};
+
+struct err_sample_states {
+	struct err_sample_state	state[ERR_SAMPLERS];
+};
+
+static struct err_sampler err_samplers[ERR_SAMPLERS] = {
+	[ERR_SAMPLER_NOISY] = {
+		.mode	= ERR_SAMPLE_ONE_IN,
+		.value	= CONFIG_TRACE_ERROR_NOISY_SAMPLE,
+	},
+};
+static struct err_sample_states __percpu *err_sample_states;
+
+static bool err_sample(unsigned int idx)
+{
+	struct err_sampler *sampler = &err_samplers[idx];
+	unsigned int value = READ_ONCE(sampler->value);
+	struct err_sample_state *state;
+	bool record;
+	u64 now;
+
+	if (!err_sample_states || !value)
+		return true;
+
+	state = &get_cpu_ptr(err_sample_states)->state[idx];
+
+	switch (READ_ONCE(sampler->mode)) {
+	case ERR_SAMPLE_ONE_IN:
+		record = ++state->count >= value;
+		if (record)
+			state->count = 0;
+		break;
+	case ERR_SAMPLE_RATE:
+		now = local_clock();
+		if (now - state->begin >= NSEC_PER_SEC) {
+			state->begin = now;
+			state->count = 0;
+		}
+		record = state->count++ < value;
+		break;
+	default:
+		record = true;
+		break;
+	}
+
+	put_cpu_ptr(err_sample_states);
+	return record;
+}
+
+static void last_err_record(struct last_err *last_err,
+			    const struct err_site *site)
+{
+	unsigned int head = last_err->head;
+	struct err_record *record;
+
+	/*
+	 * Only the syscall-scoped architectures clear @pending_errno at
+	 * syscall entry. Elsewhere there is no syscall to chain the errors
+	 * of, and @start stays zero so that the history is simply the latest
+	 * records.
+	 */
+	if (IS_ENABLED(CONFIG_TRACE_ERROR_SYSCALL_SCOPED) &&
+	    !last_err->pending_errno)
+		WRITE_ONCE(last_err->start, head);
+
+	record = &last_err->history[head & (TRACE_ERROR_HISTORY - 1)];
+	WRITE_ONCE(record->time, local_clock());
+	WRITE_ONCE(record->site, site->id);
+
+	/*
+	 * Publish the record, and order the new head before the stores that
+	 * will overwrite the oldest record; pairs with the smp_rmb() of
+	 * proc_pid_error_history().
+	 */
+	smp_wmb();
+	WRITE_ONCE(last_err->head, head + 1);
+	smp_wmb();
+
+	last_err->pending = site->id;
+	last_err->pending_errno = site->errno;
+#ifndef CONFIG_TRACE_ERROR_SYSCALL_SCOPED
+	/* The syscall number is filled in if the syscall returns the error. */
+	WRITE_ONCE(last_err->last, LAST_ERR_PACK(site->id, -1));
+#endif
+}
+
+/*
+ * A program attached to error_set may itself hit an ERR() site, from a
+ * failing helper for instance, which would fire the tracepoint again
+ * without bound. One bit per context on each CPU, like the ring buffer's
+ * recursion check, drops the nested event instead while still letting
+ * an interrupt trace its own errors.
+ */
+static DEFINE_PER_CPU(unsigned int, error_set_recursion);
+
+static __always_inline void trace_error_set_once(const struct err_site *site)
+{
+	unsigned int bit, *recursion;
+
+	if (!trace_error_set_enabled())
+		return;
+
+	if (in_nmi())
+		bit = 1U << 3;
+	else if (in_irq())
+		bit = 1U << 2;
+	else if (in_serving_softirq())
+		bit = 1U << 1;
+	else
+		bit = 1U << 0;
+
+	preempt_disable_notrace();
+	recursion = this_cpu_ptr(&error_set_recursion);
+	if (!(*recursion & bit)) {
+		*recursion |= bit;
+		barrier();
+		trace_error_set(site);
+		barrier();
+		*recursion &= ~bit;
+	}
+	preempt_enable_notrace();
+}
+
+void set_last_err(const struct err_site *site)
 {
 	struct last_err *last_err;
+	unsigned int sampler;
+
+	/*
+	 * Sampled-out evaluations, most of those of noisy errnos, return
+	 * before the tracepoint so that sampling bounds its cost as well.
+	 */
+	sampler = READ_ONCE(site->sampler);
+	if (unlikely(sampler) && !err_sample(sampler))
+		return;
+
+	trace_error_set_once(site);
 
-	if (!in_task())
+	if (!trace_error_enabled() || !in_task())
 		return;
 
+	trace_error_count(site->id);
+	cgroup_account_error(site->id);
+
 	last_err = &current->last_err;
+	if (last_err->capture)
+		WRITE_ONCE(last_err->capture->site, site->id);
 
-	last_err->file = file;
-	last_err->line = line;
-	last_err->errno = errno;
+	last_err_record(last_err, site);
 }
 
 EXPORT_SYMBOL(set_last_err);
+
+/*
+ * Record the error captured in @cap as if current had hit it, so that an
+ * error returned by a worker is reported by the syscall waiting for it.
+ * @status is what the work completed with: the site is only taken over
+ * if it raised that very errno, not when the work recovered from it or
+ * failed for another reason. The site was already traced, sampled and
+ * counted by the worker. Called from completion paths; @cap may be NULL.
+ */
+void trace_error_propagate(const struct err_capture *cap, int status)
+{
+	const struct err_site *site;
+	unsigned int id;
+
+	if (!cap || status >= 0 || !trace_error_enabled() || !in_task())
+		return;
+
+	id = READ_ONCE(cap->site);
+	if (!id)
+		return;
+
+	rcu_read_lock();
+	site = err_site_find(id);
+	if (site && status == -site->errno)
+		last_err_record(&current->last_err, site);
+	rcu_read_unlock();
+}
+EXPORT_SYMBOL_GPL(trace_error_propagate);
+
+static void err_sites_add(struct err_site_table *table, struct module *mod,
+			  struct err_site *sites, unsigned int num_sites)
+{
+	unsigned int i;
+
+	lockdep_assert_held(&err_sites_mutex);
+
+	table->mod = mod;
+	table->sites = sites;
+	table->num_sites = num_sites;
+	table->base = err_site_next_id;
+	err_site_next_id += num_sites;
+
+	for (i = 0; i < num_sites; i++)
+		sites[i].id = table->base + i;
+
+	list_add_tail_rcu(&table->list, &err_site_tables);
+}
+
+/*
+ * Resolve a site id. Tables are removed under RCU before their module is
+ * freed, so the site stays valid until rcu_read_unlock().
+ */
+const struct err_site *err_site_find(unsigned int id)
+{
+	struct err_site_table *table;
+
+	RCU_LOCKDEP_WARN(!rcu_read_lock_held(),
+			 "err_site_find() needs rcu_read_lock() protection");
+
+	if (!id)
+		return NULL;
+
+	list_for_each_entry_rcu(table, &err_site_tables, list) {
+		if (id >= table->base && id - table->base < table->num_sites)
+			return &table->sites[id - table->base];
+	}
+	return NULL;
+}
+
+/*
+ * Print "file:line errno" for the site @id. Returns false, printing
+ * nothing, if @id is unset or no longer resolves.
+ */
+bool seq_print_err_site(struct seq_file *m, unsigned int id)
+{
+	const struct err_site *site;
+	bool found = false;
+
+	rcu_read_lock();
+	site = err_site_find(id);
+	if (site) {
+		seq_printf(m, "%s:%u %d", site->file, site->line, site->errno);
+		found = true;
+	}
+	rcu_read_unlock();
+
+	return found;
+}
+
+#ifdef CONFIG_PROC_FS
+/*
+ * /proc/last_errors and /proc/last_errors_raw dump the last error of every
+ * task that has one, in the pid namespace of the proc mount, as text or
+ * as struct last_error_record. Each read() chunk is produced in a single
+ * RCU walk over pid numbers, so no task reference or lock is taken per
+ * task. /proc/err_sites maps site ids to their descriptors.
+ */
+static struct task_struct *last_errors_find(struct seq_file *m, loff_t *pos)
+{
+	struct pid_namespace *ns = proc_pid_ns(file_inode(m->file)->i_sb);
+	struct task_struct *task;
+	struct pid *pid;
+
+	for (;; (*pos)++) {
+		pid = find_ge_pid(*pos, ns);
+		if (!pid)
+			return NULL;
+		*pos = pid_nr_ns(pid, ns);
+		task = pid_task(pid, PIDTYPE_PID);
+		if (task && last_err_site(READ_ONCE(task->last_err.last)))
+			return task;
+	}
+}
+
+static void *last_errors_start(struct seq_file *m, loff_t *pos)
+	__acquires(RCU)
+{
+	rcu_read_lock();
+	return last_errors_find(m, pos);
+}
+
+static void *last_errors_next(struct seq_file *m, void *v, loff_t *pos)
+{
+	(*pos)++;
+	return last_errors_find(m, pos);
+}
+
+static void last_errors_stop(struct seq_file *m, void *v)
+	__releases(RCU)
+{
+	rcu_read_unlock();
+}
+
+static int last_errors_show(struct seq_file *m, void *v)
+{
+	struct pid_namespace *ns = proc_pid_ns(file_inode(m->file)->i_sb);
+	struct task_struct *task = v;
+	u64 last = READ_ONCE(task->last_err.last);
+
+	seq_printf(m, "%d %d ", task_tgid_nr_ns(task, ns),
+		   task_pid_nr_ns(task, ns));
+	if (!seq_print_err_site(m, last_err_site(last)))
+		seq_printf(m, "site:%u", last_err_site(last));
+	seq_printf(m, " %d\n", last_err_nr(last));
+	return 0;
+}
+
+static int last_errors_raw_show(struct seq_file *m, void *v)
+{
+	struct pid_namespace *ns = proc_pid_ns(file_inode(m->file)->i_sb);
+	struct task_struct *task = v;
+	u64 last = READ_ONCE(task->last_err.last);
+	struct last_error_record rec = {
+		.tgid	= task_tgid_nr_ns(task, ns),
+		.tid	= task_pid_nr_ns(task, ns),
+		.site	= last_err_site(last),
+		.nr	= last_err_nr(last),
+	};
+	const struct err_site *site = err_site_find(rec.site);
+
+	rec.error = site ? site->errno : 0;
+	seq_write(m, &rec, sizeof(rec));
+	return 0;
+}
+
+static const struct seq_operations last_errors_seq_ops = {
+	.start	= last_errors_start,
+	.next	= last_errors_next,
+	.stop	= last_errors_stop,
+	.show	= last_errors_show,
+};
+
+static const struct seq_operations last_errors_raw_seq_ops = {
+	.start	= last_errors_start,
+	.next	= last_errors_next,
+	.stop	= last_errors_stop,
+	.show	= last_errors_raw_show,
+};
+
+/* Tables are kept in increasing id order. */
+static const struct err_site *err_site_find_ge(loff_t *pos)
+{
+	struct err_site_table *table;
+
+	list_for_each_entry_rcu(table, &err_site_tables, list) {
+		if (*pos < table->base)
+			*pos = table->base;
+		if (*pos - table->base < table->num_sites)
+			return &table->sites[*pos - table->base];
+	}
+	return NULL;
+}
+
+static void *error_sites_start(struct seq_file *m, loff_t *pos)
+	__acquires(RCU)
+{
+	rcu_read_lock();
+	return (void *)err_site_find_ge(pos);
+}
+
+static void *error_sites_next(struct seq_file *m, void *v, loff_t *pos)
+{
+	(*pos)++;
+	return (void *)err_site_find_ge(pos);
+}
+
+static int error_sites_show(struct seq_file *m, void *v)
+{
+	const struct err_site *site = v;
+
+	seq_printf(m, "%u %s:%u %d %s\n", site->id, site->file, site->line,
+		   site->errno, site->function);
+	return 0;
+}
+
+static const struct seq_operations error_sites_seq_ops = {
+	.start	= error_sites_start,
+	.next	= error_sites_next,
+	.stop	= last_errors_stop,
+	.show	= error_sites_show,
+};
+
+static int __init last_errors_proc_init(void)
+{
+	proc_create_seq("last_errors", 0400, NULL, &last_errors_seq_ops);
+	proc_create_seq("last_errors_raw", 0400, NULL,
+			&last_errors_raw_seq_ops);
+	proc_create_seq("err_sites", 0444, NULL, &error_sites_seq_ops);
+	return 0;
+}
+fs_initcall(last_errors_proc_init);
+#endif /* CONFIG_PROC_FS */
+
+/* The slot of a site without a rule of its own. */
+static unsigned int err_sampler_default(const struct err_site *site)
+{
+	return __err_noisy(site->errno) ? ERR_SAMPLER_NOISY : 0;
+}
+
+/*
+ * Give @site a rule of its own, or drop it if @value is zero, which puts
+ * the site back to its default.
+ */
+static int err_sampler_set(struct err_site *site, enum err_sample_mode mode,
+			   unsigned int value)
+{
+	unsigned int idx = site->sampler;
+
+	lockdep_assert_held(&err_sites_mutex);
+
+	if (idx < ERR_SAMPLERS_FIRST)
+		idx = 0;
+
+	if (!value) {
+		if (idx) {
+			WRITE_ONCE(site->sampler, err_sampler_default(site));
+			WRITE_ONCE(err_samplers[idx].value, 0);
+			err_samplers[idx].site = 0;
+		}
+		return 0;
+	}
+
+	if (!idx) {
+		for (idx = ERR_SAMPLERS_FIRST; idx < ERR_SAMPLERS; idx++) {
+			if (!err_samplers[idx].site)
+				break;
+		}
+		if (idx == ERR_SAMPLERS)
+			return -ERR(ENOSPC);
+		err_samplers[idx].site = site->id;
+	}
+
+	WRITE_ONCE(err_samplers[idx].mode, mode);
+	WRITE_ONCE(err_samplers[idx].value, value);
+	WRITE_ONCE(site->sampler, idx);
+	return 0;
+}
+
+#ifdef CONFIG_DEBUG_FS
+/*
+ * <debugfs>/trace_error/sampling takes one rule per line:
+ *
+ *   <file>[:<line>] 1/<n>       record one evaluation in n
+ *   <file>[:<line>] rate=<n>    record at most n per second per CPU
+ *   <file>[:<line>] off         drop the rule of the site
+ *
+ * Dropping the rule of a site of a noisy errno puts it back to the
+ * @noisy rule, which applies to all such sites without a rule of their
+ * own and takes the same 1/<n>, rate=<n> and off specs. The file lists
+ * the @noisy rule and the sampled sites when read.
+ */
+static int err_sampling_apply(char *rule)
+{
+	char *loc, *spec, *colon;
+	enum err_sample_mode mode;
+	struct err_site_table *table;
+	unsigned int line = 0, value, i, matched = 0;
+	int ret;
+
+	loc = strsep(&rule, " \t");
+	spec = rule ? strim(rule) : NULL;
+	if (!*loc || !spec || !*spec)
+		return -ERR(EINVAL);
+
+	colon = strcmp(loc, "@noisy") ? strrchr(loc, ':') : NULL;
+	if (colon) {
+		*colon = '\0';
+		if (kstrtouint(colon + 1, 10, &line) || !line)
+			return -ERR(EINVAL);
+	}
+
+	if (!strcmp(spec, "off")) {
+		mode = ERR_SAMPLE_ONE_IN;
+		value = 0;
+	} else if (!strncmp(spec, "1/", 2)) {
+		mode = ERR_SAMPLE_ONE_IN;
+		if (kstrtouint(spec + 2, 10, &value) || !value)
+			return -ERR(EINVAL);
+	} else if (!strncmp(spec, "rate=", 5)) {
+		mode = ERR_SAMPLE_RATE;
+		if (kstrtouint(spec + 5, 10, &value) || !value)
+			return -ERR(EINVAL);
+	} else {
+		return -ERR(EINVAL);
+	}
+
+	if (!strcmp(loc, "@noisy")) {
+		WRITE_ONCE(err_samplers[ERR_SAMPLER_NOISY].mode, mode);
+		WRITE_ONCE(err_samplers[ERR_SAMPLER_NOISY].value, value);
+		return 0;
+	}
+
+	list_for_each_entry(table, &err_site_tables, list) {
+		for (i = 0; i < table->num_sites; i++) {
+			struct err_site *site = &table->sites[i];
+
+			if (strcmp(site->file, loc) || (line && site->line != line))
+				continue;
+			ret = err_sampler_set(site, mode, value);
+			if (ret)
+				return ret;
+			matched++;
+		}
+	}
+
+	return matched ? 0 : -ERR(ENOENT);
+}
+
+static ssize_t err_sampling_write(struct file *file, const char __user *ubuf,
+				  size_t len, loff_t *offp)
+{
+	char *buf, *rules, *rule;
+	int ret = 0;
+
+	if (len > PAGE_SIZE - 1)
+		return -ERR(E2BIG);
+
+	buf = memdup_user_nul(ubuf, len);
+	if (IS_ERR(buf))
+		return PTR_ERR(buf);
+
+	mutex_lock(&err_sites_mutex);
+	rules = buf;
+	while (!ret && (rule = strsep(&rules, "\n")) != NULL) {
+		rule = strim(rule);
+		if (*rule && *rule != '#')
+			ret = err_sampling_apply(rule);
+	}
+	mutex_unlock(&err_sites_mutex);
+
+	kfree(buf);
+	return ret ? ret : len;
+}
+
+static void err_sampler_show(struct seq_file *m,
+			     const struct err_sampler *sampler)
+{
+	if (!sampler->value)
+		seq_puts(m, " off\n");
+	else if (sampler->mode == ERR_SAMPLE_RATE)
+		seq_printf(m, " rate=%u\n", sampler->value);
+	else
+		seq_printf(m, " 1/%u\n", sampler->value);
+}
+
+static int err_sampling_show(struct seq_file *m, void *v)
+{
+	const struct err_site *site;
+	unsigned int idx;
+
+	mutex_lock(&err_sites_mutex);
+	seq_puts(m, "@noisy");
+	err_sampler_show(m, &err_samplers[ERR_SAMPLER_NOISY]);
+
+	rcu_read_lock();
+	for (idx = ERR_SAMPLERS_FIRST; idx < ERR_SAMPLERS; idx++) {
+		struct err_sampler *sampler = &err_samplers[idx];
+
+		site = err_site_find(sampler->site);
+		if (!site)
+			continue;
+		seq_printf(m, "%s:%u", site->file, site->line);
+		err_sampler_show(m, sampler);
+	}
+	rcu_read_unlock();
+	mutex_unlock(&err_sites_mutex);
+
+	return 0;
+}
+
+static int err_sampling_open(struct inode *inode, struct file *file)
+{
+	return single_open(file, err_sampling_show, NULL);
+}
+
+static const struct file_operations err_sampling_fops = {
+	.open		= err_sampling_open,
+	.read		= seq_read,
+	.write		= err_sampling_write,
+	.llseek		= seq_lseek,
+	.release	= single_release,
+};
+
+#ifdef CONFIG_TRACE_ERROR_SITE_KEYS
+/*
+ * <debugfs>/trace_error/control switches sites on and off, one query per
+ * line, in the style of dynamic_debug:
+ *
+ *   [file <glob>] [func <glob>] [line <n>[-<m>]] [errno <n>] +e|-e
+ *
+ * A site is switched if it matches every keyword given. A file glob is
+ * matched against the path of the site, such as security/commoncap.c,
+ * and against its base name. The sites of a write are patched together,
+ * see static_key_batch_begin(). Reading lists every site, with =e if it
+ * is on and =_ if not.
+ */
+struct err_query {
+	const char	*file;
+	const char	*func;
+	unsigned int	first_line;
+	unsigned int	last_line;
+	int		errno;
+};
+
+static bool err_query_match(const struct err_query *query,
+			    const struct err_site *site)
+{
+	if (query->file && !match_wildcard(query->file, site->file) &&
+	    !match_wildcard(query->file, kbasename(site->file)))
+		return false;
+	if (query->func && !match_wildcard(query->func, site->function))
+		return false;
+	if (site->line < query->first_line || site->line > query->last_line)
+		return false;
+	if (query->errno && site->errno != query->errno)
+		return false;
+	return true;
+}
+
+static int err_query_parse_lines(struct err_query *query, char *arg)
+{
+	char *last = strchr(arg, '-');
+
+	if (last)
+		*last++ = '\0';
+	if (kstrtouint(arg, 10, &query->first_line))
+		return -ERR(EINVAL);
+	if (!last)
+		query->last_line = query->first_line;
+	else if (kstrtouint(last, 10, &query->last_line) ||
+		 query->last_line < query->first_line)
+		return -ERR(EINVAL);
+	return 0;
+}
+
+static int err_control_apply(char *rule)
+{
+	struct err_query query = { .last_line = UINT_MAX };
+	struct err_site_table *table;
+	unsigned int i, matched = 0;
+	char *word, *arg, op = 0;
+	int ret = 0;
+
+	while (!ret && (word = strsep(&rule, " \t")) != NULL) {
+		if (!*word)
+			continue;
+		if (op)
+			return -ERR(EINVAL);
+		if (!strcmp(word, "+e") || !strcmp(word, "-e")) {
+			op = word[0];
+			continue;
+		}
+
+		do {
+			arg = strsep(&rule, " \t");
+		} while (arg && !*arg);
+		if (!arg)
+			return -ERR(EINVAL);
+
+		if (!strcmp(word, "file"))
+			query.file = arg;
+		else if (!strcmp(word, "func"))
+			query.func = arg;
+		else if (!strcmp(word, "line"))
+			ret = err_query_parse_lines(&query, arg);
+		else if (!strcmp(word, "errno"))
+			ret = kstrtoint(arg, 10, &query.errno) ? -ERR(EINVAL) : 0;
+		else
+			ret = -ERR(EINVAL);
+	}
+	if (ret)
+		return ret;
+	if (!op)
+		return -ERR(EINVAL);
+
+	query.errno = abs(query.errno);
+
+	list_for_each_entry(table, &err_site_tables, list) {
+		for (i = 0; i < table->num_sites; i++) {
+			struct err_site *site = &table->sites[i];
+
+			if (!err_query_match(&query, site))
+				continue;
+			static_key_batch_set(&site->key, op == '+');
+			matched++;
+		}
+	}
+
+	return matched ? 0 : -ERR(ENOENT);
+}
+
+static ssize_t err_control_write(struct file *file, const char __user *ubuf,
+				 size_t len, loff_t *offp)
+{
+	char *buf, *rules, *rule;
+	int ret = 0;
+
+	if (len > PAGE_SIZE - 1)
+		return -ERR(E2BIG);
+
+	buf = memdup_user_nul(ubuf, len);
+	if (IS_ERR(buf))
+		return PTR_ERR(buf);
+
+	mutex_lock(&err_sites_mutex);
+	static_key_batch_begin();
+	rules = buf;
+	while (!ret && (rule = strsep(&rules, "\n;")) != NULL) {
+		rule = strim(rule);
+		if (*rule && *rule != '#')
+			ret = err_control_apply(rule);
+	}
+	static_key_batch_end();
+	mutex_unlock(&err_sites_mutex);
+
+	kfree(buf);
+	return ret ? ret : len;
+}
+
+static struct err_site *err_control_site(loff_t pos)
+{
+	struct err_site_table *table;
+
+	list_for_each_entry(table, &err_site_tables, list) {
+		if (pos < table->num_sites)
+			return &table->sites[pos];
+		pos -= table->num_sites;
+	}
+	return NULL;
+}
+
+static void *err_control_start(struct seq_file *m, loff_t *pos)
+{
+	mutex_lock(&err_sites_mutex);
+	return err_control_site(*pos);
+}
+
+static void *err_control_next(struct seq_file *m, void *v, loff_t *pos)
+{
+	return err_control_site(++*pos);
+}
+
+static void err_control_stop(struct seq_file *m, void *v)
+{
+	mutex_unlock(&err_sites_mutex);
+}
+
+static int err_control_show(struct seq_file *m, void *v)
+{
+	struct err_site *site = v;
+
+	seq_printf(m, "%s:%u [%s] %d =%c\n", site->file, site->line,
+		   site->function, site->errno,
+		   static_key_enabled(&site->key) ? 'e' : '_');
+	return 0;
+}
+
+static const struct seq_operations err_control_seq_ops = {
+	.start	= err_control_start,
+	.next	= err_control_next,
+	.stop	= err_control_stop,
+	.show	= err_control_show,
+};
+
+static int err_control_open(struct inode *inode, struct file *file)
+{
+	return seq_open(file, &err_control_seq_ops);
+}
+
+static const struct file_operations err_control_fops = {
+	.open		= err_control_open,
+	.read		= seq_read,
+	.write		= err_control_write,
+	.llseek		= seq_lseek,
+	.release	= seq_release,
+};
+#endif /* CONFIG_TRACE_ERROR_SITE_KEYS */
+
+static int __init err_sampling_debugfs_init(void)
+{
+	struct dentry *dir;
+
+	dir = debugfs_create_dir("trace_error", NULL);
+	debugfs_create_file("sampling", 0644, dir, NULL, &err_sampling_fops);
+#ifdef CONFIG_TRACE_ERROR_SITE_KEYS
+	debugfs_create_file("control", 0644, dir, NULL, &err_control_fops);
+#endif
+	return 0;
+}
+fs_initcall(err_sampling_debugfs_init);
+#endif /* CONFIG_DEBUG_FS */
+
+#ifdef CONFIG_MODULES
+static void err_samplers_release(struct err_site_table *table)
+{
+	unsigned int i;
+
+	for (i = 0; i < table->num_sites; i++)
+		err_sampler_set(&table->sites[i], ERR_SAMPLE_ONE_IN, 0);
+}
+
+static int err_sites_add_module(struct module *mod)
+{
+	struct err_site_table *table;
+
+	if (!mod->num_err_sites)
+		return 0;
+
+	table = kzalloc(sizeof(*table), GFP_KERNEL);
+	if (!table)
+		return -ENOMEM;
+
+	err_sites_add(table, mod, mod->err_sites, mod->num_err_sites);
+	return 0;
+}
+
+static void err_sites_del_module(struct module *mod)
+{
+	struct err_site_table *table, *tmp;
+
+	list_for_each_entry_safe(table, tmp, &err_site_tables, list) {
+		if (table->mod == mod) {
+			err_samplers_release(table);
+			list_del_rcu(&table->list);
+			synchronize_rcu();
+			kfree(table);
+			break;
+		}
+	}
+}
+
+static int trace_error_module_notify(struct notifier_block *self,
+				     unsigned long val, void *data)
+{
+	struct module *mod = data;
+	int ret = 0;
+
+	mutex_lock(&err_sites_mutex);
+
+	switch (val) {
+	case MODULE_STATE_COMING:
+		ret = err_sites_add_module(mod);
+		if (ret)
+			WARN(1, "Failed to allocate memory: error sites of %s will not be reported.\n",
+			     mod->name);
+		break;
+	case MODULE_STATE_GOING:
+		err_sites_del_module(mod);
+		break;
+	}
+
+	mutex_unlock(&err_sites_mutex);
+
+	/* A module without provenance is still a working module. */
+	return NOTIFY_OK;
+}
+
+static struct notifier_block trace_error_module_nb = {
+	.notifier_call = trace_error_module_notify,
+};
+#endif /* CONFIG_MODULES */
+
+int trace_error_set_reg(void)
+{
+	static_branch_inc(&trace_error_key);
+	return 0;
+}
+
+void trace_error_set_unreg(void)
+{
+	static_branch_dec(&trace_error_key);
+}
+
+static void trace_error_set_record(bool enable)
+{
+	mutex_lock(&trace_error_record_mutex);
+	if (enable != static_key_enabled(&trace_error_record_key)) {
+		if (enable) {
+			static_branch_enable(&trace_error_record_key);
+			static_branch_inc(&trace_error_key);
+		} else {
+			static_branch_dec(&trace_error_key);
+			static_branch_disable(&trace_error_record_key);
+		}
+	}
+	mutex_unlock(&trace_error_record_mutex);
+}
+
+static int __init setup_trace_error(char *str)
+{
+	if (kstrtobool(str, &trace_error_boot)) {
+		pr_warn("Unable to parse trace_error=\n");
+		return 0;
+	}
+	return 1;
+}
+__setup("trace_error=", setup_trace_error);
+
+static int __init trace_error_init(void)
+{
+	mutex_lock(&err_sites_mutex);
+	err_sites_add(&core_err_sites, NULL, __start___err_sites,
+		      __stop___err_sites - __start___err_sites);
+	mutex_unlock(&err_sites_mutex);
+
+#ifdef CONFIG_MODULES
+	register_module_notifier(&trace_error_module_nb);
+#endif
+
+	err_sample_states = alloc_percpu(struct err_sample_states);
+
+	if (trace_error_boot)
+		trace_error_set_record(true);
+	return 0;
+}
+early_initcall(trace_error_init);
+
+#ifdef CONFIG_PROC_SYSCTL
+int trace_error_sysctl(struct ctl_table *table, int write,
+		       void *buffer, size_t *lenp, loff_t *ppos)
+{
+	struct ctl_table t;
+	int state = static_key_enabled(&trace_error_record_key);
+	int ret;
+
+	t = *table;
+	t.data = &state;
+	ret = proc_dointvec_minmax(&t, write, buffer, lenp, ppos);
+	if (ret || !write)
+		return ret;
+
+	trace_error_set_record(state);
+	return 0;
+}
+#endif /* CONFIG_PROC_SYSCTL */
@@ -602,7 +602,7 @@ int kasan_module_alloc(void *addr, size_t size)
 		return 0;
 	}
 
-	return -ENOMEM;
+	return -ERR(ENOMEM);
 }
 
 void kasan_free_shadow(const struct vm_struct *vm)
@@ -734,7 +734,7 @@ static int kasan_populate_vmalloc_pte(pte_t *ptep, unsigned long addr,
 
 	page = __get_free_page(GFP_KERNEL);
 	if (!page)
-		return -ENOMEM;
+		return -ERR(ENOMEM);
 
 	memset((void *)page, KASAN_VMALLOC_INVALID, PAGE_SIZE);
 	pte = pfn_pte(PFN_DOWN(__pa(page)), PAGE_KERNEL);
@@ -133,7 +133,7 @@ static int __ref zero_pmd_populate(pud_t *pud, unsigned long addr,
 			else
 				p = early_alloc(PAGE_SIZE, NUMA_NO_NODE);
 			if (!p)
-				return -ENOMEM;
+				return -ERR(ENOMEM);
 
 			pmd_populate_kernel(&init_mm, pmd, p);
 		}
@@ -168,7 +168,7 @@ static int __ref zero_pud_populate(p4d_t *p4d, unsigned long addr,
 			if (slab_is_available()) {
 				p = pmd_alloc(&init_mm, pud, addr);
 				if (!p)
-					return -ENOMEM;
+					return -ERR(ENOMEM);
 			} else {
 				pud_populate(&init_mm, pud,
 					early_alloc(PAGE_SIZE, NUMA_NO_NODE));
@@ -209,7 +209,7 @@ static int __ref zero_p4d_populate(pgd_t *pgd, unsigned long addr,
 			if (slab_is_available()) {
 				p = pud_alloc(&init_mm, p4d, addr);
 				if (!p)
-					return -ENOMEM;
+					return -ERR(ENOMEM);
 			} else {
 				p4d_populate(&init_mm, p4d,
 					early_alloc(PAGE_SIZE, NUMA_NO_NODE));
@@ -271,7 +271,7 @@ int __ref kasan_populate_early_shadow(const void *shadow_start,
 			if (slab_is_available()) {
 				p = p4d_alloc(&init_mm, pgd, addr);
 				if (!p)
-					return -ENOMEM;
+					return -ERR(ENOMEM);
 			} else {
 				pgd_populate(&init_mm, pgd,
 					early_alloc(PAGE_SIZE, NUMA_NO_NODE));
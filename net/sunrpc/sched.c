@@ -330,6 +330,41 @@ static int rpc_complete_task(struct rpc_task *task)
 	return ret;
 }
 
+#ifdef CONFIG_TRACE_ERROR
+static struct err_capture *rpc_task_err_capture(struct rpc_task *task)
+{
+	return RPC_IS_ASYNC(task) ? &task->tk_err : NULL;
+}
+
+/*
+ * Hand the last error of an async task over to the task waiting for it,
+ * if that is the error the task failed with.
+ */
+static void rpc_task_propagate_err(struct rpc_task *task)
+{
+	trace_error_propagate(&task->tk_err, task->tk_status);
+}
+
+/* Each run starts afresh, forgetting errors an earlier run recovered from. */
+static void rpc_task_reset_err(struct rpc_task *task)
+{
+	WRITE_ONCE(task->tk_err.site, 0);
+}
+#else
+static struct err_capture *rpc_task_err_capture(struct rpc_task *task)
+{
+	return NULL;
+}
+
+static void rpc_task_propagate_err(struct rpc_task *task)
+{
+}
+
+static void rpc_task_reset_err(struct rpc_task *task)
+{
+}
+#endif
+
 /*
  * Allow callers to wait for completion of an RPC call
  *
@@ -339,10 +374,15 @@ static int rpc_complete_task(struct rpc_task *task)
  */
 int __rpc_wait_for_completion_task(struct rpc_task *task, wait_bit_action_f *action)
 {
+	int ret;
+
 	if (action == NULL)
 		action = rpc_wait_bit_killable;
-	return out_of_line_wait_on_bit(&task->tk_runstate, RPC_TASK_ACTIVE,
+	ret = out_of_line_wait_on_bit(&task->tk_runstate, RPC_TASK_ACTIVE,
 			action, TASK_KILLABLE);
+	if (!ret)
+		rpc_task_propagate_err(task);
+	return ret;
 }
 EXPORT_SYMBOL_GPL(__rpc_wait_for_completion_task);
 
@@ -881,6 +921,7 @@ void rpc_release_calldata(const struct rpc_call_ops *ops, void *calldata)
  */
 static void __rpc_execute(struct rpc_task *task)
 {
+	struct err_capture *prev_capture;
 	struct rpc_wait_queue *queue;
 	int task_is_async = RPC_IS_ASYNC(task);
 	int status = 0;
@@ -892,6 +933,7 @@ static void __rpc_execute(struct rpc_task *task)
 	if (RPC_IS_QUEUED(task))
 		return;
 
+	rpc_task_reset_err(task);
 	for (;;) {
 		void (*do_action)(struct rpc_task *);
 
@@ -910,7 +952,13 @@ static void __rpc_execute(struct rpc_task *task)
 		if (!do_action)
 			break;
 		trace_rpc_task_run_action(task, do_action);
+		/*
+		 * Async steps run in rpciod on behalf of the submitter;
+		 * sync ones already record into the caller.
+		 */
+		prev_capture = trace_error_capture_begin(rpc_task_err_capture(task));
 		do_action(task);
+		trace_error_capture_end(prev_capture);
 
 		/*
 		 * Lockless check for whether task is sleeping or not.
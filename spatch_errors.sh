@@ -2,14 +2,19 @@
 set -eu
 
 # Usage:
-#   for dir in mm net fs kernel security sound virt lib ipc include; do ./spatch_errors.sh --dir $dir --include-headers --in-place -j 4; done
+#   for dir in mm net fs kernel security sound virt lib ipc include drivers/block drivers/nvme; do ./spatch_errors.sh --dir $dir --include-headers --in-place -j 4; done
+#   for dir in mm/kasan drivers/block drivers/nvme; do NOISY=1 ./spatch_errors.sh --dir $dir --include-headers --in-place -j 4; done
 
 # We skip arch/ as there's some boot code that doesn't link our set_last_err() function.
-# We also skip driver/ because it's unlikely to be useful.
+# Of drivers/, only the storage stack is worth the noise: block and NVMe.
 
-# We also skip -ENOMEM and -EFAULT, because these introduce noise.
+# We also skip -ENOMEM and -EFAULT, because these introduce noise. The
+# second pass, with NOISY=1, patches only those, and only where they have
+# been converted so far. ERR() samples their sites by default (see
+# __err_noisy() and CONFIG_TRACE_ERROR_NOISY_SAMPLE) instead of recording
+# every one.
 
-IGNORE_ERRORS='(ENOMEM|EFAULT)'
+NOISY_ERRORS='^(ENOMEM|EFAULT)$'
 
 ERRORS=$(
 cat include/uapi/asm-generic/errno.h \
@@ -18,7 +23,7 @@ cat include/uapi/asm-generic/errno.h \
   | grep '^#define\s\+E[A-Z0-9]\+\s\+[0-9]\+' \
   | awk '{print $2}' \
   | sort -u \
-  | grep -Ev $IGNORE_ERRORS \
+  | if [ "${NOISY:-0}" = 1 ]; then grep -E "$NOISY_ERRORS"; else grep -Ev "$NOISY_ERRORS"; fi \
   | xargs ruby -e 'puts ARGV.map { |e| "#{e}@p" }.join("\\|")'
 )
 
@@ -0,0 +1,227 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * errors-hammer: run failing syscalls from many threads at once.
+ *
+ * Every failing syscall records its error provenance into the last_err
+ * block of the calling task_struct. This measures the per-thread cost of
+ * that store, and how it scales with the number of threads, by comparing
+ * runs with kernel.trace_error set to 0 and 1.
+ */
+
+#include <string.h>
+#include <pthread.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <linux/compiler.h>
+#include <linux/kernel.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <internal/cpumap.h>
+#include <perf/cpumap.h>
+
+#include "../util/stat.h"
+#include <subcmd/parse-options.h>
+#include "bench.h"
+#include "errors.h"
+
+#include <err.h>
+
+static unsigned int nthreads = 0;
+static unsigned int nsecs    = 10;
+static int provenance = -1;
+static const char *syscall_str = "recv";
+static bool done = false, silent = false;
+
+static pthread_mutex_t thread_lock;
+static unsigned int threads_starting;
+static struct stats throughput_stats;
+static pthread_cond_t thread_parent, thread_worker;
+
+struct worker {
+	int tid;
+	int fd;
+	pthread_t thread;
+	unsigned long ops;
+};
+
+static const struct option options[] = {
+	OPT_UINTEGER('t', "threads",    &nthreads,    "Specify amount of threads"),
+	OPT_UINTEGER('r', "runtime",    &nsecs,       "Specify runtime (in seconds)"),
+	OPT_STRING(  'e', "syscall",    &syscall_str, "recv|open", "Failing syscall to run"),
+	OPT_INTEGER( 'p', "provenance", &provenance,  "Set kernel.trace_error for the run (0 or 1)"),
+	OPT_BOOLEAN( 's', "silent",     &silent,      "Silent mode: do not display data/details"),
+	OPT_END()
+};
+
+static const char * const bench_errors_hammer_usage[] = {
+	"perf bench errors hammer <options>",
+	NULL
+};
+
+static void *workerfn(void *arg)
+{
+	struct worker *w = (struct worker *) arg;
+	unsigned long ops = w->ops; /* avoid cacheline bouncing */
+	bool use_open = !strcmp(syscall_str, "open");
+	char c;
+
+	pthread_mutex_lock(&thread_lock);
+	threads_starting--;
+	if (!threads_starting)
+		pthread_cond_signal(&thread_parent);
+	pthread_cond_wait(&thread_worker, &thread_lock);
+	pthread_mutex_unlock(&thread_lock);
+
+	do {
+		/* EAGAIN from net/unix/af_unix.c, or ENOENT from the path walk */
+		if (use_open) {
+			if (open("/perf-bench-errors/missing", O_RDONLY) >= 0 ||
+			    errno != ENOENT)
+				warnx("Non-expected open return");
+		} else if (recv(w->fd, &c, 1, MSG_DONTWAIT) >= 0 ||
+			   errno != EAGAIN) {
+			warnx("Non-expected recv return");
+		}
+		ops++;
+	} while (!done);
+
+	w->ops = ops;
+	return NULL;
+}
+
+static void toggle_done(int sig __maybe_unused,
+			siginfo_t *info __maybe_unused,
+			void *uc __maybe_unused)
+{
+	/* inform all threads that we're done for the day */
+	done = true;
+	gettimeofday(&bench__end, NULL);
+	timersub(&bench__end, &bench__start, &bench__runtime);
+}
+
+static void print_summary(int state)
+{
+	unsigned long avg = avg_stats(&throughput_stats);
+	double stddev = stddev_stats(&throughput_stats);
+
+	printf("%sAveraged %ld failing %s/sec per thread (+- %.2f%%), trace_error = %s, total secs = %d\n",
+	       !silent ? "\n" : "", avg, syscall_str,
+	       rel_stddev_stats(stddev, avg),
+	       state < 0 ? "n/a" : state ? "1" : "0",
+	       (int)bench__runtime.tv_sec);
+}
+
+int bench_errors_hammer(int argc, const char **argv)
+{
+	int ret = 0, orig_state, state;
+	cpu_set_t cpuset;
+	struct sigaction act;
+	unsigned int i;
+	pthread_attr_t thread_attr;
+	struct worker *worker = NULL;
+	struct perf_cpu_map *cpu;
+
+	argc = parse_options(argc, argv, options, bench_errors_hammer_usage, 0);
+	if (argc || (strcmp(syscall_str, "recv") && strcmp(syscall_str, "open"))) {
+		usage_with_options(bench_errors_hammer_usage, options);
+		exit(EXIT_FAILURE);
+	}
+
+	orig_state = errors__read_state();
+	if (provenance >= 0 && errors__write_state(provenance))
+		err(EXIT_FAILURE, "cannot set %s", ERRORS_SYSCTL);
+	state = errors__read_state();
+
+	cpu = perf_cpu_map__new(NULL);
+	if (!cpu)
+		goto errmem;
+
+	memset(&act, 0, sizeof(act));
+	sigfillset(&act.sa_mask);
+	act.sa_sigaction = toggle_done;
+	sigaction(SIGINT, &act, NULL);
+
+	if (!nthreads) /* default to the number of CPUs */
+		nthreads = cpu->nr;
+
+	worker = calloc(nthreads, sizeof(*worker));
+	if (!worker)
+		goto errmem;
+
+	printf("Run summary [PID %d]: %d threads, each running failing %s for %d secs.\n\n",
+	       getpid(), nthreads, syscall_str, nsecs);
+
+	init_stats(&throughput_stats);
+	pthread_mutex_init(&thread_lock, NULL);
+	pthread_cond_init(&thread_parent, NULL);
+	pthread_cond_init(&thread_worker, NULL);
+
+	threads_starting = nthreads;
+	pthread_attr_init(&thread_attr);
+	gettimeofday(&bench__start, NULL);
+	for (i = 0; i < nthreads; i++) {
+		int sv[2];
+
+		/* one socket per thread, so that only last_err is shared state */
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv))
+			err(EXIT_FAILURE, "socketpair");
+		worker[i].tid = i;
+		worker[i].fd = sv[0];
+
+		CPU_ZERO(&cpuset);
+		CPU_SET(cpu->map[i % cpu->nr], &cpuset);
+
+		ret = pthread_attr_setaffinity_np(&thread_attr, sizeof(cpu_set_t), &cpuset);
+		if (ret)
+			err(EXIT_FAILURE, "pthread_attr_setaffinity_np");
+
+		ret = pthread_create(&worker[i].thread, &thread_attr, workerfn,
+				     (void *)(struct worker *) &worker[i]);
+		if (ret)
+			err(EXIT_FAILURE, "pthread_create");
+	}
+	pthread_attr_destroy(&thread_attr);
+
+	pthread_mutex_lock(&thread_lock);
+	while (threads_starting)
+		pthread_cond_wait(&thread_parent, &thread_lock);
+	pthread_cond_broadcast(&thread_worker);
+	pthread_mutex_unlock(&thread_lock);
+
+	sleep(nsecs);
+	toggle_done(0, NULL, NULL);
+
+	for (i = 0; i < nthreads; i++) {
+		ret = pthread_join(worker[i].thread, NULL);
+		if (ret)
+			err(EXIT_FAILURE, "pthread_join");
+	}
+
+	/* cleanup & report results */
+	pthread_cond_destroy(&thread_parent);
+	pthread_cond_destroy(&thread_worker);
+	pthread_mutex_destroy(&thread_lock);
+
+	if (provenance >= 0 && orig_state >= 0)
+		errors__write_state(orig_state);
+
+	for (i = 0; i < nthreads; i++) {
+		unsigned long t = bench__runtime.tv_sec > 0 ?
+			worker[i].ops / bench__runtime.tv_sec : 0;
+		update_stats(&throughput_stats, t);
+		if (!silent)
+			printf("[thread %3d] %ld ops/sec\n", worker[i].tid, t);
+	}
+
+	print_summary(state);
+
+	free(worker);
+	free(cpu);
+	return ret;
+errmem:
+	err(EXIT_FAILURE, "calloc");
+}
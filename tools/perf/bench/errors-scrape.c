@@ -0,0 +1,296 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * errors-scrape: read the last error of thousands of tasks concurrently.
+ *
+ * A monitoring agent collects error provenance by reading
+ * /proc/<pid>/last_error of every task, or /proc/last_errors in one go.
+ * This forks a population of tasks that each record an error, optionally
+ * keep failing syscalls while being read, and measures how many tasks per
+ * second concurrent readers can scrape either way.
+ */
+
+#include <string.h>
+#include <pthread.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <linux/compiler.h>
+#include <linux/kernel.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "../util/stat.h"
+#include <subcmd/parse-options.h>
+#include "bench.h"
+#include "errors.h"
+
+#include <err.h>
+
+static unsigned int nreaders = 0;
+static unsigned int ntasks   = 1000;
+static unsigned int nsecs    = 10;
+static bool bulk = false, busy = false, done = false, silent = false;
+
+static pid_t *tasks;
+static pthread_mutex_t thread_lock;
+static unsigned int threads_starting;
+static struct stats throughput_stats;
+static pthread_cond_t thread_parent, thread_worker;
+
+struct reader {
+	int tid;
+	pthread_t thread;
+	unsigned long reads;
+	unsigned long scraped;
+};
+
+static const struct option options[] = {
+	OPT_UINTEGER('t', "threads", &nreaders, "Specify amount of reader threads"),
+	OPT_UINTEGER('n', "tasks",   &ntasks,   "Specify amount of tasks to scrape"),
+	OPT_UINTEGER('r', "runtime", &nsecs,    "Specify runtime (in seconds)"),
+	OPT_BOOLEAN( 'b', "bulk",    &bulk,     "Read /proc/last_errors instead of each /proc/<pid>/last_error"),
+	OPT_BOOLEAN( 'B', "busy",    &busy,     "Tasks keep failing syscalls while being scraped"),
+	OPT_BOOLEAN( 's', "silent",  &silent,   "Silent mode: do not display data/details"),
+	OPT_END()
+};
+
+static const char * const bench_errors_scrape_usage[] = {
+	"perf bench errors scrape <options>",
+	NULL
+};
+
+static void taskfn(void)
+{
+	do {
+		if (open("/perf-bench-errors/missing", O_RDONLY) >= 0)
+			exit(EXIT_FAILURE);
+	} while (busy);
+
+	pause();
+	exit(EXIT_SUCCESS);
+}
+
+/* Read a whole file, returning the number of lines or -1. */
+static int read_lines(const char *path, char *buf, size_t size)
+{
+	int fd, lines = 0;
+	ssize_t len, i;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return -1;
+	while ((len = read(fd, buf, size)) > 0) {
+		for (i = 0; i < len; i++)
+			lines += buf[i] == '\n';
+	}
+	close(fd);
+	return len < 0 ? -1 : lines;
+}
+
+static int pid_cmp(const void *a, const void *b)
+{
+	pid_t x = *(const pid_t *)a, y = *(const pid_t *)b;
+
+	return x < y ? -1 : x > y;
+}
+
+/*
+ * Read /proc/last_errors, returning the number of lines that belong to
+ * the forked tasks or -1. Each line starts with the tgid; tasks[] is
+ * sorted by then.
+ */
+static int read_bulk(char *buf, size_t size)
+{
+	int fd, found = 0;
+	bool in_tgid = true;
+	pid_t tgid = 0;
+	ssize_t len, i;
+
+	fd = open("/proc/last_errors", O_RDONLY);
+	if (fd < 0)
+		return -1;
+	while ((len = read(fd, buf, size)) > 0) {
+		for (i = 0; i < len; i++) {
+			char c = buf[i];
+
+			if (c == '\n') {
+				in_tgid = true;
+				tgid = 0;
+			} else if (in_tgid && c >= '0' && c <= '9') {
+				tgid = tgid * 10 + c - '0';
+			} else if (in_tgid) {
+				in_tgid = false;
+				if (bsearch(&tgid, tasks, ntasks, sizeof(*tasks), pid_cmp))
+					found++;
+			}
+		}
+	}
+	close(fd);
+	return len < 0 ? -1 : found;
+}
+
+static void *readerfn(void *arg)
+{
+	struct reader *r = (struct reader *) arg;
+	unsigned long reads = 0, scraped = 0;
+	char path[64], buf[4096];
+	unsigned int i;
+	int lines;
+
+	pthread_mutex_lock(&thread_lock);
+	threads_starting--;
+	if (!threads_starting)
+		pthread_cond_signal(&thread_parent);
+	pthread_cond_wait(&thread_worker, &thread_lock);
+	pthread_mutex_unlock(&thread_lock);
+
+	do {
+		if (bulk) {
+			/* other tasks of the system are read, but not counted */
+			lines = read_bulk(buf, sizeof(buf));
+			if (lines < 0)
+				err(EXIT_FAILURE, "/proc/last_errors");
+			reads++;
+			scraped += lines;
+			continue;
+		}
+
+		for (i = 0; i < ntasks && !done; i++) {
+			snprintf(path, sizeof(path), "/proc/%d/last_error",
+				 tasks[i]);
+			if (read_lines(path, buf, sizeof(buf)) < 0)
+				err(EXIT_FAILURE, "%s", path);
+			reads++;
+			scraped++;
+		}
+	} while (!done);
+
+	r->reads = reads;
+	r->scraped = scraped;
+	return NULL;
+}
+
+static void toggle_done(int sig __maybe_unused,
+			siginfo_t *info __maybe_unused,
+			void *uc __maybe_unused)
+{
+	/* inform all threads that we're done for the day */
+	done = true;
+	gettimeofday(&bench__end, NULL);
+	timersub(&bench__end, &bench__start, &bench__runtime);
+}
+
+static void print_summary(void)
+{
+	unsigned long avg = avg_stats(&throughput_stats);
+	double stddev = stddev_stats(&throughput_stats);
+
+	printf("%sAveraged %ld tasks scraped/sec per reader (+- %.2f%%), total secs = %d\n",
+	       !silent ? "\n" : "", avg, rel_stddev_stats(stddev, avg),
+	       (int)bench__runtime.tv_sec);
+}
+
+int bench_errors_scrape(int argc, const char **argv)
+{
+	int ret = 0;
+	struct sigaction act;
+	unsigned int i;
+	struct reader *reader = NULL;
+
+	argc = parse_options(argc, argv, options, bench_errors_scrape_usage, 0);
+	if (argc || !ntasks) {
+		usage_with_options(bench_errors_scrape_usage, options);
+		exit(EXIT_FAILURE);
+	}
+
+	if (errors__read_state() < 0)
+		errx(EXIT_FAILURE, "kernel does not record error provenance");
+
+	memset(&act, 0, sizeof(act));
+	sigfillset(&act.sa_mask);
+	act.sa_sigaction = toggle_done;
+	sigaction(SIGINT, &act, NULL);
+
+	if (!nreaders) /* default to the number of CPUs */
+		nreaders = sysconf(_SC_NPROCESSORS_ONLN);
+
+	tasks = calloc(ntasks, sizeof(*tasks));
+	reader = calloc(nreaders, sizeof(*reader));
+	if (!tasks || !reader)
+		goto errmem;
+
+	printf("Run summary [PID %d]: %d readers scraping %d %s tasks%s for %d secs.\n\n",
+	       getpid(), nreaders, ntasks, busy ? "busy" : "idle",
+	       bulk ? " through /proc/last_errors" : "", nsecs);
+
+	for (i = 0; i < ntasks; i++) {
+		tasks[i] = fork();
+		if (tasks[i] < 0)
+			err(EXIT_FAILURE, "fork");
+		if (!tasks[i])
+			taskfn();
+	}
+	qsort(tasks, ntasks, sizeof(*tasks), pid_cmp);
+
+	init_stats(&throughput_stats);
+	pthread_mutex_init(&thread_lock, NULL);
+	pthread_cond_init(&thread_parent, NULL);
+	pthread_cond_init(&thread_worker, NULL);
+
+	threads_starting = nreaders;
+	gettimeofday(&bench__start, NULL);
+	for (i = 0; i < nreaders; i++) {
+		reader[i].tid = i;
+		ret = pthread_create(&reader[i].thread, NULL, readerfn,
+				     (void *)(struct reader *) &reader[i]);
+		if (ret)
+			err(EXIT_FAILURE, "pthread_create");
+	}
+
+	pthread_mutex_lock(&thread_lock);
+	while (threads_starting)
+		pthread_cond_wait(&thread_parent, &thread_lock);
+	pthread_cond_broadcast(&thread_worker);
+	pthread_mutex_unlock(&thread_lock);
+
+	sleep(nsecs);
+	toggle_done(0, NULL, NULL);
+
+	for (i = 0; i < nreaders; i++) {
+		ret = pthread_join(reader[i].thread, NULL);
+		if (ret)
+			err(EXIT_FAILURE, "pthread_join");
+	}
+
+	/* cleanup & report results */
+	for (i = 0; i < ntasks; i++)
+		kill(tasks[i], SIGKILL);
+	for (i = 0; i < ntasks; i++)
+		waitpid(tasks[i], NULL, 0);
+
+	pthread_cond_destroy(&thread_parent);
+	pthread_cond_destroy(&thread_worker);
+	pthread_mutex_destroy(&thread_lock);
+
+	for (i = 0; i < nreaders; i++) {
+		unsigned long t = bench__runtime.tv_sec > 0 ?
+			reader[i].scraped / bench__runtime.tv_sec : 0;
+		update_stats(&throughput_stats, t);
+		if (!silent)
+			printf("[reader %3d] %ld reads, %ld tasks/sec\n",
+			       reader[i].tid, reader[i].reads, t);
+	}
+
+	print_summary();
+
+	free(reader);
+	free(tasks);
+	return ret;
+errmem:
+	err(EXIT_FAILURE, "calloc");
+}
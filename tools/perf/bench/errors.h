@@ -0,0 +1,46 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * Helpers shared by the error provenance benchmarks.
+ */
+
+#ifndef _ERRORS_H
+#define _ERRORS_H
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define ERRORS_SYSCTL	"/proc/sys/kernel/trace_error"
+
+/* kernel.trace_error, or -1 if the kernel does not record provenance */
+static inline int errors__read_state(void)
+{
+	char buf[8];
+	ssize_t len;
+	int fd;
+
+	fd = open(ERRORS_SYSCTL, O_RDONLY);
+	if (fd < 0)
+		return -1;
+	len = read(fd, buf, sizeof(buf) - 1);
+	close(fd);
+	if (len <= 0)
+		return -1;
+	buf[len] = '\0';
+	return atoi(buf);
+}
+
+static inline int errors__write_state(int state)
+{
+	char c = state ? '1' : '0';
+	int fd, ret;
+
+	fd = open(ERRORS_SYSCTL, O_WRONLY);
+	if (fd < 0)
+		return -1;
+	ret = write(fd, &c, 1) == 1 ? 0 : -1;
+	close(fd);
+	return ret;
+}
+
+#endif /* _ERRORS_H */
@@ -0,0 +1,304 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * uprobe-hammer: hit the same uprobe from many threads at once.
+ *
+ * A USDT probe in a multi-threaded service is one uprobe hit by every
+ * thread. This places a uprobe event on a function of perf itself, calls
+ * it in a loop from one thread per CPU, and reports calls/sec per thread,
+ * so that runs with and without the probe show what a hit costs and how
+ * that cost scales with the number of threads. With --ret the event is a
+ * uretprobe, whose hit also goes through the return trampoline.
+ */
+
+#include <string.h>
+#include <pthread.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <linux/compiler.h>
+#include <linux/kernel.h>
+#include <sys/time.h>
+#include <internal/cpumap.h>
+#include <perf/cpumap.h>
+#include <api/fs/tracing_path.h>
+
+#include "../util/stat.h"
+#include <subcmd/parse-options.h>
+#include "bench.h"
+
+#include <err.h>
+
+#define UPROBE_GROUP	"perf_bench"
+#define UPROBE_EVENT	"uprobe_hammer"
+
+static unsigned int nthreads = 0;
+static unsigned int nsecs    = 10;
+static bool baseline = false, ret_probe = false, done = false, silent = false;
+
+static pthread_mutex_t thread_lock;
+static unsigned int threads_starting;
+static struct stats throughput_stats;
+static pthread_cond_t thread_parent, thread_worker;
+
+struct worker {
+	int tid;
+	pthread_t thread;
+	unsigned long ops;
+};
+
+static const struct option options[] = {
+	OPT_UINTEGER('t', "threads",  &nthreads, "Specify amount of threads"),
+	OPT_UINTEGER('r', "runtime",  &nsecs,    "Specify runtime (in seconds)"),
+	OPT_BOOLEAN( 'b', "baseline", &baseline, "Do not place the uprobe, measure the bare calls"),
+	OPT_BOOLEAN( 'R', "ret",      &ret_probe, "Place a uretprobe instead of a uprobe"),
+	OPT_BOOLEAN( 's', "silent",   &silent,   "Silent mode: do not display data/details"),
+	OPT_END()
+};
+
+static const char * const bench_uprobe_hammer_usage[] = {
+	"perf bench uprobe hammer <options>",
+	NULL
+};
+
+/* The probed function: as cheap as a USDT site when no probe is placed. */
+static noinline void uprobe_hammer_target(void)
+{
+	asm volatile ("" ::: "memory");
+}
+
+static int write_tracing_file(const char *name, const char *buf, int flags)
+{
+	char *path = get_tracing_file(name);
+	ssize_t len = strlen(buf);
+	int fd, ret = -1;
+
+	if (!path)
+		return -1;
+	fd = open(path, O_WRONLY | flags);
+	if (fd >= 0) {
+		if (write(fd, buf, len) == len)
+			ret = 0;
+		close(fd);
+	}
+	put_tracing_file(path);
+	return ret;
+}
+
+/* Find the file and file offset that uprobe_hammer_target() is mapped from. */
+static int target_location(char *file, size_t size, unsigned long *offset)
+{
+	unsigned long addr = (unsigned long)uprobe_hammer_target;
+	unsigned long start, end, pgoff;
+	char line[PATH_MAX + 128], perms[5];
+	FILE *fp;
+	int ret = -1;
+
+	fp = fopen("/proc/self/maps", "r");
+	if (!fp)
+		return -1;
+
+	while (fgets(line, sizeof(line), fp)) {
+		char *path;
+
+		if (sscanf(line, "%lx-%lx %4s %lx", &start, &end, perms, &pgoff) != 4)
+			continue;
+		if (addr < start || addr >= end || perms[2] != 'x')
+			continue;
+		path = strchr(line, '/');
+		if (!path)
+			break;
+		path[strcspn(path, "\n")] = '\0';
+		snprintf(file, size, "%s", path);
+		*offset = addr - start + pgoff;
+		ret = 0;
+		break;
+	}
+
+	fclose(fp);
+	return ret;
+}
+
+static int uprobe_add(void)
+{
+	char file[PATH_MAX], buf[PATH_MAX + 64];
+	unsigned long offset;
+
+	if (target_location(file, sizeof(file), &offset))
+		return -1;
+
+	snprintf(buf, sizeof(buf), "%c:%s/%s %s:0x%lx\n",
+		 ret_probe ? 'r' : 'p', UPROBE_GROUP, UPROBE_EVENT, file, offset);
+	if (write_tracing_file("uprobe_events", buf, O_APPEND))
+		return -1;
+
+	return write_tracing_file("events/" UPROBE_GROUP "/" UPROBE_EVENT "/enable",
+				  "1", 0);
+}
+
+static void uprobe_del(void)
+{
+	write_tracing_file("events/" UPROBE_GROUP "/" UPROBE_EVENT "/enable", "0", 0);
+	write_tracing_file("uprobe_events", "-:" UPROBE_GROUP "/" UPROBE_EVENT "\n",
+			   O_APPEND);
+}
+
+static void *workerfn(void *arg)
+{
+	struct worker *w = (struct worker *) arg;
+	unsigned long ops = w->ops; /* avoid cacheline bouncing */
+
+	pthread_mutex_lock(&thread_lock);
+	threads_starting--;
+	if (!threads_starting)
+		pthread_cond_signal(&thread_parent);
+	pthread_cond_wait(&thread_worker, &thread_lock);
+	pthread_mutex_unlock(&thread_lock);
+
+	do {
+		uprobe_hammer_target();
+		ops++;
+	} while (!done);
+
+	w->ops = ops;
+	return NULL;
+}
+
+static void toggle_done(int sig __maybe_unused,
+			siginfo_t *info __maybe_unused,
+			void *uc __maybe_unused)
+{
+	/* inform all threads that we're done for the day */
+	done = true;
+	gettimeofday(&bench__end, NULL);
+	timersub(&bench__end, &bench__start, &bench__runtime);
+}
+
+static const char *probe_str(void)
+{
+	if (baseline)
+		return "bare";
+	return ret_probe ? "uretprobed" : "uprobed";
+}
+
+static void print_summary(void)
+{
+	unsigned long avg = avg_stats(&throughput_stats);
+	double stddev = stddev_stats(&throughput_stats);
+
+	printf("%sAveraged %ld %s calls/sec per thread (+- %.2f%%), %.1f ns/call, total secs = %d\n",
+	       !silent ? "\n" : "", avg, probe_str(),
+	       rel_stddev_stats(stddev, avg), avg ? 1e9 / avg : 0.0,
+	       (int)bench__runtime.tv_sec);
+}
+
+int bench_uprobe_hammer(int argc, const char **argv)
+{
+	int ret = 0;
+	cpu_set_t cpuset;
+	struct sigaction act;
+	unsigned int i;
+	pthread_attr_t thread_attr;
+	struct worker *worker = NULL;
+	struct perf_cpu_map *cpu;
+
+	argc = parse_options(argc, argv, options, bench_uprobe_hammer_usage, 0);
+	if (argc) {
+		usage_with_options(bench_uprobe_hammer_usage, options);
+		exit(EXIT_FAILURE);
+	}
+
+	cpu = perf_cpu_map__new(NULL);
+	if (!cpu)
+		goto errmem;
+
+	memset(&act, 0, sizeof(act));
+	sigfillset(&act.sa_mask);
+	act.sa_sigaction = toggle_done;
+	sigaction(SIGINT, &act, NULL);
+
+	if (!nthreads) /* default to the number of CPUs */
+		nthreads = cpu->nr;
+
+	worker = calloc(nthreads, sizeof(*worker));
+	if (!worker)
+		goto errmem;
+
+	/* a leftover event from an interrupted run would make the add fail */
+	uprobe_del();
+	if (!baseline && uprobe_add()) {
+		uprobe_del();
+		err(EXIT_FAILURE, "cannot place the uprobe, are tracefs and uprobe events available?");
+	}
+
+	printf("Run summary [PID %d]: %d threads, each calling a %s function for %d secs.\n\n",
+	       getpid(), nthreads, probe_str(), nsecs);
+
+	init_stats(&throughput_stats);
+	pthread_mutex_init(&thread_lock, NULL);
+	pthread_cond_init(&thread_parent, NULL);
+	pthread_cond_init(&thread_worker, NULL);
+
+	threads_starting = nthreads;
+	pthread_attr_init(&thread_attr);
+	gettimeofday(&bench__start, NULL);
+	for (i = 0; i < nthreads; i++) {
+		worker[i].tid = i;
+
+		CPU_ZERO(&cpuset);
+		CPU_SET(cpu->map[i % cpu->nr], &cpuset);
+
+		ret = pthread_attr_setaffinity_np(&thread_attr, sizeof(cpu_set_t), &cpuset);
+		if (ret)
+			err(EXIT_FAILURE, "pthread_attr_setaffinity_np");
+
+		ret = pthread_create(&worker[i].thread, &thread_attr, workerfn,
+				     (void *)(struct worker *) &worker[i]);
+		if (ret)
+			err(EXIT_FAILURE, "pthread_create");
+	}
+	pthread_attr_destroy(&thread_attr);
+
+	pthread_mutex_lock(&thread_lock);
+	while (threads_starting)
+		pthread_cond_wait(&thread_parent, &thread_lock);
+	pthread_cond_broadcast(&thread_worker);
+	pthread_mutex_unlock(&thread_lock);
+
+	sleep(nsecs);
+	toggle_done(0, NULL, NULL);
+
+	for (i = 0; i < nthreads; i++) {
+		ret = pthread_join(worker[i].thread, NULL);
+		if (ret)
+			err(EXIT_FAILURE, "pthread_join");
+	}
+
+	/* cleanup & report results */
+	pthread_cond_destroy(&thread_parent);
+	pthread_cond_destroy(&thread_worker);
+	pthread_mutex_destroy(&thread_lock);
+
+	if (!baseline)
+		uprobe_del();
+
+	for (i = 0; i < nthreads; i++) {
+		unsigned long t = bench__runtime.tv_sec > 0 ?
+			worker[i].ops / bench__runtime.tv_sec : 0;
+		update_stats(&throughput_stats, t);
+		if (!silent)
+			printf("[thread %3d] %ld calls/sec\n", worker[i].tid, t);
+	}
+
+	print_summary();
+
+	free(worker);
+	free(cpu);
+	return ret;
+errmem:
+	err(EXIT_FAILURE, "calloc");
+}
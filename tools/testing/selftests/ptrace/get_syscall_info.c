@@ -119,7 +119,7 @@ TEST(get_syscall_info)
 		const int expected_entry_size =
 			(void *) &info.entry.args[6] - (void *) &info;
 		const int expected_exit_size =
-			(void *) (&info.exit.is_error + 1) -
+			(void *) (&info.exit.err_site + 1) -
 			(void *) &info;
 		int status;
 		long rc;
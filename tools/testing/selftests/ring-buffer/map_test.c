@@ -0,0 +1,392 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * Map the per-CPU trace_pipe_raw of a trace instance, and check the meta
+ * page, that TRACE_MMAP_IOCTL_GET_READER hands out the events written,
+ * that read(), splice() and snapshot allocation are refused while the
+ * buffer is mapped, and that a mapping moved by mremap() is still counted
+ * once.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <linux/trace_mmap.h>
+
+#include "../kselftest.h"
+
+#define INSTANCE	"ring_buffer_map_test"
+#define MARKER		"ring-buffer-map-test-marker"
+
+static char instance[256];
+static size_t page_size;
+static int cpu;
+
+static int find_instance(void)
+{
+	static const char * const tracefs[] = {
+		"/sys/kernel/tracing",
+		"/sys/kernel/debug/tracing",
+	};
+	unsigned int i;
+
+	for (i = 0; i < sizeof(tracefs) / sizeof(tracefs[0]); i++) {
+		snprintf(instance, sizeof(instance), "%s/instances", tracefs[i]);
+		if (access(instance, F_OK))
+			continue;
+
+		snprintf(instance, sizeof(instance), "%s/instances/%s",
+			 tracefs[i], INSTANCE);
+		if (mkdir(instance, 0755) && errno != EEXIST)
+			return -1;
+		return 0;
+	}
+
+	errno = ENOENT;
+	return -1;
+}
+
+/* Returns 0, or the errno of the failed open or write. */
+static int write_file(const char *name, const char *val)
+{
+	char path[PATH_MAX];
+	ssize_t ret;
+	int fd;
+
+	snprintf(path, sizeof(path), "%s/%s", instance, name);
+	fd = open(path, O_WRONLY);
+	if (fd < 0)
+		return errno;
+
+	ret = write(fd, val, strlen(val));
+	if (ret < 0)
+		ret = errno;
+	else
+		ret = 0;
+	close(fd);
+
+	return ret;
+}
+
+/* Offset of the event data in a sub-buffer, from events/header_page. */
+static int subbuf_data_offset(void)
+{
+	char path[PATH_MAX], line[256];
+	unsigned int offset;
+	int ret = -1;
+	FILE *f;
+
+	snprintf(path, sizeof(path), "%s/events/header_page", instance);
+	f = fopen(path, "r");
+	if (!f)
+		return -1;
+
+	while (fgets(line, sizeof(line), f)) {
+		if (sscanf(line, " field: char data; offset:%u;", &offset) == 1) {
+			ret = offset;
+			break;
+		}
+	}
+	fclose(f);
+
+	return ret;
+}
+
+static int open_pipe_raw(void)
+{
+	char path[PATH_MAX];
+
+	snprintf(path, sizeof(path), "%s/per_cpu/cpu%d/trace_pipe_raw",
+		 instance, cpu);
+	return open(path, O_RDONLY | O_NONBLOCK);
+}
+
+static void *map_meta(int fd, struct trace_buffer_meta **meta, size_t *len)
+{
+	void *map;
+
+	map = mmap(NULL, page_size, PROT_READ, MAP_SHARED, fd, 0);
+	if (map == MAP_FAILED)
+		return map;
+
+	*meta = map;
+	*len = ((*meta)->nr_subbufs + 1) * page_size;
+	munmap(map, page_size);
+
+	map = mmap(NULL, *len, PROT_READ, MAP_SHARED, fd, 0);
+	*meta = map;
+
+	return map;
+}
+
+static void test_meta(int fd, struct trace_buffer_meta *meta, size_t len)
+{
+	void *map;
+
+	if (meta->meta_page_size != page_size ||
+	    meta->meta_struct_len != sizeof(*meta) ||
+	    meta->subbuf_size != page_size || meta->nr_subbufs < 2) {
+		ksft_test_result_fail("meta: page %u struct %u subbuf %u nr %u\n",
+				      meta->meta_page_size,
+				      meta->meta_struct_len,
+				      meta->subbuf_size, meta->nr_subbufs);
+		return;
+	}
+
+	map = mmap(NULL, len + page_size, PROT_READ, MAP_SHARED, fd, 0);
+	if (map != MAP_FAILED) {
+		munmap(map, len + page_size);
+		ksft_test_result_fail("meta: mapped past the last sub-buffer\n");
+		return;
+	}
+
+	ksft_test_result_pass("meta: %u sub-buffers of %u bytes\n",
+			      meta->nr_subbufs, meta->subbuf_size);
+}
+
+static void test_get_reader(int fd, struct trace_buffer_meta *meta)
+{
+	const char *subbuf;
+	int offset, err;
+
+	offset = subbuf_data_offset();
+	if (offset < 0) {
+		ksft_test_result_skip("get_reader: no events/header_page\n");
+		return;
+	}
+
+	err = write_file("trace_marker", MARKER);
+	if (err) {
+		ksft_test_result_error("get_reader: trace_marker: %s\n",
+				       strerror(err));
+		return;
+	}
+
+	if (ioctl(fd, TRACE_MMAP_IOCTL_GET_READER)) {
+		ksft_test_result_fail("get_reader: ioctl: %s\n",
+				      strerror(errno));
+		return;
+	}
+
+	if (meta->reader.id >= meta->nr_subbufs ||
+	    meta->reader.commit <= meta->reader.read ||
+	    offset + meta->reader.commit > page_size) {
+		ksft_test_result_fail("get_reader: id %u range [%u, %u)\n",
+				      meta->reader.id, meta->reader.read,
+				      meta->reader.commit);
+		return;
+	}
+
+	subbuf = (const char *)meta + (meta->reader.id + 1) * page_size;
+	if (!memmem(subbuf + offset + meta->reader.read,
+		    meta->reader.commit - meta->reader.read,
+		    MARKER, strlen(MARKER))) {
+		ksft_test_result_fail("get_reader: marker not in the range\n");
+		return;
+	}
+
+	/* The events were consumed, the next call hands out nothing */
+	if (ioctl(fd, TRACE_MMAP_IOCTL_GET_READER) ||
+	    meta->reader.commit != meta->reader.read) {
+		ksft_test_result_fail("get_reader: events handed out twice\n");
+		return;
+	}
+
+	ksft_test_result_pass("get_reader: marker in sub-buffer %u\n",
+			      meta->reader.id);
+}
+
+/* Returns the errno of read(), or 0 if it did not fail. */
+static int read_errno(int fd)
+{
+	char *buf = malloc(page_size);
+	int ret = 0;
+
+	if (read(fd, buf, page_size) < 0)
+		ret = errno;
+	free(buf);
+
+	return ret;
+}
+
+static void test_read_busy(int fd)
+{
+	int err;
+
+	write_file("trace_marker", MARKER);
+
+	err = read_errno(fd);
+	if (err != EBUSY) {
+		ksft_test_result_fail("read: got %s instead of EBUSY\n",
+				      err ? strerror(err) : "data");
+		return;
+	}
+
+	ksft_test_result_pass("read: EBUSY while mapped\n");
+}
+
+static void test_splice_busy(int fd)
+{
+	int pipefd[2];
+	ssize_t ret;
+
+	if (pipe(pipefd)) {
+		ksft_test_result_error("splice: pipe: %s\n", strerror(errno));
+		return;
+	}
+
+	/* splice() only tries to read the buffer if it has entries */
+	write_file("trace_marker", MARKER);
+
+	ret = splice(fd, NULL, pipefd[1], NULL, page_size, SPLICE_F_NONBLOCK);
+	close(pipefd[0]);
+	close(pipefd[1]);
+
+	if (ret >= 0 || errno != EBUSY) {
+		ksft_test_result_fail("splice: got %s instead of EBUSY\n",
+				      ret < 0 ? strerror(errno) : "data");
+		return;
+	}
+
+	ksft_test_result_pass("splice: EBUSY while mapped\n");
+}
+
+static void test_snapshot_busy(void)
+{
+	int err;
+
+	err = write_file("snapshot", "1");
+	if (err == ENOENT) {
+		ksft_test_result_skip("snapshot: no CONFIG_TRACER_SNAPSHOT\n");
+		return;
+	}
+	if (err != EBUSY) {
+		if (!err)
+			write_file("snapshot", "0");
+		ksft_test_result_fail("snapshot: got %s instead of EBUSY\n",
+				      err ? strerror(err) : "an allocation");
+		return;
+	}
+
+	ksft_test_result_pass("snapshot: not allocated while mapped\n");
+}
+
+/*
+ * Moving the mapping opens the new vma and closes the old one. The buffer
+ * must stay mapped in between, and be released by the last munmap().
+ */
+static void test_mremap(int fd, void *map, size_t len)
+{
+	struct trace_buffer_meta *meta;
+	void *target, *moved;
+	int err;
+
+	target = mmap(NULL, len, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS,
+		      -1, 0);
+	if (target == MAP_FAILED) {
+		ksft_test_result_error("mremap: reserve: %s\n",
+				       strerror(errno));
+		munmap(map, len);
+		return;
+	}
+
+	moved = mremap(map, len, len, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+	if (moved == MAP_FAILED) {
+		ksft_test_result_fail("mremap: %s\n", strerror(errno));
+		munmap(target, len);
+		munmap(map, len);
+		return;
+	}
+
+	meta = moved;
+	if (meta->meta_page_size != page_size || read_errno(fd) != EBUSY) {
+		ksft_test_result_fail("mremap: buffer released by the move\n");
+		munmap(moved, len);
+		return;
+	}
+
+	munmap(moved, len);
+
+	err = read_errno(fd);
+	if (err == EBUSY) {
+		ksft_test_result_fail("mremap: buffer still mapped after munmap\n");
+		return;
+	}
+
+	err = write_file("snapshot", "1");
+	if (err && err != ENOENT) {
+		ksft_test_result_fail("mremap: snapshot: %s after munmap\n",
+				      strerror(err));
+		return;
+	}
+	if (!err)
+		write_file("snapshot", "0");
+
+	ksft_test_result_pass("mremap: mapping counted once\n");
+}
+
+int main(int argc, char **argv)
+{
+	struct trace_buffer_meta *meta;
+	cpu_set_t cpus;
+	void *map;
+	size_t len;
+	int fd;
+
+	ksft_print_header();
+
+	if (getuid())
+		ksft_exit_skip("must be run as root\n");
+
+	if (find_instance())
+		ksft_exit_skip("cannot create a trace instance: %s\n",
+			       strerror(errno));
+
+	page_size = getpagesize();
+
+	/* Stay on the CPU whose buffer is mapped, so the markers land in it */
+	cpu = sched_getcpu();
+	CPU_ZERO(&cpus);
+	CPU_SET(cpu, &cpus);
+	if (cpu < 0 || sched_setaffinity(0, sizeof(cpus), &cpus)) {
+		rmdir(instance);
+		ksft_exit_fail_msg("cannot pin to a CPU: %s\n", strerror(errno));
+	}
+
+	fd = open_pipe_raw();
+	if (fd < 0) {
+		rmdir(instance);
+		ksft_exit_fail_msg("trace_pipe_raw: %s\n", strerror(errno));
+	}
+
+	map = map_meta(fd, &meta, &len);
+	if (map == MAP_FAILED) {
+		close(fd);
+		rmdir(instance);
+		if (errno == ENODEV)
+			ksft_exit_skip("trace_pipe_raw cannot be mapped\n");
+		ksft_exit_fail_msg("mmap: %s\n", strerror(errno));
+	}
+
+	ksft_set_plan(6);
+
+	test_meta(fd, meta, len);
+	test_get_reader(fd, meta);
+	test_read_busy(fd);
+	test_splice_busy(fd);
+	test_snapshot_busy();
+	test_mremap(fd, map, len);
+
+	close(fd);
+	rmdir(instance);
+
+	if (ksft_get_fail_cnt())
+		ksft_exit_fail();
+	ksft_exit_pass();
+}
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * Measure the cost of ERR() on error-heavy syscalls: a failed open(), recv()
+ * returning EAGAIN, a refused /proc/sys write and an ENOTTY ioctl.
+ *
+ * Each syscall is timed with provenance disabled, enabled, and enabled with
+ * its site sampled 1 in 64 through debugfs, as far as the caller may switch
+ * them. The original settings are restored. Compare the disabled numbers
+ * with the same binary run on an uninstrumented kernel.
+ *
+ * With -m <percent>, exit with status 1 if enabling provenance slows any
+ * syscall down by more than that, to catch regressions of the hot path.
+ */
+#include <time.h>
+
+#include "errors.h"
+
+#define SAMPLE_RATE	64
+
+enum mode {
+	MODE_OFF,
+	MODE_ON,
+	MODE_SAMPLED,
+	NR_MODES,
+};
+
+static const char * const mode_names[NR_MODES] = {
+	[MODE_OFF]	= "off",
+	[MODE_ON]	= "on",
+	[MODE_SAMPLED]	= "sampled",
+};
+
+static double now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static double run(struct err_op *op, unsigned long loops)
+{
+	unsigned long i;
+	double start;
+
+	start = now_ns();
+	for (i = 0; i < loops; i++) {
+		if (err_op_run(op)) {
+			fprintf(stderr, "%s: unexpected result\n", op->name);
+			exit(1);
+		}
+	}
+	return (now_ns() - start) / loops;
+}
+
+/* Sample the site @op fails at, as reported by last_error. */
+static int sample_site(struct err_op *op, char *site, size_t size,
+		       unsigned int rate)
+{
+	char rule[300];
+	long nr;
+	int err;
+
+	if (err_op_run(op) || read_last_error(site, size, &err, &nr))
+		return -1;
+	if (rate)
+		snprintf(rule, sizeof(rule), "%s 1/%u\n", site, rate);
+	else
+		snprintf(rule, sizeof(rule), "%s off\n", site);
+	return write_file(SAMPLING_PATH, rule);
+}
+
+static void usage(const char *prog)
+{
+	fprintf(stderr, "usage: %s [-l loops] [-m max_overhead_percent]\n",
+		prog);
+	exit(2);
+}
+
+int main(int argc, char **argv)
+{
+	double ns[NR_ERR_OPS][NR_MODES] = { 0 };
+	unsigned long loops = 1000000;
+	double max_overhead = -1;
+	int orig, opt, ret = 0;
+	unsigned int i, m;
+
+	while ((opt = getopt(argc, argv, "l:m:")) != -1) {
+		switch (opt) {
+		case 'l':
+			loops = strtoul(optarg, NULL, 0);
+			break;
+		case 'm':
+			max_overhead = strtod(optarg, NULL);
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+	if (!loops)
+		usage(argv[0]);
+
+	for (i = 0; i < NR_ERR_OPS; i++) {
+		if (err_ops[i].setup && err_ops[i].setup(&err_ops[i])) {
+			perror(err_ops[i].name);
+			return 1;
+		}
+		/* Warm up caches and the branch predictor. */
+		run(&err_ops[i], loops / 10 + 1);
+	}
+
+	orig = read_sysctl();
+	if (orig < 0 || write_sysctl(0)) {
+		for (i = 0; i < NR_ERR_OPS; i++)
+			printf("%-14s %8.1f ns/call (trace_error %s)\n",
+			       err_ops[i].name, run(&err_ops[i], loops),
+			       orig < 0 ? "unavailable" : "unchanged");
+		return 0;
+	}
+
+	for (i = 0; i < NR_ERR_OPS; i++) {
+		struct err_op *op = &err_ops[i];
+		char site[256];
+
+		write_sysctl(0);
+		ns[i][MODE_OFF] = run(op, loops);
+		write_sysctl(1);
+		ns[i][MODE_ON] = run(op, loops);
+		if (!sample_site(op, site, sizeof(site), SAMPLE_RATE)) {
+			ns[i][MODE_SAMPLED] = run(op, loops);
+			sample_site(op, site, sizeof(site), 0);
+		}
+	}
+	write_sysctl(orig);
+
+	for (i = 0; i < NR_ERR_OPS; i++) {
+		double overhead;
+
+		for (m = 0; m < NR_MODES; m++) {
+			if (!ns[i][m])
+				continue;
+			printf("%-14s %-8s %8.1f ns/call %12.0f calls/s\n",
+			       err_ops[i].name, mode_names[m], ns[i][m],
+			       1e9 / ns[i][m]);
+		}
+
+		overhead = (ns[i][MODE_ON] / ns[i][MODE_OFF] - 1) * 100;
+		if (max_overhead >= 0 && overhead > max_overhead) {
+			printf("%s: provenance costs %.1f%%, more than %.1f%%\n",
+			       err_ops[i].name, overhead, max_overhead);
+			ret = 1;
+		}
+	}
+
+	return ret;
+}
@@ -0,0 +1,22 @@
+#!/bin/sh
+# SPDX-License-Identifier: GPL-2.0
+#
+# Report how much slower recording error provenance makes each of the
+# error_bench syscalls. Timings on shared or virtual machines are too noisy
+# for a threshold, so this only fails if the benchmark itself cannot run;
+# pass -m to error_bench by hand to enforce one.
+
+# Kselftest framework requirement - SKIP code is 4.
+ksft_skip=4
+
+if [ "$(id -u)" -ne 0 ]; then
+	echo "SKIP: error_bench needs root to switch kernel.trace_error"
+	exit $ksft_skip
+fi
+
+if [ ! -w /proc/sys/kernel/trace_error ]; then
+	echo "SKIP: kernel built without CONFIG_TRACE_ERROR"
+	exit $ksft_skip
+fi
+
+exec ./error_bench -l 200000
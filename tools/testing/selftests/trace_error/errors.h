@@ -0,0 +1,199 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * Error-heavy syscalls shared by the trace_error tests and benchmark. Each
+ * op fails with a known errno from a fixed kernel path, and is prepared
+ * once so that its loop only runs the failing syscall.
+ */
+#ifndef __TRACE_ERROR_ERRORS_H
+#define __TRACE_ERROR_ERRORS_H
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define SYSCTL_PATH		"/proc/sys/kernel/trace_error"
+#define SAMPLING_PATH		"/sys/kernel/debug/trace_error/sampling"
+#define LAST_ERROR_PATH		"/proc/thread-self/last_error"
+
+struct err_op {
+	const char	*name;
+	int		err;		/* expected errno */
+	long		nr;		/* syscall returning it */
+	int		fd;
+	int		(*setup)(struct err_op *op);
+	int		(*call)(struct err_op *op);
+};
+
+/* open() of a missing file: ENOENT from the path walk */
+static int op_open_call(struct err_op *op)
+{
+	return open("/trace_error-selftest/missing", O_RDONLY);
+}
+
+/* recv() on an empty non-blocking AF_UNIX socket: EAGAIN */
+static int op_recv_setup(struct err_op *op)
+{
+	int sv[2];
+
+	if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv))
+		return -1;
+	op->fd = sv[0];
+	return 0;
+}
+
+static int op_recv_call(struct err_op *op)
+{
+	char c;
+
+	return recv(op->fd, &c, 1, MSG_DONTWAIT);
+}
+
+/*
+ * Opening a read-only sysctl for writing. Even root is refused, with
+ * EACCES from sysctl_perm(), because /proc/sys ignores CAP_DAC_OVERRIDE.
+ */
+static int op_sysctl_call(struct err_op *op)
+{
+	return open("/proc/sys/kernel/cap_last_cap", O_WRONLY);
+}
+
+/* a tty ioctl on a pipe: ENOTTY from vfs_ioctl() */
+static int op_ioctl_setup(struct err_op *op)
+{
+	int p[2];
+
+	if (pipe(p))
+		return -1;
+	op->fd = p[0];
+	return 0;
+}
+
+static int op_ioctl_call(struct err_op *op)
+{
+	struct termios t;
+
+	return ioctl(op->fd, TCGETS, &t);
+}
+
+static struct err_op err_ops[] = {
+	{
+		.name	= "open ENOENT",
+		.err	= ENOENT,
+		.nr	= SYS_openat,
+		.call	= op_open_call,
+	},
+	{
+		.name	= "recv EAGAIN",
+		.err	= EAGAIN,
+		.nr	= SYS_recvfrom,
+		.setup	= op_recv_setup,
+		.call	= op_recv_call,
+	},
+	{
+		.name	= "sysctl EACCES",
+		.err	= EACCES,
+		.nr	= SYS_openat,
+		.call	= op_sysctl_call,
+	},
+	{
+		.name	= "ioctl ENOTTY",
+		.err	= ENOTTY,
+		.nr	= SYS_ioctl,
+		.setup	= op_ioctl_setup,
+		.call	= op_ioctl_call,
+	},
+};
+
+#define NR_ERR_OPS	(sizeof(err_ops) / sizeof(err_ops[0]))
+
+/* Run @op once, returning 0 if it failed with the expected errno. */
+static int err_op_run(struct err_op *op)
+{
+	int ret = op->call(op);
+
+	if (ret >= 0) {
+		close(ret);
+		return -1;
+	}
+	return errno == op->err ? 0 : -1;
+}
+
+static int read_file(const char *path, char *buf, size_t size)
+{
+	ssize_t len;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return -1;
+	len = read(fd, buf, size - 1);
+	close(fd);
+	if (len < 0)
+		return -1;
+	buf[len] = '\0';
+	return 0;
+}
+
+static int write_file(const char *path, const char *buf)
+{
+	ssize_t len = strlen(buf);
+	int fd, ret;
+
+	fd = open(path, O_WRONLY);
+	if (fd < 0)
+		return -1;
+	ret = write(fd, buf, len) == len ? 0 : -1;
+	close(fd);
+	return ret;
+}
+
+/* The kernel.trace_error sysctl, or -1 if provenance is not built in. */
+static int read_sysctl(void)
+{
+	char buf[8];
+
+	if (read_file(SYSCTL_PATH, buf, sizeof(buf)))
+		return -1;
+	return atoi(buf);
+}
+
+static int write_sysctl(int val)
+{
+	return write_file(SYSCTL_PATH, val ? "1" : "0");
+}
+
+/*
+ * Parse "file:line errno [nr]" from /proc/thread-self/last_error into
+ * @site ("file:line"), @err and @nr. @nr is -1 if not reported. Returns
+ * -1 if no error is recorded.
+ */
+static int read_last_error(char *site, size_t size, int *err, long *nr)
+{
+	char buf[512], *p, *end;
+
+	if (read_file(LAST_ERROR_PATH, buf, sizeof(buf)))
+		return -1;
+
+	p = strchr(buf, ' ');
+	if (!p || (size_t)(p - buf) >= size)
+		return -1;
+	memcpy(site, buf, p - buf);
+	site[p - buf] = '\0';
+
+	*err = strtol(p, &end, 10);
+	if (end == p)
+		return -1;
+	*nr = strtol(end, &p, 10);
+	if (p == end)
+		*nr = -1;
+	return 0;
+}
+
+#endif /* __TRACE_ERROR_ERRORS_H */
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * Check that /proc/thread-self/last_error reports the errno and syscall of
+ * the last failing syscall, that successful syscalls leave it alone, and
+ * that nothing is recorded while provenance is disabled.
+ */
+#include "../kselftest.h"
+#include "errors.h"
+
+static void test_op(struct err_op *op)
+{
+	char site[256], after[256];
+	int err, err_after;
+	long nr, nr_after;
+
+	if (op->setup && op->setup(op)) {
+		ksft_test_result_error("%s: setup: %s\n", op->name,
+				       strerror(errno));
+		return;
+	}
+
+	if (err_op_run(op)) {
+		ksft_test_result_fail("%s: syscall did not fail as expected\n",
+				      op->name);
+		return;
+	}
+
+	if (read_last_error(site, sizeof(site), &err, &nr)) {
+		ksft_test_result_fail("%s: no error recorded\n", op->name);
+		return;
+	}
+	if (err != op->err || (nr != -1 && nr != op->nr)) {
+		ksft_test_result_fail("%s: got errno %d syscall %ld at %s\n",
+				      op->name, err, nr, site);
+		return;
+	}
+
+	getppid();
+	if (read_last_error(after, sizeof(after), &err_after, &nr_after) ||
+	    strcmp(site, after) || err_after != err) {
+		ksft_test_result_fail("%s: overwritten by a successful syscall\n",
+				      op->name);
+		return;
+	}
+
+	ksft_test_result_pass("%s: %s\n", op->name, site);
+}
+
+static void test_disabled(void)
+{
+	char site[256], after[256];
+	int err, err_after;
+	long nr, nr_after;
+
+	if (read_last_error(site, sizeof(site), &err, &nr) || write_sysctl(0)) {
+		ksft_test_result_skip("disabled: cannot disable trace_error\n");
+		return;
+	}
+
+	err_op_run(&err_ops[0]);
+	write_sysctl(1);
+
+	if (read_last_error(after, sizeof(after), &err_after, &nr_after) ||
+	    strcmp(site, after) || err != err_after) {
+		ksft_test_result_fail("disabled: recorded %d at %s\n",
+				      err_after, after);
+		return;
+	}
+	ksft_test_result_pass("disabled: nothing recorded\n");
+}
+
+int main(void)
+{
+	unsigned int i;
+	int orig;
+
+	ksft_print_header();
+
+	orig = read_sysctl();
+	if (orig < 0)
+		return ksft_exit_skip("kernel built without CONFIG_TRACE_ERROR\n");
+	if (!orig && write_sysctl(1))
+		return ksft_exit_skip("trace_error is disabled\n");
+
+	ksft_set_plan(NR_ERR_OPS + 1);
+
+	for (i = 0; i < NR_ERR_OPS; i++)
+		test_op(&err_ops[i]);
+	test_disabled();
+
+	write_sysctl(orig);
+
+	ksft_print_cnts();
+	return ksft_get_fail_cnt() ? ksft_exit_fail() : ksft_exit_pass();
+}